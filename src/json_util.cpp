@@ -24,7 +24,11 @@
 #include <iostream>
 #include <fstream>
 #include <algorithm>
+#include <sstream>
 #include <string>
+#include <vector>
+#include <set>
+#include <mutex>
 
 #if defined(USE_EXPERIMENTAL_FS)
 #include <experimental/filesystem>
@@ -40,119 +44,588 @@ namespace fs = std::filesystem;
 #include "json.hpp"
 using njson = nlohmann::json;
 
+#include "mapped_file.h"
+#include "JSON_transcoder.h"
+#include "JSON_io.h"
+#include "thread_pool.h"
+
 static bool opt_force_float32 = false;
+static bool opt_float32_output = false;
+static double opt_float16 = -1.0;
+static bool opt_typed_array = false;
+static bool opt_index = false;
+static bool opt_stream = false;
+static std::size_t opt_num_threads = 0;
+static std::string opt_from = {};
+static std::string opt_to = {};
+static std::string opt_output = {};
+
+static std::mutex mtx_print;
+static std::ostream *log_stream = &std::cout;
+
+// print one line. (lines from the worker threads don't get mixed.)
+template<typename... Args> void print_line(Args &&... args)
+{
+    std::ostringstream ss;
+    (ss << ... << args);
+    std::lock_guard<std::mutex> lk(mtx_print);
+    *log_stream << ss.str() << std::endl;
+}
 
-bool json2dat(const fs::path &filename, bool force_float32 = false)
+bool json2dat(const fs::path &filename, bool force_float32 = false, const cbor_write_options &cbor_opt = {})
 {
     constexpr auto ext_dat = "dat";
     fs::path fn_dat = filename;
     fn_dat.replace_extension(ext_dat);
 
-    njson::parser_callback_t cb = [](int depth, njson::parse_event_t event, njson & parsed) -> bool {
-        if (event == njson::parse_event_t::value and parsed.is_number_float()) {
-            auto val = parsed.get<float>();
-            parsed = val;
+    // read JSON file. (-f: floats are rounded to float32 by the parser, and written as 0xFA.)
+    njson json_list = {};
+    mapped_file mf;
+    if (mf.open(filename.string())) {
+        json_list = parse_json_input<njson>(nlohmann::detail::input_adapter(mf.begin(), mf.end()), force_float32);
+    } else {
+        std::ifstream ifs(filename.c_str());
+        if (!ifs.is_open()) {
+            print_line("ERROR!! can't open JSON file(", filename, ").");
+            return false;
+        }
+        if (force_float32) {
+            json_list = parse_json_input<njson>(nlohmann::detail::input_adapter(ifs), true);
+        } else {
+            ifs >> json_list;
         }
+    }
 
-        return true;
-    };
+    // write dat(CBOR) file.
+    output_file out(fn_dat.string());
+    if (!out.is_open()) {
+        print_line("ERROR!! can't open DAT file(", fn_dat, ").");
+        return false;
+    }
+    write_cbor(out, json_list, cbor_opt);
+    if (!out.close()) {
+        print_line("ERROR!! can't write DAT file(", fn_dat, ").");
+        return false;
+    }
 
-    // read JSON file.
-    std::ifstream ifs(filename.c_str());
-    if (!ifs.is_open()) {
-        std::cout << "ERROR!! can't open JSON file(" << filename << ")." << std::endl;
+    return true;
+}
+
+bool json2dat_stream(const fs::path &filename, bool force_float32 = false, double float16_tolerance = -1.0)
+{
+    constexpr auto ext_dat = "dat";
+    fs::path fn_dat = filename;
+    fn_dat.replace_extension(ext_dat);
+
+    // write dat(CBOR) file while reading JSON file.
+    output_file out(fn_dat.string());
+    if (!out.is_open()) {
+        print_line("ERROR!! can't open DAT file(", fn_dat, ").");
         return false;
     }
-    njson json_list = {};
-    if (force_float32) {
-        json_list = njson::parse(ifs, cb);
+    cbor_sax_writer<njson> sax(out.adapter(), force_float32, float16_tolerance);
+
+    bool ret = false;
+    mapped_file mf;
+    if (mf.open(filename.string())) {
+        ret = njson::sax_parse(mf.begin(), mf.end(), &sax);
     } else {
-        ifs >> json_list;
+        std::ifstream ifs(filename.c_str());
+        if (!ifs.is_open()) {
+            print_line("ERROR!! can't open JSON file(", filename, ").");
+            return false;
+        }
+        ret = njson::sax_parse(ifs, &sax);
+    }
+    sax.flush();
+    if (!out.close() && ret) {
+        print_line("ERROR!! can't write DAT file(", fn_dat, ").");
+        ret = false;
+    } else if (!ret) {
+        print_line("ERROR!! ", sax.get_error());
     }
 
-    // write dat(CBOR) file.
-    std::ofstream ofs(fn_dat, std::ios::binary);
-    if (!ofs.is_open()) {
-        std::cout << "ERROR!! can't open DAT file(" << fn_dat << ")." << std::endl;
+    if (!ret) {
+        std::error_code ec;
+        fs::remove(fn_dat, ec);
         return false;
     }
-    auto cbor_list = njson::to_cbor(json_list);
-    ofs.write(reinterpret_cast<char *>(cbor_list.data()), cbor_list.size());
 
     return true;
 }
 
-bool dat2json(const fs::path &filename)
+bool dat2json(const fs::path &filename, bool float32_output = false)
 {
     constexpr auto ext_json = "json";
     fs::path fn_json = filename;
     fn_json.replace_extension(ext_json);
 
     // read dat(CBOR) file.
-    std::ifstream ifs(filename.c_str(), std::ios::binary);
-    if (!ifs.is_open()) {
-        std::cout << "ERROR!! can't open DAT file(" << filename << ")." << std::endl;
-        return false;
+    njson json_list = {};
+    mapped_file mf;
+    if (mf.open(filename.string())) {
+        json_list = njson::from_cbor(mf.begin(), mf.end());
+    } else {
+        std::ifstream ifs(filename.c_str(), std::ios::binary);
+        if (!ifs.is_open()) {
+            print_line("ERROR!! can't open DAT file(", filename, ").");
+            return false;
+        }
+        json_list = njson::from_cbor(ifs);
     }
-    auto sz = fs::file_size(filename);
-    std::vector<uint8_t> cbor_list(sz);
-    ifs.read(reinterpret_cast<char *>(cbor_list.data()), sz);
 
     // write JSON file.
-    std::ofstream ofs(fn_json);
-    if (!ofs.is_open()) {
-        std::cout << "ERROR!! can't open JSON file(" << fn_json << ")." << std::endl;
+    output_file out(fn_json.string());
+    if (!out.is_open()) {
+        print_line("ERROR!! can't open JSON file(", fn_json, ").");
+        return false;
+    }
+    dump_json(json_list, out.adapter(), 4, float32_output);
+    out.write("\n", 1);
+    if (!out.close()) {
+        print_line("ERROR!! can't write JSON file(", fn_json, ").");
+        return false;
+    }
+
+    return true;
+}
+
+bool dat2json_stream(const fs::path &filename, bool float32_output = false)
+{
+    constexpr auto ext_json = "json";
+    fs::path fn_json = filename;
+    fn_json.replace_extension(ext_json);
+
+    // write JSON file while reading dat(CBOR) file.
+    output_file out(fn_json.string());
+    if (!out.is_open()) {
+        print_line("ERROR!! can't open JSON file(", fn_json, ").");
+        return false;
+    }
+    json_sax_writer<njson> sax(out.adapter(), 4);
+    sax.set_float32_output(float32_output);
+
+    bool ret = false;
+    mapped_file mf;
+    if (mf.open(filename.string())) {
+        ret = njson::sax_parse(mf.begin(), mf.end(), &sax, njson::input_format_t::cbor);
+    } else {
+        std::ifstream ifs(filename.c_str(), std::ios::binary);
+        if (!ifs.is_open()) {
+            print_line("ERROR!! can't open DAT file(", filename, ").");
+            return false;
+        }
+        ret = njson::sax_parse(ifs, &sax, njson::input_format_t::cbor);
+    }
+    out.write("\n", 1);
+    if (!out.close() && ret) {
+        print_line("ERROR!! can't write JSON file(", fn_json, ").");
+        ret = false;
+    } else if (!ret) {
+        print_line("ERROR!! ", sax.get_error());
+    }
+
+    if (!ret) {
+        std::error_code ec;
+        fs::remove(fn_json, ec);
+        return false;
+    }
+
+    return true;
+}
+
+enum class em_file_type {
+    UNKNOWN,
+    JSON,
+    DAT,
+};
+
+em_file_type get_file_type(const fs::path &filename)
+{
+    auto ext = filename.extension();
+    auto ext_str = ext.generic_string();
+    std::transform(ext_str.cbegin(), ext_str.cend(), ext_str.begin(), ::tolower);
+
+    if (ext_str == ".json") return em_file_type::JSON;
+    if (ext_str == ".dat") return em_file_type::DAT;
+    return em_file_type::UNKNOWN;
+}
+
+fs::path get_output_filename(const fs::path &filename)
+{
+    fs::path fn_out = filename;
+    fn_out.replace_extension(get_file_type(filename) == em_file_type::JSON ? "dat" : "json");
+    return fn_out;
+}
+
+// stream conversion for pipes. ("-" is stdin / stdout)
+bool convert_pipe(const std::string &fn_in, const std::string &fn_out, em_file_type from, em_file_type to)
+{
+    auto get_format = [](em_file_type type) {
+        return (type == em_file_type::JSON) ? njson::input_format_t::json : njson::input_format_t::cbor;
+    };
+
+    // input. (opened first: the output is truncated when opened)
+    mapped_file mf;
+    int fd_in = -1;
+    if (fn_in == "-") {
+        fd_in = fileno(stdin);
+        io_set_binary(fd_in);
+    } else if (!mf.open(fn_in)) {
+        fd_in = io_open_read(fn_in);
+        if (fd_in < 0) {
+            print_line("ERROR!! can't open input file(", fn_in, ").");
+            return false;
+        }
+    }
+
+    // output.
+    int fd_out = -1;
+    if (fn_out == "-") {
+        fd_out = fileno(stdout);
+        io_set_binary(fd_out);
+    } else {
+        fd_out = io_open_write(fn_out);
+        if (fd_out < 0) {
+            print_line("ERROR!! can't open output file(", fn_out, ").");
+            if (fd_in >= 0 && fn_in != "-") io_close(fd_in);
+            return false;
+        }
+    }
+    auto oa = std::make_shared<fd_output_adapter>(fd_out);
+
+    // input -> output.
+    auto parse = [&](auto &sax) -> bool {
+        if (fd_in < 0) {
+            return sax_parse_input<njson>(nlohmann::detail::input_adapter(mf.begin(), mf.end()), &sax, get_format(from));
+        }
+        return sax_parse_input<njson>(fd_input_adapter(fd_in), &sax, get_format(from));
+    };
+
+    bool ret = false;
+    if (to == em_file_type::JSON) {
+        json_sax_writer<njson> sax(oa, 4);
+        sax.set_float32_output(opt_float32_output);
+        ret = parse(sax);
+        if (ret) oa->write_character('\n');
+        if (!sax.get_error().empty()) print_line("ERROR!! ", sax.get_error());
+    } else {
+        cbor_sax_writer<njson> sax(oa, opt_force_float32, opt_float16);
+        ret = parse(sax);
+        sax.flush();
+        if (!sax.get_error().empty()) print_line("ERROR!! ", sax.get_error());
+    }
+    if (!oa->flush()) {
+        print_line("ERROR!! can't write output file(", fn_out, ").");
+        ret = false;
+    }
+    oa.reset();
+    if (fd_in >= 0 && fn_in != "-") io_close(fd_in);
+
+    if (fn_out != "-") {
+        io_close(fd_out);
+        if (!ret) {
+            std::error_code ec;
+            fs::remove(fs::path{fn_out}, ec);
+        }
+    }
+
+    return ret;
+}
+
+// '*' and '?' wildcard.
+bool match_wildcard(const char *pat, const char *str)
+{
+    const char *pat_star = nullptr;
+    const char *str_star = nullptr;
+    while (*str) {
+        if (*pat == '?' || *pat == *str) {
+            pat++;
+            str++;
+        } else if (*pat == '*') {
+            pat_star = pat++;
+            str_star = str;
+        } else if (pat_star) {
+            pat = pat_star + 1;
+            str = ++str_star;
+        } else {
+            return false;
+        }
+    }
+    while (*pat == '*') pat++;
+    return *pat == '\0';
+}
+
+// expand the command line argument to the files to convert.
+//   file, directory (recursive), glob in the file name. ("dir/*.json", "dir/**/*.dat")
+bool collect_files(const std::string &arg, std::vector<fs::path> &files)
+{
+    std::error_code ec;
+    fs::path p = fs::path{arg};
+
+    auto pattern = p.filename().string();
+    if (pattern.find_first_of("*?") != std::string::npos) {
+        auto dir = p.parent_path();
+        bool recursive = (dir.filename() == "**");
+        if (recursive) dir = dir.parent_path();
+        if (dir.empty()) dir = ".";
+        if (dir.string().find_first_of("*?") != std::string::npos) {
+            print_line("ERROR!! wildcard is supported only in the file name(", p, ").");
+            return false;
+        }
+
+        auto n = files.size();
+        auto add_match = [&](const fs::directory_entry &e) {
+            if (e.is_regular_file(ec) && match_wildcard(pattern.c_str(), e.path().filename().string().c_str())
+                && get_file_type(e.path()) != em_file_type::UNKNOWN) {
+                files.push_back(e.path());
+            }
+        };
+        if (recursive) {
+            for (auto &e : fs::recursive_directory_iterator(dir, ec)) add_match(e);
+        } else {
+            for (auto &e : fs::directory_iterator(dir, ec)) add_match(e);
+        }
+        if (files.size() == n) {
+            print_line("ERROR!! file not found(", p, ").");
+            return false;
+        }
+
+    } else if (fs::is_directory(p, ec)) {
+        for (auto &e : fs::recursive_directory_iterator(p, ec)) {
+            if (e.is_regular_file(ec) && get_file_type(e.path()) != em_file_type::UNKNOWN) files.push_back(e.path());
+        }
+
+    } else if (fs::is_regular_file(p, ec)) {
+        files.push_back(p);
+
+    } else {
+        print_line("ERROR!! file not found(", p, ").");
+        return false;
+    }
+
+    return true;
+}
+
+bool convert_file(const fs::path &filename)
+{
+    try {
+        switch (get_file_type(filename)) {
+        case em_file_type::JSON:
+            {
+                auto ret = opt_stream
+                    ? json2dat_stream(filename, opt_force_float32, opt_float16)
+                    : json2dat(filename, opt_force_float32, {opt_float16, opt_typed_array, opt_index});
+                if (!ret) {
+                    print_line("ERROR!! can't convert JSON -> DAT(", filename, ").");
+                    return false;
+                }
+            }
+            break;
+
+        case em_file_type::DAT:
+            {
+                auto ret = opt_stream
+                    ? dat2json_stream(filename, opt_float32_output)
+                    : dat2json(filename, opt_float32_output);
+                if (!ret) {
+                    print_line("ERROR!! can't convert DAT -> JSON(", filename, ").");
+                    return false;
+                }
+            }
+            break;
+
+        default:
+            print_line("ERROR!! not support file type(", filename, ").");
+            return false;
+        }
+
+    } catch (const std::exception &e) {
+        print_line("ERROR!! ", filename, " : ", e.what());
         return false;
     }
-    njson json_list = njson::from_cbor(cbor_list);
-    ofs << std::setw(4) << json_list << std::endl;
 
     return true;
 }
 
 int main(int argc, char *argv[])
 {
-    if (argc < 2) {
-        std::cout << "usage: json_util [option] <hogehoge.json | fugafuga.dat>" << std::endl;
+    std::vector<std::string> args;
+    for (auto i = 1; i < argc; i++) {
+        std::string opt{argv[i]};
+        if (opt == "-f") {
+            opt_force_float32 = true;
+        } else if (opt == "--float32-output") {
+            opt_float32_output = true;
+        } else if (opt == "-s") {
+            opt_stream = true;
+        } else if (opt == "--typed-array") {
+            opt_typed_array = true;
+        } else if (opt == "--index") {
+            opt_index = true;
+        } else if (opt == "--float16") {
+            auto num = (i + 1 < argc) ? std::string{argv[++i]} : std::string{};
+            try {
+                opt_float16 = std::stod(num);
+            } catch (...) {
+                opt_float16 = -1.0;
+            }
+            if (!(opt_float16 >= 0)) {
+                std::cout << "ERROR!! invalid float16 tolerance(" << num << ")." << std::endl;
+                exit(EXIT_FAILURE);
+            }
+        } else if (opt == "--from" || opt == "--to" || opt == "-o") {
+            if (i + 1 >= argc) {
+                std::cout << "ERROR!! " << opt << " needs an argument." << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            auto &dst = (opt == "--from") ? opt_from : ((opt == "--to") ? opt_to : opt_output);
+            dst = argv[++i];
+        } else if (opt.rfind("-j", 0) == 0) {
+            auto num = (opt.size() > 2) ? opt.substr(2) : ((i + 1 < argc) ? std::string{argv[++i]} : std::string{});
+            try {
+                opt_num_threads = std::stoul(num);
+            } catch (...) {
+                std::cout << "ERROR!! invalid number of threads(" << num << ")." << std::endl;
+                exit(EXIT_FAILURE);
+            }
+        } else if (opt.size() > 1 && opt[0] == '-') {
+            std::cout << "ERROR!! unknown option(" << opt << ")." << std::endl;
+            exit(EXIT_FAILURE);
+        } else {
+            args.push_back(opt);
+        }
+    }
+
+    if (args.empty()) {
+        std::cout << "usage: json_util [option] <hogehoge.json | fugafuga.dat | directory | \"glob\"> ..." << std::endl;
         std::cout << "    Convert fileformat json <---> dat." << std::endl;
+        std::cout << "    directories are searched recursively, glob is supported in the file name. (\"dir/*.json\", \"dir/**/*.dat\")" << std::endl;
         std::cout << "    option:" << std::endl;
         std::cout << "    ---" << std::endl;
         std::cout << "    -f: [json -> dat] using float32 to convert from JSON to binary." << std::endl;
+        std::cout << "    --float16 TOL: [json -> dat] write floats as float16 when the error is within TOL. (e.g. 0.001, 0: lossless only)" << std::endl;
+        std::cout << "    --typed-array: [json -> dat] write arrays of numbers as RFC 8746 typed arrays. (not with -s or pipe mode)" << std::endl;
+        std::cout << "    --index: [json -> dat] write an index of the top-level items, for read_json_key(). (not with -s or pipe mode)" << std::endl;
+        std::cout << "    --float32-output: [dat -> json] print floats exact in float32 with the shortest digits for float. (0.1f: 0.1)" << std::endl;
+        std::cout << "    -s: [json <-> dat] convert while parsing, without building the whole JSON in memory." << std::endl;
+        std::cout << "                       ([json -> dat] arrays and objects are written as indefinite-length items.)" << std::endl;
+        std::cout << "                       ([dat -> json] keys are written in the input order, not sorted, and duplicates are kept.)" << std::endl;
+        std::cout << "    -j N: number of threads to convert files in parallel. (default: number of CPU cores)" << std::endl;
+        std::cout << "    ---" << std::endl;
+        std::cout << "    pipe mode: json_util --from <json | cbor> [--to <json | cbor>] [-o <output | ->] <input | ->" << std::endl;
+        std::cout << "    --from json|cbor: input format. (required for stdin, otherwise from the extension)" << std::endl;
+        std::cout << "    --to json|cbor  : output format. (default: the other one of --from)" << std::endl;
+        std::cout << "    -o <file>       : output file. (default: stdout for stdin, otherwise the input with the extension replaced)" << std::endl;
+        std::cout << "    -               : stdin / stdout." << std::endl;
         exit(EXIT_FAILURE);
     }
 
-    fs::path filename;
-    if (argc == 3) {
-        if (std::string{argv[1]} == "-f") opt_force_float32 = true;
-        filename = fs::path{argv[2]};
-    } else {
-        filename = fs::path{argv[1]};
+    // typed arrays need the whole array before it's written.
+    auto pipe_mode = (args[0] == "-" || !opt_from.empty() || !opt_to.empty() || !opt_output.empty());
+    if (opt_typed_array && (opt_stream || pipe_mode)) {
+        std::cout << "ERROR!! --typed-array can't be used with -s or in pipe mode." << std::endl;
+        exit(EXIT_FAILURE);
     }
-
-    std::error_code ec;
-    if (!fs::is_regular_file(filename, ec)) {
-        std::cout << "ERROR!! file not found(" << filename << ")." << std::endl;
+    // the index needs the whole document before it's written.
+    if (opt_index && (opt_stream || pipe_mode)) {
+        std::cout << "ERROR!! --index can't be used with -s or in pipe mode." << std::endl;
         exit(EXIT_FAILURE);
     }
 
-    auto ext = filename.extension();
-    auto ext_str = ext.generic_string();
-    std::transform(ext_str.cbegin(), ext_str.cend(), ext_str.begin(), ::tolower);
+    // pipe mode.
+    if (pipe_mode) {
+        // stdout may be the data, so messages go to stderr.
+        log_stream = &std::cerr;
+
+        auto parse_format = [](const std::string &str) {
+            if (str == "json") return em_file_type::JSON;
+            if (str == "cbor" || str == "dat") return em_file_type::DAT;
+            return em_file_type::UNKNOWN;
+        };
 
-    if (ext_str == ".json") {
-        if (!json2dat(filename, opt_force_float32)) {
-            std::cout << "ERROR!! can't convert JSON -> DAT." << std::endl;
+        if (args.size() != 1) {
+            print_line("ERROR!! only one input is allowed in pipe mode.");
             exit(EXIT_FAILURE);
         }
-    } else if (ext_str == ".dat") {
-        if (!dat2json(filename)) {
-            std::cout << "ERROR!! can't convert DAT -> JSON." << std::endl;
+        const auto &fn_in = args[0];
+
+        auto from = opt_from.empty() ? get_file_type(fs::path{fn_in}) : parse_format(opt_from);
+        if (from == em_file_type::UNKNOWN) {
+            print_line("ERROR!! unknown input format. (--from json|cbor)");
             exit(EXIT_FAILURE);
         }
-    } else {
-        std::cout << "ERROR!! not support file type." << std::endl;
-        exit(EXIT_FAILURE);
+        auto to = opt_to.empty()
+            ? ((from == em_file_type::JSON) ? em_file_type::DAT : em_file_type::JSON)
+            : parse_format(opt_to);
+        if (to == em_file_type::UNKNOWN) {
+            print_line("ERROR!! unknown output format. (--to json|cbor)");
+            exit(EXIT_FAILURE);
+        }
+
+        auto fn_out = opt_output;
+        if (fn_out.empty()) {
+            fn_out = (fn_in == "-")
+                ? std::string{"-"}
+                : fs::path{fn_in}.replace_extension((to == em_file_type::JSON) ? "json" : "dat").string();
+        }
+        // the same file by another name too. ("./hoge.json", absolute paths, links)
+        std::error_code ec;
+        if (fn_out != "-" && fn_in != "-" && (fs::path{fn_out} == fs::path{fn_in} || fs::equivalent(fn_out, fn_in, ec))) {
+            print_line("ERROR!! input and output are the same file(", fn_in, ").");
+            exit(EXIT_FAILURE);
+        }
+
+        bool ret = false;
+        try {
+            ret = convert_pipe(fn_in, fn_out, from, to);
+        } catch (const std::exception &e) {
+            print_line("ERROR!! ", e.what());
+        }
+
+        return ret ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // list up the files.
+    std::vector<fs::path> files;
+    std::set<fs::path> file_set;
+    std::size_t num_converted = 0;
+    std::size_t num_failed = 0;
+    std::size_t num_skipped = 0;
+    for (auto &arg : args) {
+        std::vector<fs::path> found;
+        if (!collect_files(arg, found)) num_failed++;
+        for (auto &f : found) {
+            if (file_set.insert(f.lexically_normal()).second) files.push_back(f);
+        }
+    }
+
+    // convert on the thread pool.
+    std::vector<std::future<bool>> results;
+    {
+        thread_pool pool(std::min(opt_num_threads ? opt_num_threads : std::thread::hardware_concurrency(), files.size()));
+        for (auto &f : files) {
+            // don't convert the file which is an output of another one. ("hoge.json" and "hoge.dat")
+            // (e.g. the outputs of the last run in the same directory, so it's not an error)
+            if (file_set.count(get_output_filename(f).lexically_normal())) {
+                print_line("WARNING!! both input and output are given, skipped(", f, ").");
+                num_skipped++;
+                continue;
+            }
+            results.push_back(pool.submit(convert_file, f));
+        }
+        for (auto &r : results) {
+            if (r.get()) {
+                num_converted++;
+            } else {
+                num_failed++;
+            }
+        }
+    }
+
+    if (files.size() > 1) {
+        print_line(num_converted, " file(s) converted, ", num_skipped, " skipped, ", num_failed, " failed.");
     }
 
-    return EXIT_SUCCESS;
+    return (num_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
 }
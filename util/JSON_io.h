@@ -0,0 +1,634 @@
+/*
+ * Copyright (c) 2024, edgecraft. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <fcntl.h>
+#include <io.h>
+#include <process.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "json.hpp"
+
+namespace {
+
+constexpr std::size_t io_buffer_size = 1024 * 1024;
+
+#if defined(_WIN32)
+inline int io_open_read(const std::string &filename) { return ::_open(filename.c_str(), _O_RDONLY | _O_BINARY); }
+inline int io_open_write(const std::string &filename) { return ::_open(filename.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE); }
+inline int io_close(int fd) { return ::_close(fd); }
+inline long long io_read(int fd, void *buf, std::size_t len) { return ::_read(fd, buf, static_cast<unsigned int>(len)); }
+inline long long io_write(int fd, const void *buf, std::size_t len) { return ::_write(fd, buf, static_cast<unsigned int>(len)); }
+inline void io_set_binary(int fd) { ::_setmode(fd, _O_BINARY); }
+inline int io_open_new(const std::string &filename) { return ::_open(filename.c_str(), _O_WRONLY | _O_CREAT | _O_EXCL | _O_BINARY, _S_IREAD | _S_IWRITE); }
+inline int io_sync(int fd) { return ::_commit(fd); }
+inline bool io_rename(const std::string &from, const std::string &to) { return ::MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0; }
+inline void io_remove(const std::string &filename) { ::_unlink(filename.c_str()); }
+inline int io_pid() { return ::_getpid(); }
+inline void io_sync_dir(const std::string & /*unused*/) {}
+#else
+inline int io_open_read(const std::string &filename) { return ::open(filename.c_str(), O_RDONLY); }
+inline int io_open_write(const std::string &filename) { return ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644); }
+inline int io_close(int fd) { return ::close(fd); }
+inline long long io_read(int fd, void *buf, std::size_t len) { return ::read(fd, buf, len); }
+inline long long io_write(int fd, const void *buf, std::size_t len) { return ::write(fd, buf, len); }
+inline void io_set_binary(int /*unused*/) {}
+inline int io_open_new(const std::string &filename) { return ::open(filename.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644); }
+inline int io_sync(int fd) { return ::fsync(fd); }
+inline bool io_rename(const std::string &from, const std::string &to) { return ::rename(from.c_str(), to.c_str()) == 0; }
+inline void io_remove(const std::string &filename) { ::unlink(filename.c_str()); }
+inline int io_pid() { return static_cast<int>(::getpid()); }
+
+// make a rename in the directory of filename durable.
+inline void io_sync_dir(const std::string &filename)
+{
+    auto pos = filename.find_last_of('/');
+    auto dir = (pos == std::string::npos) ? std::string(".") : filename.substr(0, pos + 1);
+    int fd = ::open(dir.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    ::fsync(fd);
+    ::close(fd);
+}
+#endif
+
+// input adapter reading a file descriptor (stdin, pipe, file) in large blocks.
+// for nlohmann::detail::parser and nlohmann::detail::binary_reader.
+class fd_input_adapter
+{
+public:
+    using char_type = char;
+
+    explicit fd_input_adapter(int fd, std::size_t buf_size = io_buffer_size)
+        : fd(fd), buf(new char[buf_size]), buf_size(buf_size)
+    {}
+
+    fd_input_adapter(const fd_input_adapter &) = delete;
+    fd_input_adapter(fd_input_adapter &&) noexcept = default;
+    fd_input_adapter &operator=(const fd_input_adapter &) = delete;
+    fd_input_adapter &operator=(fd_input_adapter &&) = delete;
+
+    std::char_traits<char>::int_type get_character()
+    {
+        if (pos == len && !fill()) return std::char_traits<char>::eof();
+        return std::char_traits<char>::to_int_type(buf[pos++]);
+    }
+
+private:
+    bool fill()
+    {
+        long long n = 0;
+        do {
+            n = io_read(fd, buf.get(), buf_size);
+        } while (n < 0 && errno == EINTR);
+        if (n <= 0) return false;
+
+        pos = 0;
+        len = static_cast<std::size_t>(n);
+        return true;
+    }
+
+    int fd = -1;
+    std::unique_ptr<char[]> buf;
+    std::size_t buf_size = 0;
+    std::size_t pos = 0;
+    std::size_t len = 0;
+};
+
+// output adapter writing to a file descriptor (stdout, pipe, file) in large blocks.
+class fd_output_adapter : public nlohmann::detail::output_adapter_protocol<char>
+{
+public:
+    explicit fd_output_adapter(int fd, std::size_t buf_size = io_buffer_size)
+        : fd(fd), buf(new char[buf_size]), buf_size(buf_size)
+    {}
+
+    ~fd_output_adapter() override { flush(); }
+
+    void write_character(char c) override
+    {
+        if (len == buf_size) flush();
+        buf[len++] = c;
+    }
+
+    void write_characters(const char *s, std::size_t length) override
+    {
+        if (length == 0) return;
+        if (len + length > buf_size) {
+            flush();
+            if (length >= buf_size) {
+                write_all(s, length);
+                return;
+            }
+        }
+        std::memcpy(buf.get() + len, s, length);
+        len += length;
+    }
+
+    // returns false if any write has failed.
+    bool flush()
+    {
+        if (len > 0) {
+            write_all(buf.get(), len);
+            len = 0;
+        }
+        return good;
+    }
+
+private:
+    void write_all(const char *s, std::size_t length)
+    {
+        while (good && length > 0) {
+            auto n = io_write(fd, s, length);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) {
+                good = false;
+                break;
+            }
+            s += n;
+            length -= static_cast<std::size_t>(n);
+        }
+    }
+
+    int fd = -1;
+    std::unique_ptr<char[]> buf;
+    std::size_t buf_size = 0;
+    std::size_t len = 0;
+    bool good = true;
+};
+
+// how output_file writes the file.
+struct file_write_options
+{
+    bool atomic = false; // write a temporary file in the same directory, and rename it to the file on close().
+    bool sync = false;   // flush the file to the disk (fsync) before closing it.
+};
+
+// file opened for writing through fd_output_adapter, without iostreams.
+// the adapter is shared with the writers (serializer, binary_writer, sax writers).
+// in the atomic mode the file is replaced only when everything has been written,
+// so a crash or an error leaves either the old or the new file, never a truncated one.
+class output_file
+{
+public:
+    explicit output_file(const std::string &filename, const file_write_options &opt = {}, std::size_t buf_size = io_buffer_size)
+        : filename(filename), opt(opt)
+    {
+        if (opt.atomic) {
+            open_temp();
+        } else {
+            fd = io_open_write(filename);
+        }
+        if (fd >= 0) oa = std::make_shared<fd_output_adapter>(fd, buf_size);
+    }
+
+    // without close() (e.g. an exception while writing) the output is given up. (see discard())
+    ~output_file() { discard(); }
+
+    output_file(const output_file &) = delete;
+    output_file &operator=(const output_file &) = delete;
+
+    bool is_open() const { return fd >= 0; }
+
+    nlohmann::detail::output_adapter_t<char> adapter() const { return oa; }
+
+    void write(const void *data, std::size_t length) { oa->write_characters(static_cast<const char *>(data), length); }
+
+    // set the file to size bytes and map it for writing, before anything is written. (instead of write() / adapter())
+    // returns nullptr if the file can't be mapped (e.g. size 0), and the file is written as usual.
+    std::uint8_t *map(std::size_t size)
+    {
+        if (fd < 0 || size == 0 || map_data != nullptr) return nullptr;
+
+#if defined(_WIN32)
+        auto h_file = reinterpret_cast<HANDLE>(::_get_osfhandle(fd));
+        auto sz = static_cast<unsigned long long>(size);
+        HANDLE h_map = ::CreateFileMappingA(h_file, nullptr, PAGE_READWRITE, static_cast<DWORD>(sz >> 32), static_cast<DWORD>(sz), nullptr);
+        if (h_map == nullptr) return nullptr;
+        void *p = ::MapViewOfFile(h_map, FILE_MAP_WRITE, 0, 0, size);
+        ::CloseHandle(h_map);
+        if (p == nullptr) return nullptr;
+#else
+#if defined(__linux__)
+        // allocate the blocks now: a full disk is an error here, not a SIGBUS while writing.
+        if (::posix_fallocate(fd, 0, static_cast<off_t>(size)) != 0) return nullptr;
+#else
+        if (::ftruncate(fd, static_cast<off_t>(size)) != 0) return nullptr;
+#endif
+        void *p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            if (::ftruncate(fd, 0) != 0) good = false;
+            return nullptr;
+        }
+#endif
+
+        map_data = static_cast<std::uint8_t *>(p);
+        map_size = size;
+        return map_data;
+    }
+
+    // flush and close the file. returns false if any write has failed.
+    // in the atomic mode the temporary file replaces the file if all went well, and is removed otherwise.
+    bool close()
+    {
+        if (fd < 0) return good;
+        if (map_data != nullptr) {
+#if defined(_WIN32)
+            if (opt.sync && !::FlushViewOfFile(map_data, 0)) good = false;
+            ::UnmapViewOfFile(map_data);
+#else
+            if (opt.sync && ::msync(map_data, map_size, MS_SYNC) != 0) good = false;
+            ::munmap(map_data, map_size);
+#endif
+            map_data = nullptr;
+        }
+        good = oa->flush() && good;
+        if (opt.sync && io_sync(fd) != 0) good = false;
+        if (io_close(fd) != 0) good = false;
+        fd = -1;
+
+        if (opt.atomic) {
+            if (good && !io_rename(temp_name, filename)) good = false;
+            if (!good) io_remove(temp_name);
+            if (good && opt.sync) io_sync_dir(filename);
+        }
+        return good;
+    }
+
+    // give up the output. (the atomic mode leaves the file as it was)
+    void discard()
+    {
+        if (fd < 0) return;
+        good = false;
+        close();
+    }
+
+private:
+    void open_temp()
+    {
+        static std::atomic<unsigned> counter{0};
+        for (int retry = 0; retry < 100 && fd < 0; retry++) {
+            temp_name = filename + "." + std::to_string(io_pid()) + "-" + std::to_string(counter++) + ".tmp";
+            fd = io_open_new(temp_name);
+            if (fd < 0 && errno != EEXIST) break;
+        }
+#if !defined(_WIN32)
+        // keep the permissions of the file being replaced.
+        struct stat st;
+        if (fd >= 0 && ::stat(filename.c_str(), &st) == 0) ::fchmod(fd, st.st_mode & 07777);
+#endif
+    }
+
+    std::string filename;
+    std::string temp_name;
+    file_write_options opt;
+    int fd = -1;
+    std::shared_ptr<fd_output_adapter> oa;
+    std::uint8_t *map_data = nullptr;
+    std::size_t map_size = 0;
+    bool good = true;
+};
+
+// serialize a DOM as JSON text. (same as `os << std::setw(indent) << j`, indent <= 0: compact)
+// with float32, floats exact in single precision are printed with the shortest digits for float.
+template<typename BasicJsonType>
+void dump_json(const BasicJsonType &j, nlohmann::detail::output_adapter_t<char> oa, int indent = 0, bool float32 = false)
+{
+    nlohmann::detail::serializer<BasicJsonType> s(std::move(oa), ' ');
+    s.set_float32_output(float32);
+    s.dump(j, indent > 0, false, static_cast<unsigned int>(indent > 0 ? indent : 0));
+}
+
+// parse JSON text into a DOM. (throws like njson::parse)
+// with float32, every floating-point number is rounded to single precision as it is parsed.
+// with presize, the elements of every array (and ordered object) are counted by a quick pass
+// over the text first, and reserved as they are created. (memory / mmap input only)
+template<typename BasicJsonType, typename InputAdapterType>
+BasicJsonType parse_json_input(InputAdapterType &&ia, bool float32 = false, bool presize = false)
+{
+    using adapter_t = std::decay_t<InputAdapterType>;
+
+    BasicJsonType result;
+    nlohmann::detail::json_sax_dom_parser<BasicJsonType> sdp(result, true, float32);
+
+    std::vector<std::size_t> sizes;
+    if constexpr (nlohmann::detail::is_contiguous_input_adapter<adapter_t>::value) {
+        if (presize && ia.remaining_size() > 0) {
+            nlohmann::detail::lexer_scan::container_sizes(reinterpret_cast<const char *>(ia.remaining_data()), ia.remaining_size(), sizes);
+            sdp.set_size_hints(&sizes);
+        }
+    }
+    nlohmann::detail::parser<BasicJsonType, adapter_t>(std::move(ia), nullptr, true, false).sax_parse(&sdp, true);
+    return result;
+}
+
+// options of the CBOR output.
+struct cbor_write_options
+{
+    double float16_tolerance = -1.0; // floats within this absolute error are written as float16. (negative: never)
+    bool typed_arrays = false;       // arrays of numbers are written as RFC 8746 typed arrays.
+    bool indexed = false;            // an index of the top-level items is written in front. (see to_cbor_indexed)
+};
+
+// CBOR head. (major type and argument)
+inline void append_cbor_head(std::vector<std::uint8_t> &out, std::uint8_t major, std::uint64_t val)
+{
+    major = static_cast<std::uint8_t>(major << 5);
+    if (val <= 0x17) {
+        out.push_back(static_cast<std::uint8_t>(major + val));
+        return;
+    }
+    int n = (val <= 0xFF) ? 1 : ((val <= 0xFFFF) ? 2 : ((val <= 0xFFFFFFFF) ? 4 : 8));
+    out.push_back(static_cast<std::uint8_t>(major + ((n == 1) ? 24 : ((n == 2) ? 25 : ((n == 4) ? 26 : 27)))));
+    for (int i = n - 1; i >= 0; i--) out.push_back(static_cast<std::uint8_t>(val >> (8 * i)));
+}
+
+// CBOR of j with an index in front:
+//   tag(cbor_index_tag) [bstr(index), j]
+//   index = {"lookup": [hash, position, ...],                   (j is an object)
+//            "keys": {key: [offset, size(, chunk, offsets)]}}
+//           {"chunk": chunk, "offsets": offsets}                (j is an array)
+// offsets are from the start of j. arrays of more than chunk elements get the offsets of
+// every chunk-th element, so cbor_view can seek into them.
+// lookup is sorted by the hash of the key (cbor_index_hash), position is where the key is in "keys",
+// so cbor_view finds a key by a binary search.
+// readers without the index (njson::from_cbor etc.) skip it and read j.
+template<typename BasicJsonType>
+std::vector<std::uint8_t> to_cbor_indexed(const BasicJsonType &j, const cbor_write_options &opt, std::size_t chunk = 1024)
+{
+    std::vector<std::uint8_t> data;
+    nlohmann::detail::binary_writer<BasicJsonType, std::uint8_t> writer{nlohmann::detail::output_adapter<std::uint8_t>(data)};
+    writer.set_cbor_float16_tolerance(opt.float16_tolerance);
+    writer.set_cbor_typed_arrays(opt.typed_arrays);
+
+    // write an array, returns the offsets of every chunk-th element. (empty if not needed)
+    auto write_array = [&](const BasicJsonType &a) {
+        std::vector<std::uint64_t> offsets;
+        auto begin = data.size();
+        if (a.size() > chunk) {
+            if (opt.typed_arrays) {
+                writer.write_cbor(a);
+                if (data[begin] == 0xD8) return offsets;  // typed array. (random access already)
+                data.resize(begin);
+            }
+
+            append_cbor_head(data, 4, a.size());
+            for (std::size_t i = 0; i < a.size(); i++) {
+                if (i % chunk == 0) offsets.push_back(data.size());
+                writer.write_cbor(a[i]);
+            }
+        } else {
+            writer.write_cbor(a);
+        }
+        return offsets;
+    };
+
+    std::vector<std::uint8_t> index_cbor;
+    nlohmann::detail::binary_writer<BasicJsonType, std::uint8_t> index_writer{nlohmann::detail::output_adapter<std::uint8_t>(index_cbor)};
+    index_writer.set_cbor_typed_arrays(true);
+
+    BasicJsonType index = BasicJsonType::object();
+    if (j.is_object()) {
+        // "keys" is written here to know where each key is.
+        std::vector<std::uint8_t> keys;
+        nlohmann::detail::binary_writer<BasicJsonType, std::uint8_t> keys_writer{nlohmann::detail::output_adapter<std::uint8_t>(keys)};
+        keys_writer.set_cbor_typed_arrays(true);
+        std::vector<std::pair<std::uint64_t, std::uint64_t>> lookup;
+        lookup.reserve(j.size());
+        append_cbor_head(keys, 5, j.size());
+
+        append_cbor_head(data, 5, j.size());
+        for (auto it = j.cbegin(); it != j.cend(); ++it) {
+            append_cbor_head(data, 3, it.key().size());
+            data.insert(data.end(), it.key().begin(), it.key().end());
+
+            std::uint64_t offset = data.size();
+            std::vector<std::uint64_t> offsets;
+            if (it.value().is_array()) {
+                offsets = write_array(it.value());
+            } else {
+                writer.write_cbor(it.value());
+            }
+
+            auto entry = BasicJsonType::array({offset, data.size() - offset});
+            if (!offsets.empty()) {
+                entry.push_back(chunk);
+                entry.push_back(std::move(offsets));
+            }
+            lookup.emplace_back(nlohmann::detail::cbor_index_hash(it.key().data(), it.key().size()), keys.size());
+            append_cbor_head(keys, 3, it.key().size());
+            keys.insert(keys.end(), it.key().begin(), it.key().end());
+            keys_writer.write_cbor(entry);
+        }
+
+        std::sort(lookup.begin(), lookup.end());
+        auto table = BasicJsonType::array();
+        table.template get_ref<typename BasicJsonType::array_t &>().reserve(lookup.size() * 2);
+        for (auto &l : lookup) {
+            table.push_back(l.first);
+            table.push_back(l.second);
+        }
+        // "lookup" first: cbor_view finds it without skipping over "keys".
+        append_cbor_head(index_cbor, 5, 2);
+        append_cbor_head(index_cbor, 3, 6);
+        index_cbor.insert(index_cbor.end(), {'l', 'o', 'o', 'k', 'u', 'p'});
+        index_writer.write_cbor(table);
+        append_cbor_head(index_cbor, 3, 4);
+        index_cbor.insert(index_cbor.end(), {'k', 'e', 'y', 's'});
+        index_cbor.insert(index_cbor.end(), keys.begin(), keys.end());
+    } else if (j.is_array()) {
+        auto offsets = write_array(j);
+        if (!offsets.empty()) {
+            index["chunk"] = chunk;
+            index["offsets"] = std::move(offsets);
+        }
+        index_writer.write_cbor(index);
+    } else {
+        writer.write_cbor(j);
+        index_writer.write_cbor(index);
+    }
+
+    std::vector<std::uint8_t> result;
+    result.reserve(16 + index_cbor.size() + data.size());
+    append_cbor_head(result, 6, nlohmann::detail::cbor_index_tag);
+    append_cbor_head(result, 4, 2);
+    append_cbor_head(result, 2, index_cbor.size());
+    result.insert(result.end(), index_cbor.begin(), index_cbor.end());
+    result.insert(result.end(), data.begin(), data.end());
+    return result;
+}
+
+// output for binary_writer which only counts the bytes.
+class byte_counter
+{
+public:
+    void write_character(std::uint8_t) { count++; }
+    void write_characters(const std::uint8_t *, std::size_t length) { count += length; }
+
+    std::size_t size() const { return count; }
+
+private:
+    std::size_t count = 0;
+};
+
+// output for binary_writer storing into a buffer of the exact size. (see cbor_size)
+class memory_writer
+{
+public:
+    memory_writer(std::uint8_t *data, std::size_t size) : cur(data), end(data + size) {}
+
+    // nothing is written past the end. (see complete())
+    void write_character(std::uint8_t c)
+    {
+        if (cur == end) {
+            overflow = true;
+            return;
+        }
+        *cur++ = c;
+    }
+
+    void write_characters(const std::uint8_t *s, std::size_t length)
+    {
+        if (length > remaining()) {
+            overflow = true;
+            return;
+        }
+        if (length == 0) return;
+        std::memcpy(cur, s, length);
+        cur += length;
+    }
+
+    std::size_t remaining() const { return static_cast<std::size_t>(end - cur); }
+
+    // whether exactly size bytes were written. (false: the data changed after cbor_size(), the output is broken)
+    bool complete() const { return !overflow && remaining() == 0; }
+
+private:
+    std::uint8_t *cur;
+    std::uint8_t *end;
+    bool overflow = false;
+};
+
+// write CBOR of j to output (byte_counter *, memory_writer *) with binary_writer.
+// the output is called directly, not through the virtual output_adapter_protocol.
+template<typename BasicJsonType, typename OutputType>
+void write_cbor_with(const BasicJsonType &j, const cbor_write_options &opt, OutputType *output)
+{
+    nlohmann::detail::binary_writer<BasicJsonType, std::uint8_t, OutputType *> writer{output};
+    writer.set_cbor_float16_tolerance(opt.float16_tolerance);
+    writer.set_cbor_typed_arrays(opt.typed_arrays);
+    writer.write_cbor(j);
+}
+
+// exact size of to_cbor(j, opt). (opt.indexed is ignored)
+template<typename BasicJsonType>
+std::size_t cbor_size(const BasicJsonType &j, const cbor_write_options &opt)
+{
+    byte_counter counter;
+    write_cbor_with(j, opt, &counter);
+    return counter.size();
+}
+
+// njson::to_cbor() with options.
+template<typename BasicJsonType>
+std::vector<std::uint8_t> to_cbor(const BasicJsonType &j, const cbor_write_options &opt)
+{
+    if (opt.indexed) return to_cbor_indexed(j, opt);
+
+    // size first, then store into the buffer without growing it.
+    std::vector<std::uint8_t> result(cbor_size(j, opt));
+    memory_writer writer(result.data(), result.size());
+    write_cbor_with(j, opt, &writer);
+    if (!writer.complete()) {
+        // the size was wrong: encode again into a growing buffer.
+        result.clear();
+        nlohmann::detail::binary_writer<BasicJsonType, std::uint8_t> vec_writer{nlohmann::detail::output_adapter<std::uint8_t>(result)};
+        vec_writer.set_cbor_float16_tolerance(opt.float16_tolerance);
+        vec_writer.set_cbor_typed_arrays(opt.typed_arrays);
+        vec_writer.write_cbor(j);
+    }
+    return result;
+}
+
+// write CBOR of j to a file. (same bytes as to_cbor)
+// the file is sized and mapped, and the CBOR is stored straight into the mapping,
+// so the encoded data is never held in memory besides the DOM.
+template<typename BasicJsonType>
+void write_cbor(output_file &out, const BasicJsonType &j, const cbor_write_options &opt)
+{
+    if (opt.indexed) {
+        auto cbor = to_cbor_indexed(j, opt);
+        out.write(cbor.data(), cbor.size());
+        return;
+    }
+
+    auto size = cbor_size(j, opt);
+    if (auto *p = out.map(size)) {
+        memory_writer writer(p, size);
+        write_cbor_with(j, opt, &writer);
+        if (!writer.complete()) out.discard();  // close() reports the failure.
+        return;
+    }
+
+    auto oa = out.adapter();
+    nlohmann::detail::binary_writer<BasicJsonType, char> writer{oa};
+    writer.set_cbor_float16_tolerance(opt.float16_tolerance);
+    writer.set_cbor_typed_arrays(opt.typed_arrays);
+    writer.write_cbor(j);
+}
+
+// SAX parse from any nlohmann input adapter. (JSON text or binary format)
+template<typename BasicJsonType, typename InputAdapterType, typename SAX>
+bool sax_parse_input(InputAdapterType &&ia, SAX *sax,
+    nlohmann::detail::input_format_t format = nlohmann::detail::input_format_t::json, bool strict = true)
+{
+    using adapter_t = std::decay_t<InputAdapterType>;
+
+    if (format == nlohmann::detail::input_format_t::json) {
+        return nlohmann::detail::parser<BasicJsonType, adapter_t>(std::move(ia), nullptr, true, false).sax_parse(sax, strict);
+    }
+    return nlohmann::detail::binary_reader<BasicJsonType, adapter_t, SAX>(std::move(ia), format).sax_parse(format, sax, strict);
+}
+
+}
@@ -0,0 +1,468 @@
+/*
+ * Copyright (c) 2024, edgecraft. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "json.hpp"
+
+namespace {
+
+// SAX consumer which writes CBOR while the input is being parsed. (no DOM)
+// containers of unknown size (JSON text) are written as indefinite-length items,
+// so the memory use doesn't depend on the document size.
+template<typename BasicJsonType>
+class cbor_sax_writer
+{
+public:
+    using number_integer_t = typename BasicJsonType::number_integer_t;
+    using number_unsigned_t = typename BasicJsonType::number_unsigned_t;
+    using number_float_t = typename BasicJsonType::number_float_t;
+    using string_t = typename BasicJsonType::string_t;
+    using binary_t = typename BasicJsonType::binary_t;
+
+    // float16_tolerance: floats within this absolute error are written as half floats. (negative: never)
+    explicit cbor_sax_writer(nlohmann::detail::output_adapter_t<char> adapter, bool force_float32 = false, double float16_tolerance = -1.0)
+        : oa(std::move(adapter)), force_float32(force_float32), float16_tolerance(float16_tolerance)
+    {
+        buf.reserve(buf_size);
+    }
+
+    ~cbor_sax_writer() { flush(); }
+
+    cbor_sax_writer(const cbor_sax_writer &) = delete;
+    cbor_sax_writer &operator=(const cbor_sax_writer &) = delete;
+
+    bool null()
+    {
+        put(0xF6);
+        return true;
+    }
+
+    bool boolean(bool val)
+    {
+        put(val ? 0xF5 : 0xF4);
+        return true;
+    }
+
+    bool number_integer(number_integer_t val)
+    {
+        if (val >= 0) {
+            write_head(0x00, static_cast<std::uint64_t>(val));
+        } else {
+            write_head(0x20, static_cast<std::uint64_t>(-1 - val));
+        }
+        return true;
+    }
+
+    bool number_unsigned(number_unsigned_t val)
+    {
+        write_head(0x00, static_cast<std::uint64_t>(val));
+        return true;
+    }
+
+    bool number_float(number_float_t val, const string_t & /*unused*/)
+    {
+        if (force_float32) val = static_cast<number_float_t>(static_cast<float>(val));
+        write_float(static_cast<double>(val));
+        return true;
+    }
+
+    bool string(string_t &val)
+    {
+        write_head(0x60, val.size());
+        put(val.data(), val.size());
+        return true;
+    }
+
+    bool binary(binary_t &val)
+    {
+        if (val.has_subtype()) write_head(0xC0, val.subtype());
+        write_head(0x40, val.size());
+        put(reinterpret_cast<const char *>(val.data()), val.size());
+        return true;
+    }
+
+    bool start_object(std::size_t len)
+    {
+        if (len == static_cast<std::size_t>(-1)) {
+            put(0xBF);
+        } else {
+            write_head(0xA0, len);
+        }
+        indefinite.push_back(len == static_cast<std::size_t>(-1));
+        return true;
+    }
+
+    bool key(string_t &val)
+    {
+        return string(val);
+    }
+
+    bool end_object()
+    {
+        return end_container();
+    }
+
+    bool start_array(std::size_t len)
+    {
+        if (len == static_cast<std::size_t>(-1)) {
+            put(0x9F);
+        } else {
+            write_head(0x80, len);
+        }
+        indefinite.push_back(len == static_cast<std::size_t>(-1));
+        return true;
+    }
+
+    bool end_array()
+    {
+        return end_container();
+    }
+
+    bool parse_error(std::size_t /*unused*/, const std::string & /*unused*/, const nlohmann::detail::exception &ex)
+    {
+        error_message = ex.what();
+        return false;
+    }
+
+    // write the buffered bytes to the output adapter.
+    void flush()
+    {
+        if (buf.empty()) return;
+        oa->write_characters(buf.data(), buf.size());
+        buf.clear();
+    }
+
+    const std::string &get_error() const { return error_message; }
+
+private:
+    static constexpr std::size_t buf_size = 64 * 1024;
+
+    void put(std::uint8_t c)
+    {
+        buf.push_back(static_cast<char>(c));
+        if (buf.size() >= buf_size) flush();
+    }
+
+    void put(const char *s, std::size_t len)
+    {
+        if (buf.size() + len > buf_size) {
+            flush();
+            if (len >= buf_size) {
+                oa->write_characters(s, len);
+                return;
+            }
+        }
+        buf.insert(buf.end(), s, s + len);
+    }
+
+    template<typename T> void put_be(T val)
+    {
+        char tmp[sizeof(T)];
+        for (std::size_t i = 0; i < sizeof(T); i++) {
+            tmp[i] = static_cast<char>(static_cast<std::uint64_t>(val) >> (8 * (sizeof(T) - 1 - i)));
+        }
+        put(tmp, sizeof(T));
+    }
+
+    // initial byte and argument, same widths as binary_writer::write_cbor().
+    void write_head(std::uint8_t major, std::uint64_t val)
+    {
+        if (val <= 0x17) {
+            put(static_cast<std::uint8_t>(major + val));
+        } else if (val <= (std::numeric_limits<std::uint8_t>::max)()) {
+            put(static_cast<std::uint8_t>(major + 0x18));
+            put_be(static_cast<std::uint8_t>(val));
+        } else if (val <= (std::numeric_limits<std::uint16_t>::max)()) {
+            put(static_cast<std::uint8_t>(major + 0x19));
+            put_be(static_cast<std::uint16_t>(val));
+        } else if (val <= (std::numeric_limits<std::uint32_t>::max)()) {
+            put(static_cast<std::uint8_t>(major + 0x1A));
+            put_be(static_cast<std::uint32_t>(val));
+        } else {
+            put(static_cast<std::uint8_t>(major + 0x1B));
+            put_be(static_cast<std::uint64_t>(val));
+        }
+    }
+
+    // same rule as binary_writer::write_compact_float() and set_cbor_float16_tolerance().
+    void write_float(double val)
+    {
+        if (std::isnan(val)) {
+            put(0xF9); put(0x7E); put(0x00);
+        } else if (std::isinf(val)) {
+            put(0xF9); put(val > 0 ? 0x7C : 0xFC); put(0x00);
+        } else if (float16_tolerance >= 0 && std::abs(val) < 65520.0 && write_half(val)) {
+            return;
+        } else if (val >= static_cast<double>(std::numeric_limits<float>::lowest())
+            && val <= static_cast<double>((std::numeric_limits<float>::max)())
+            && static_cast<double>(static_cast<float>(val)) == val) {
+            auto f = static_cast<float>(val);
+            std::uint32_t bits;
+            std::memcpy(&bits, &f, sizeof(bits));
+            put(0xFA);
+            put_be(bits);
+        } else {
+            std::uint64_t bits;
+            std::memcpy(&bits, &val, sizeof(bits));
+            put(0xFB);
+            put_be(bits);
+        }
+    }
+
+    bool write_half(double val)
+    {
+        auto h = nlohmann::detail::half_float::from_float(static_cast<float>(val));
+        if (std::abs(static_cast<double>(nlohmann::detail::half_float::to_float(h)) - val) > float16_tolerance) return false;
+        put(0xF9);
+        put_be(h);
+        return true;
+    }
+
+    bool end_container()
+    {
+        if (indefinite.back()) put(0xFF);
+        indefinite.pop_back();
+        return true;
+    }
+
+    nlohmann::detail::output_adapter_t<char> oa;
+    bool force_float32 = false;
+    double float16_tolerance = -1.0;
+    std::string buf;
+    std::vector<bool> indefinite;
+    std::string error_message;
+};
+
+// SAX consumer which writes JSON text while the input (CBOR etc.) is being parsed. (no DOM)
+// the output is the same as `ofs << std::setw(indent) << json` if the keys of every object are sorted and unique.
+// otherwise the keys are written in the input order and duplicates are kept, while njson sorts them and keeps the last one.
+// scalars are written by the nlohmann serializer, so escaping and number format are identical.
+template<typename BasicJsonType>
+class json_sax_writer
+{
+public:
+    using number_integer_t = typename BasicJsonType::number_integer_t;
+    using number_unsigned_t = typename BasicJsonType::number_unsigned_t;
+    using number_float_t = typename BasicJsonType::number_float_t;
+    using string_t = typename BasicJsonType::string_t;
+    using binary_t = typename BasicJsonType::binary_t;
+
+    // indent < 0 : compact output.
+    explicit json_sax_writer(nlohmann::detail::output_adapter_t<char> adapter, int indent = -1, char indent_char = ' ')
+        : oa(adapter), s(adapter, indent_char),
+          pretty_print(indent >= 0), indent_step(indent >= 0 ? static_cast<unsigned int>(indent) : 0),
+          indent_string(512, indent_char), str_val(string_t{})
+    {}
+
+    json_sax_writer(const json_sax_writer &) = delete;
+    json_sax_writer &operator=(const json_sax_writer &) = delete;
+
+    // print floats exact in single precision as floats. (0.1f: "0.1", see serializer::set_float32_output)
+    void set_float32_output(bool enable) { s.set_float32_output(enable); }
+
+    bool null()
+    {
+        before_value();
+        oa->write_characters("null", 4);
+        return true;
+    }
+
+    bool boolean(bool val)
+    {
+        before_value();
+        if (val) {
+            oa->write_characters("true", 4);
+        } else {
+            oa->write_characters("false", 5);
+        }
+        return true;
+    }
+
+    bool number_integer(number_integer_t val)
+    {
+        before_value();
+        num_val = val;
+        s.dump(num_val, pretty_print, false, indent_step);
+        return true;
+    }
+
+    bool number_unsigned(number_unsigned_t val)
+    {
+        before_value();
+        num_val = val;
+        s.dump(num_val, pretty_print, false, indent_step);
+        return true;
+    }
+
+    bool number_float(number_float_t val, const string_t & /*unused*/)
+    {
+        before_value();
+        num_val = val;
+        s.dump(num_val, pretty_print, false, indent_step);
+        return true;
+    }
+
+    bool string(string_t &val)
+    {
+        before_value();
+        dump_string(val);
+        return true;
+    }
+
+    bool binary(binary_t &val)
+    {
+        before_value();
+        BasicJsonType j = BasicJsonType::binary(std::move(val));
+        s.dump(j, pretty_print, false, indent_step, current_indent());
+        return true;
+    }
+
+    bool start_object(std::size_t /*unused*/)
+    {
+        before_value();
+        oa->write_character('{');
+        stack.push_back({true, 0});
+        return true;
+    }
+
+    bool key(string_t &val)
+    {
+        separator();
+        dump_string(val);
+        if (pretty_print) {
+            oa->write_characters(": ", 2);
+        } else {
+            oa->write_character(':');
+        }
+        return true;
+    }
+
+    bool end_object()
+    {
+        end_container('}');
+        return true;
+    }
+
+    bool start_array(std::size_t /*unused*/)
+    {
+        before_value();
+        oa->write_character('[');
+        stack.push_back({false, 0});
+        return true;
+    }
+
+    bool end_array()
+    {
+        end_container(']');
+        return true;
+    }
+
+    bool parse_error(std::size_t /*unused*/, const std::string & /*unused*/, const nlohmann::detail::exception &ex)
+    {
+        error_message = ex.what();
+        return false;
+    }
+
+    const std::string &get_error() const { return error_message; }
+
+private:
+    struct container
+    {
+        bool is_object;
+        std::size_t count;
+    };
+
+    unsigned int current_indent() const
+    {
+        return static_cast<unsigned int>(stack.size()) * indent_step;
+    }
+
+    void write_indent(unsigned int n)
+    {
+        if (indent_string.size() < n) indent_string.resize(n * 2, indent_string[0]);
+        oa->write_characters(indent_string.c_str(), n);
+    }
+
+    // ",\n" + indent before every array element and object member.
+    void separator()
+    {
+        auto &top = stack.back();
+        if (pretty_print) {
+            if (top.count == 0) {
+                oa->write_character('\n');
+            } else {
+                oa->write_characters(",\n", 2);
+            }
+            write_indent(current_indent());
+        } else if (top.count != 0) {
+            oa->write_character(',');
+        }
+        top.count++;
+    }
+
+    // object members got their separator in key().
+    void before_value()
+    {
+        if (!stack.empty() && !stack.back().is_object) separator();
+    }
+
+    void end_container(char c)
+    {
+        auto count = stack.back().count;
+        stack.pop_back();
+        if (pretty_print && count != 0) {
+            oa->write_character('\n');
+            write_indent(current_indent());
+        }
+        oa->write_character(c);
+    }
+
+    // borrow the string buffer, so no allocation per string.
+    void dump_string(string_t &val)
+    {
+        auto &ref = str_val.template get_ref<string_t &>();
+        ref.swap(val);
+        s.dump(str_val, pretty_print, false, indent_step);
+        ref.swap(val);
+    }
+
+    nlohmann::detail::output_adapter_t<char> oa;
+    nlohmann::detail::serializer<BasicJsonType> s;
+    bool pretty_print = false;
+    unsigned int indent_step = 0;
+    std::string indent_string;
+    BasicJsonType num_val;
+    BasicJsonType str_val;
+    std::vector<container> stack;
+    std::string error_message;
+};
+
+}
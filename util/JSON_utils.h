@@ -39,9 +39,22 @@ namespace fs = std::filesystem;
 
 #define JSON_USE_IMPLICIT_CONVERSIONS 0
 #include "json.hpp"
+#include "JSON_io.h"
+#include "JSON_transcoder.h"
+#include "cbor_view.h"
+#include "json_arena.h"
+#include "json_bind.h"
+#include "thread_pool.h"
+
+// ordered JSON type. USE_INDEXED_ORDERED_JSON looks up the keys of large objects by hash.
+#ifdef USE_INDEXED_ORDERED_JSON
+using njson_ordered = nlohmann::indexed_ordered_json;
+#else
+using njson_ordered = nlohmann::ordered_json;
+#endif
 
-#ifdef USE_ORDERED_JSON
-using njson = nlohmann::ordered_json;
+#if defined(USE_ORDERED_JSON) || defined(USE_INDEXED_ORDERED_JSON)
+using njson = njson_ordered;
 #else
 using njson = nlohmann::json;
 #endif
@@ -50,21 +63,23 @@ using njson = nlohmann::json;
 //     friend void to_json(nlohmann::json& nlohmann_json_j, const Type& nlohmann_json_t) { NLOHMANN_JSON_EXPAND(NLOHMANN_JSON_PASTE(NLOHMANN_JSON_TO, __VA_ARGS__)) } \
 //     friend void from_json(const nlohmann::json& nlohmann_json_j, Type& nlohmann_json_t) { NLOHMANN_JSON_EXPAND(NLOHMANN_JSON_PASTE(NLOHMANN_JSON_FROM, __VA_ARGS__)) }
 #define NLOHMANN_DEFINE_TYPE_INTRUSIVE_ORDERED(Type, ...)  \
-    friend void to_json(nlohmann::ordered_json& nlohmann_json_j, const Type& nlohmann_json_t) { NLOHMANN_JSON_EXPAND(NLOHMANN_JSON_PASTE(NLOHMANN_JSON_TO, __VA_ARGS__)) } \
-    friend void from_json(const nlohmann::ordered_json& nlohmann_json_j, Type& nlohmann_json_t) { NLOHMANN_JSON_EXPAND(NLOHMANN_JSON_PASTE(NLOHMANN_JSON_FROM, __VA_ARGS__)) }
+    friend void to_json(njson_ordered& nlohmann_json_j, const Type& nlohmann_json_t) { NLOHMANN_JSON_EXPAND(NLOHMANN_JSON_PASTE(NLOHMANN_JSON_TO, __VA_ARGS__)) } \
+    friend void from_json(const njson_ordered& nlohmann_json_j, Type& nlohmann_json_t) { NLOHMANN_JSON_EXPAND(NLOHMANN_JSON_PASTE(NLOHMANN_JSON_FROM, __VA_ARGS__)) }
 #define NLOHMANN_DEFINE_TYPE_INTRUSIVE_HYBRID(Type, ...)  \
     NLOHMANN_DEFINE_TYPE_INTRUSIVE(Type, __VA_ARGS__)  \
-    NLOHMANN_DEFINE_TYPE_INTRUSIVE_ORDERED(Type, __VA_ARGS__)
+    NLOHMANN_DEFINE_TYPE_INTRUSIVE_ORDERED(Type, __VA_ARGS__)  \
+    JSON_BIND_MEMBERS_INTRUSIVE(Type, __VA_ARGS__)
 
 // #define NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(Type, ...)  \
 //     inline void to_json(nlohmann::json& nlohmann_json_j, const Type& nlohmann_json_t) { NLOHMANN_JSON_EXPAND(NLOHMANN_JSON_PASTE(NLOHMANN_JSON_TO, __VA_ARGS__)) } \
 //     inline void from_json(const nlohmann::json& nlohmann_json_j, Type& nlohmann_json_t) { NLOHMANN_JSON_EXPAND(NLOHMANN_JSON_PASTE(NLOHMANN_JSON_FROM, __VA_ARGS__)) }
 #define NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_ORDERED(Type, ...)  \
-    inline void to_json(nlohmann::ordered_json& nlohmann_json_j, const Type& nlohmann_json_t) { NLOHMANN_JSON_EXPAND(NLOHMANN_JSON_PASTE(NLOHMANN_JSON_TO, __VA_ARGS__)) } \
-    inline void from_json(const nlohmann::ordered_json& nlohmann_json_j, Type& nlohmann_json_t) { NLOHMANN_JSON_EXPAND(NLOHMANN_JSON_PASTE(NLOHMANN_JSON_FROM, __VA_ARGS__)) }
+    inline void to_json(njson_ordered& nlohmann_json_j, const Type& nlohmann_json_t) { NLOHMANN_JSON_EXPAND(NLOHMANN_JSON_PASTE(NLOHMANN_JSON_TO, __VA_ARGS__)) } \
+    inline void from_json(const njson_ordered& nlohmann_json_j, Type& nlohmann_json_t) { NLOHMANN_JSON_EXPAND(NLOHMANN_JSON_PASTE(NLOHMANN_JSON_FROM, __VA_ARGS__)) }
 #define NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_HYBRID(Type, ...)  \
     NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(Type, __VA_ARGS__)  \
-    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_ORDERED(Type, __VA_ARGS__)
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_ORDERED(Type, __VA_ARGS__)  \
+    JSON_BIND_MEMBERS_NON_INTRUSIVE(Type, __VA_ARGS__)
 
 namespace {
 
@@ -88,33 +103,69 @@ namespace {
 // })
 
 
+// convert an element of a numeric array.
+// numbers are cast directly, anything else goes through get() for the usual type_error.
+template<typename T> T json_get_number(const njson &e)
+{
+    switch (e.type()) {
+    case nlohmann::detail::value_t::number_integer: return static_cast<T>(*e.template get_ptr<const njson::number_integer_t *>());
+    case nlohmann::detail::value_t::number_unsigned: return static_cast<T>(*e.template get_ptr<const njson::number_unsigned_t *>());
+    case nlohmann::detail::value_t::number_float: return static_cast<T>(*e.template get_ptr<const njson::number_float_t *>());
+    default: return e.template get<T>();
+    }
+}
+
 // get value from json.
+// std::optional is reset by null, and left as it is when the key is missing.
 inline auto json_get_val = [](const njson &j, const std::string &key, auto &val) -> void {
+    using T = std::remove_reference_t<decltype(val)>;
     auto it = j.find(key);
-    if (it != j.end()) {
-        njson j_tmp = it.value();
-        val = j_tmp.template get<std::remove_reference_t<decltype(val)>>();
+    if (it == j.end()) return;
+
+    if constexpr (json_bind_is_optional<T>::value) {
+        if (it->is_null()) {
+            val.reset();
+        } else {
+            val = it->template get<typename T::value_type>();
+        }
+    } else {
+        it->get_to(val);
     }
 };
 
 // get arrayed value from json.
 inline auto json_get_array_val = [](const njson &j, const std::string &key, auto &ary) -> void {
-    njson j_sub;
-    json_get_val(j, key, j_sub);
-    auto i = 0;
-    for (auto &e : j_sub) {
-        if (i >= std::size(ary)) break;
-        ary[i] = j_sub.at(i).template get<std::remove_reference_t<decltype(ary[0])>>();
-        i++;
+    using T = std::remove_const_t<std::remove_reference_t<decltype(ary[0])>>;
+    auto it = j.find(key);
+    if (it == j.end()) return;
+
+    const auto &j_sub = *it;
+    auto n = std::min<std::size_t>(std::size(ary), j_sub.size());
+    for (std::size_t i = 0; i < n; i++) {
+        if constexpr (std::is_arithmetic<T>::value && !std::is_same<T, bool>::value) {
+            ary[i] = json_get_number<T>(j_sub.at(i));
+        } else {
+            ary[i] = j_sub.at(i).template get<T>();
+        }
     }
 };
 
 // get vector value from json.
 inline auto json_get_vector_val = [](const njson &j, const std::string &key, auto &vec) -> void {
-    njson j_sub;
-    json_get_val(j, key, j_sub);
+    using T = typename std::remove_reference_t<decltype(vec)>::value_type;
     vec.clear();
-    for (auto &e : j_sub) vec.push_back(e.template get<std::remove_reference_t<decltype(vec[0])>>());
+    auto it = j.find(key);
+    if (it == j.end()) return;
+
+    const auto &j_sub = *it;
+    vec.reserve(j_sub.size());
+    if constexpr (std::is_arithmetic<T>::value && !std::is_same<T, bool>::value) {
+        if (j_sub.is_array()) {
+            for (const auto &e : j_sub.template get_ref<const njson::array_t &>()) vec.push_back(json_get_number<T>(e));
+            return;
+        }
+    }
+    for (const auto &e : j_sub) vec.push_back(e.template get<T>());
 };
 
 // convert enum -> std::string.
@@ -152,22 +203,12 @@ njson read_json_file(const std::string &filename, bool force_float32 = false)
 
     if (ext_str == ".json") {
         std::ifstream ifs(filename);
-
-        njson::parser_callback_t cb = [](int depth, njson::parse_event_t event, njson & parsed) -> bool {
-            if (event == njson::parse_event_t::value and parsed.is_number_float()) {
-                auto val = parsed.get<float>();
-                parsed = val;
-            }
-
-            return true;
-        };
-
         if (!ifs.is_open()) {
             std::cout << "ERROR! can't open JSON file to read : (" << filename << ")" << std::endl;
             return {};
         }
         if (force_float32) {
-            json = njson::parse(ifs, cb);
+            json = parse_json_input<njson>(nlohmann::detail::input_adapter(ifs), true);
         } else {
             ifs >> json;
         }
@@ -192,8 +233,48 @@ njson read_json_file(const std::string &filename, bool force_float32 = false)
     return json;
 }
 
+// read a JSON / DAT file into data without building an njson. (see json_bind_sax)
+// T is a type defined by NLOHMANN_DEFINE_TYPE_*_HYBRID, or a container of them.
+template<typename T> bool read_json_file_to(const std::string &filename, T &data, bool force_float32 = false)
+{
+    auto ext_str = get_extname(filename);
+
+    if (ext_str == ".json") {
+        std::ifstream ifs(filename);
+        if (!ifs.is_open()) {
+            std::cout << "ERROR! can't open JSON file to read : (" << filename << ")" << std::endl;
+            return false;
+        }
+        json_bind_parse<njson>(ifs, data, force_float32);
+
+    } else if (ext_str == ".dat" || ext_str == ".cbor") {
+        std::ifstream ifs(filename, std::ios::binary);
+        if (!ifs.is_open()) {
+            std::cout << "ERROR!! can't open DAT file to read : (" << filename << ")" << std::endl;
+            return false;
+        }
+        auto p = fs::path{filename};
+        auto sz = fs::file_size(p);
+        std::vector<uint8_t> cbor(sz);
+        ifs.read(reinterpret_cast<char *>(cbor.data()), sz);
+        json_bind_from_cbor<njson>(cbor, data);
+
+    } else {
+        std::cout << "ERROR! not support file type to read: " << ext_str << "." << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
 template<typename T> T read_json_file(const std::string &filename, bool force_float32 = false)
 {
+    if constexpr (json_bind_sax<njson>::is_direct<T>) {
+        T data = {};
+        if (read_json_file_to(filename, data, force_float32)) return data;
+        return njson{}.template get<T>();
+    }
+
     njson json = read_json_file(filename, force_float32);
 
     T data = json.template get<T>();
@@ -201,39 +282,238 @@ template<typename T> T read_json_file(const std::string &filename, bool force_fl
     return data;
 }
 
-void write_json_file(const std::string &filename, const njson &json)
+// read a JSON / DAT file into an arena. (see arena_document)
+// the whole document is allocated from a few large blocks, and freed at once.
+// a large read-only config is freed without walking through the nodes.
+inline arena_document read_json_file_arena(const std::string &filename, bool force_float32 = false)
+{
+    arena_document doc;
+
+    auto ext_str = get_extname(filename);
+
+    if (ext_str == ".json") {
+        mapped_file mf;
+        if (mf.open(filename)) {
+            doc.edit([&](njson_arena &j) { j = parse_json_input<njson_arena>(nlohmann::detail::input_adapter(mf.begin(), mf.end()), force_float32); });
+            return doc;
+        }
+        std::ifstream ifs(filename);
+        if (!ifs.is_open()) {
+            std::cout << "ERROR! can't open JSON file to read : (" << filename << ")" << std::endl;
+            return doc;
+        }
+        doc.edit([&](njson_arena &j) { j = parse_json_input<njson_arena>(nlohmann::detail::input_adapter(ifs), force_float32); });
+
+    } else if (ext_str == ".dat" || ext_str == ".cbor") {
+        mapped_file mf;
+        if (mf.open(filename)) {
+            doc.edit([&](njson_arena &j) { j = njson_arena::from_cbor(mf.begin(), mf.end()); });
+            return doc;
+        }
+        std::ifstream ifs(filename, std::ios::binary);
+        if (!ifs.is_open()) {
+            std::cout << "ERROR!! can't open DAT file to read : (" << filename << ")" << std::endl;
+            return doc;
+        }
+        doc.edit([&](njson_arena &j) { j = njson_arena::from_cbor(ifs); });
+
+    } else {
+        std::cout << "ERROR! not support file type to read: " << ext_str << "." << std::endl;
+        return doc;
+    }
+
+    return doc;
+}
+
+// threads reading files for read_json_file_async() / read_json_files().
+inline thread_pool &json_read_pool()
+{
+    static thread_pool pool;
+    return pool;
+}
+
+// read_json_file() on a thread pool. (T: njson or a type to get)
+// call it early to prefetch a file, and get() the future when the data is needed.
+// parse errors are thrown by get().
+template<typename T = njson> std::future<T> read_json_file_async(const std::string &filename, bool force_float32 = false)
+{
+    return json_read_pool().submit([filename, force_float32]() -> T {
+        if constexpr (std::is_same<T, njson>::value) {
+            return read_json_file(filename, force_float32);
+        } else {
+            return read_json_file<T>(filename, force_float32);
+        }
+    });
+}
+
+// read files concurrently. the futures are in the order of filenames.
+template<typename T = njson> std::vector<std::future<T>> read_json_files(const std::vector<std::string> &filenames, bool force_float32 = false)
+{
+    std::vector<std::future<T>> result;
+    result.reserve(filenames.size());
+    for (const auto &filename : filenames) result.push_back(read_json_file_async<T>(filename, force_float32));
+    return result;
+}
+
+// read one item of a JSON / DAT file by JSON pointer. ("/calib/camera0")
+// .dat is not decoded except for the item, and an indexed .dat (cbor_write_options::indexed)
+// seeks to the top-level member without reading the others.
+njson read_json_key(const std::string &filename, const std::string &path)
+{
+    auto ext_str = get_extname(filename);
+
+    if (ext_str == ".json") {
+        njson json = read_json_file(filename);
+        njson::json_pointer ptr(path);
+        if (!json.contains(ptr)) {
+            std::cout << "ERROR! key not found : (" << filename << " " << path << ")" << std::endl;
+            return {};
+        }
+        return json.at(ptr);
+
+    } else if (ext_str == ".dat" || ext_str == ".cbor") {
+        cbor_file file;
+        if (!file.open(filename)) {
+            std::cout << "ERROR!! can't open DAT file to read : (" << filename << ")" << std::endl;
+            return {};
+        }
+        auto view = file.view().find_pointer(path);
+        if (!view.is_valid()) {
+            std::cout << "ERROR! key not found : (" << filename << " " << path << ")" << std::endl;
+            return {};
+        }
+        return view.to_json<njson>();
+
+    } else {
+        std::cout << "ERROR! not support file type to read: " << ext_str << "." << std::endl;
+        return {};
+    }
+}
+
+template<typename T> T read_json_key(const std::string &filename, const std::string &path)
+{
+    njson json = read_json_key(filename, path);
+
+    T data = json.template get<T>();
+
+    return data;
+}
+
+// cbor_opt: [dat] float16 and typed arrays. (see cbor_write_options)
+// file_opt: atomic replacement and fsync. (see file_write_options)
+// returns false if the file couldn't be written.
+bool write_json_file(const std::string &filename, const njson &json, const cbor_write_options &cbor_opt = {}, const file_write_options &file_opt = {})
 {
     auto ext_str = get_extname(filename);
 
     if (ext_str == ".json") {
-        std::ofstream ofs(filename);
-        if (!ofs.is_open()) {
+        output_file out(filename, file_opt);
+        if (!out.is_open()) {
             std::cout << "ERROR! can't open JSON file to write : (" << filename << ")" << std::endl;
-            return;
+            return false;
+        }
+        dump_json(json, out.adapter(), 4);
+        out.write("\n", 1);
+        if (!out.close()) {
+            std::cout << "ERROR! can't write JSON file : (" << filename << ")" << std::endl;
+            return false;
         }
-        ofs << std::setw(4) << json << std::endl;
 
     } else if (ext_str == ".dat" || ext_str == ".cbor") {
-        std::ofstream ofs(filename, std::ios::binary);
-        if (!ofs.is_open()) {
+        output_file out(filename, file_opt);
+        if (!out.is_open()) {
             std::cout << "ERROR!! can't open DAT file to write : (" << filename << ")" << std::endl;
-            return;
+            return false;
+        }
+        write_cbor(out, json, cbor_opt);
+        if (!out.close()) {
+            std::cout << "ERROR!! can't write DAT file : (" << filename << ")" << std::endl;
+            return false;
+        }
+
+    } else {
+        std::cout << "ERROR! not support file type to write : " << ext_str << "." << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+// write data to a JSON / DAT file without building an njson. (see json_bind_writer)
+// the output is the same as write_json_file(filename, njson(data)).
+template<typename T>
+bool write_json_file_from(const std::string &filename, const T &data, double float16_tolerance = -1.0, const file_write_options &file_opt = {})
+{
+    auto ext_str = get_extname(filename);
+
+    if (ext_str == ".json") {
+        output_file out(filename, file_opt);
+        if (!out.is_open()) {
+            std::cout << "ERROR! can't open JSON file to write : (" << filename << ")" << std::endl;
+            return false;
+        }
+        json_sax_writer<njson> sax(out.adapter(), 4);
+        json_bind_write<njson>(data, sax);
+        out.write("\n", 1);
+        if (!out.close()) {
+            std::cout << "ERROR! can't write JSON file : (" << filename << ")" << std::endl;
+            return false;
+        }
+
+    } else if (ext_str == ".dat" || ext_str == ".cbor") {
+        output_file out(filename, file_opt);
+        if (!out.is_open()) {
+            std::cout << "ERROR!! can't open DAT file to write : (" << filename << ")" << std::endl;
+            return false;
+        }
+        cbor_sax_writer<njson> sax(out.adapter(), false, float16_tolerance);
+        json_bind_write<njson>(data, sax);
+        sax.flush();
+        if (!out.close()) {
+            std::cout << "ERROR!! can't write DAT file : (" << filename << ")" << std::endl;
+            return false;
         }
-        auto cbor = njson::to_cbor(json);
-        ofs.write(reinterpret_cast<char *>(cbor.data()), cbor.size());
 
     } else {
         std::cout << "ERROR! not support file type to write : " << ext_str << "." << std::endl;
-        return;
+        return false;
     }
+
+    return true;
 }
 
-template<typename T> void write_json_file(const std::string &filename, const T &data)
+template<typename T>
+bool write_json_file(const std::string &filename, const T &data, const cbor_write_options &cbor_opt = {}, const file_write_options &file_opt = {})
 {
+    // typed arrays and the index need the whole document.
+    if constexpr (json_bind_sax<njson>::is_direct<T>) {
+        if (!cbor_opt.typed_arrays && !cbor_opt.indexed) {
+            return write_json_file_from(filename, data, cbor_opt.float16_tolerance, file_opt);
+        }
+    }
+
     njson json = {};
     json = data;
 
-    write_json_file(filename, json);
+    return write_json_file(filename, json, cbor_opt, file_opt);
+}
+
+// thread writing files for write_json_file_async().
+// the writes are done in order, and the pending ones are finished at exit.
+inline serial_queue &json_write_queue()
+{
+    static serial_queue queue;
+    return queue;
+}
+
+// write_json_file() in the background. data is copied (or moved) into the task,
+// so the caller can go on modifying its own one. the future tells whether the file was written.
+// e.g. checkpoints: write_json_file_async("state.json", state, {}, {true}); (atomic)
+template<typename T>
+std::future<bool> write_json_file_async(const std::string &filename, T data, const cbor_write_options &cbor_opt = {}, const file_write_options &file_opt = {})
+{
+    return json_write_queue().submit(
+        [filename, cbor_opt, file_opt](const T &data) { return write_json_file(filename, data, cbor_opt, file_opt); }, std::move(data));
 }
 
 }
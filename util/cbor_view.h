@@ -0,0 +1,751 @@
+/*
+ * Copyright (c) 2024, edgecraft. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#if __cplusplus >= 202002L && __has_include(<span>)
+#include <span>
+#endif
+
+#include "json.hpp"
+#include "mapped_file.h"
+
+namespace {
+
+// read-only view of one CBOR data item in a buffer. (lazy DOM)
+// nothing is decoded until it is asked for, and nothing is allocated:
+// find() / operator[] skip over the other items, strings are std::string_view into the buffer.
+// the buffer must outlive the views.
+//
+// tags are skipped, except RFC 8746 typed arrays which are viewed as arrays of numbers.
+// a missing key or index gives an invalid view. (is_valid() == false, type() == discarded)
+class cbor_view
+{
+public:
+    using value_t = nlohmann::detail::value_t;
+
+    class iterator;
+
+    cbor_view() = default;
+    cbor_view(const uint8_t *data, std::size_t size) : base(data), p(data), end_(data + size)
+    {
+        if (size == 0) p = nullptr;
+    }
+#if __cplusplus >= 202002L && __has_include(<span>)
+    explicit cbor_view(std::span<const uint8_t> data) : cbor_view(data.data(), data.size()) {}
+#endif
+
+    bool is_valid() const { return p != nullptr; }
+
+    value_t type() const
+    {
+        if (p == nullptr) return value_t::discarded;
+        if (element_tag != 0) {
+            if (element_tag & 0x10) return value_t::number_float;
+            return (element_tag & 0x08) ? value_t::number_integer : value_t::number_unsigned;
+        }
+
+        auto h = read_head(content());
+        switch (h.major) {
+        case 0: return value_t::number_unsigned;
+        case 1: return value_t::number_integer;
+        case 2: return value_t::binary;
+        case 3: return value_t::string;
+        case 4: return value_t::array;
+        case 5: return value_t::object;
+        case 6: return value_t::array;  // typed array. (content() skips the other tags)
+        default:
+            if (h.info == 20 || h.info == 21) return value_t::boolean;
+            if (h.info == 22) return value_t::null;
+            if (h.info >= 25 && h.info <= 27) return value_t::number_float;
+            return value_t::discarded;
+        }
+    }
+
+    bool is_null() const { return type() == value_t::null; }
+    bool is_boolean() const { return type() == value_t::boolean; }
+    bool is_number() const { auto t = type(); return t == value_t::number_integer || t == value_t::number_unsigned || t == value_t::number_float; }
+    bool is_number_integer() const { auto t = type(); return t == value_t::number_integer || t == value_t::number_unsigned; }
+    bool is_number_float() const { return type() == value_t::number_float; }
+    bool is_string() const { return type() == value_t::string; }
+    bool is_binary() const { return type() == value_t::binary; }
+    bool is_array() const { return type() == value_t::array; }
+    bool is_object() const { return type() == value_t::object; }
+
+    // number of elements of an array or object. (null: 0, others: 1, like njson::size())
+    std::size_t size() const;
+
+    bool empty() const { return size() == 0; }
+
+    // value of the key, or an invalid view.
+    cbor_view find(std::string_view key) const;
+
+    bool contains(std::string_view key) const { return find(key).is_valid(); }
+
+    cbor_view operator[](std::string_view key) const { return find(key); }
+    cbor_view operator[](const char *key) const { return find(key); }
+
+    // element of an array, or an invalid view.
+    template<typename T, std::enable_if_t<std::is_integral_v<T>, int> = 0>
+    cbor_view operator[](T idx) const { return element(static_cast<std::size_t>(idx)); }
+
+    cbor_view at(std::string_view key) const
+    {
+        auto v = find(key);
+        if (!v.is_valid()) {
+            if (!is_object()) throw nlohmann::detail::type_error::create(304, std::string("cannot use at() with ") + type_name(), nullptr);
+            throw nlohmann::detail::out_of_range::create(403, std::string("key '") + std::string(key) + "' not found", nullptr);
+        }
+        return v;
+    }
+
+    template<typename T, std::enable_if_t<std::is_integral_v<T>, int> = 0>
+    cbor_view at(T idx) const
+    {
+        auto v = element(static_cast<std::size_t>(idx));
+        if (!v.is_valid()) {
+            if (!is_array()) throw nlohmann::detail::type_error::create(304, std::string("cannot use at() with ") + type_name(), nullptr);
+            throw nlohmann::detail::out_of_range::create(401, "array index " + std::to_string(idx) + " is out of range", nullptr);
+        }
+        return v;
+    }
+
+    // value at a JSON pointer ("/a/0/b"), or an invalid view.
+    cbor_view find_pointer(std::string_view ptr) const;
+
+    // the index of an indexed document (see to_cbor_indexed), or an invalid view.
+    cbor_view index() const
+    {
+        if (p == nullptr || element_tag != 0) return {};
+        auto h = read_head(p);
+        if (h.major != 6 || h.arg != nlohmann::detail::cbor_index_tag) return {};
+        auto a = read_head(h.next);
+        auto b = read_head(a.next);
+        if (a.major != 4 || a.arg != 2 || b.major != 2 || b.indefinite) error(h.next, "invalid indexed document");
+        check_payload(b);
+        return {base, b.next, b.next + b.arg};
+    }
+
+    // bool, numbers, std::string_view, std::string, njson, or anything njson converts to. (through to_json())
+    template<typename T> T get() const
+    {
+        if constexpr (std::is_same_v<T, bool>) {
+            if (!is_boolean()) throw type_error("boolean");
+            return read_head(content()).info == 21;
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            return get_number<T>();
+        } else if constexpr (std::is_same_v<T, std::string_view>) {
+            auto h = string_head();
+            if (h.indefinite) throw nlohmann::detail::type_error::create(302, "indefinite-length string can't be a string_view", nullptr);
+            check_payload(h);
+            return {reinterpret_cast<const char *>(h.next), static_cast<std::size_t>(h.arg)};
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            auto h = string_head();
+            std::string str;
+            append_string(h, str);
+            return str;
+        } else if constexpr (nlohmann::detail::is_basic_json<T>::value) {
+            return to_json<T>();
+        } else {
+            return to_json().template get<T>();
+        }
+    }
+
+    template<typename T> void get_to(T &val) const { val = get<T>(); }
+
+    // the item decoded into an njson. (the only function that builds a DOM)
+    template<typename BasicJsonType = nlohmann::json> BasicJsonType to_json() const
+    {
+        if (p == nullptr) return BasicJsonType(value_t::discarded);
+        if (element_tag != 0) {
+            switch (type()) {
+            case value_t::number_float: return get<typename BasicJsonType::number_float_t>();
+            case value_t::number_integer: return get<typename BasicJsonType::number_integer_t>();
+            default: return get<typename BasicJsonType::number_unsigned_t>();
+            }
+        }
+        return BasicJsonType::from_cbor(p, skip(p), true, true, BasicJsonType::cbor_tag_handler_t::ignore);
+    }
+
+    // the encoded bytes of the item.
+    const uint8_t *data() const { return p; }
+    std::size_t byte_size() const
+    {
+        if (p == nullptr) return 0;
+        return (element_tag != 0) ? typed_element_size(element_tag) : static_cast<std::size_t>(skip(p) - p);
+    }
+
+    const char *type_name() const
+    {
+        switch (type()) {
+        case value_t::null: return "null";
+        case value_t::object: return "object";
+        case value_t::array: return "array";
+        case value_t::string: return "string";
+        case value_t::boolean: return "boolean";
+        case value_t::binary: return "binary";
+        case value_t::discarded: return "discarded";
+        default: return "number";
+        }
+    }
+
+    iterator begin() const;
+    iterator end() const;
+
+private:
+    struct head
+    {
+        uint8_t major = 0;
+        uint8_t info = 0;
+        uint64_t arg = 0;
+        bool indefinite = false;
+        const uint8_t *next = nullptr;
+    };
+
+    cbor_view element(std::size_t idx) const;
+
+    cbor_view(const uint8_t *base, const uint8_t *p, const uint8_t *end, uint8_t element_tag = 0)
+        : base(base), p(p), end_(end), element_tag(element_tag)
+    {}
+
+    [[noreturn]] void error(const uint8_t *at, const std::string &msg) const
+    {
+        throw nlohmann::detail::parse_error::create(110, static_cast<std::size_t>(at - base) + 1,
+            "syntax error while parsing CBOR view: " + msg, nullptr);
+    }
+
+    nlohmann::detail::type_error type_error(const char *expected) const
+    {
+        return nlohmann::detail::type_error::create(302, std::string("type must be ") + expected + ", but is " + type_name(), nullptr);
+    }
+
+    head read_head(const uint8_t *q) const
+    {
+        if (q >= end_) error(q, "unexpected end of input");
+
+        head h;
+        h.major = static_cast<uint8_t>(*q >> 5);
+        h.info = static_cast<uint8_t>(*q & 0x1F);
+        q++;
+        if (h.info < 24) {
+            h.arg = h.info;
+        } else if (h.info <= 27) {
+            auto n = std::size_t(1) << (h.info - 24);
+            if (static_cast<std::size_t>(end_ - q) < n) error(q, "unexpected end of input");
+            for (std::size_t i = 0; i < n; i++) h.arg = (h.arg << 8) | q[i];
+            q += n;
+        } else if (h.info == 31 && h.major >= 2 && h.major <= 5) {
+            h.indefinite = true;
+        } else if (!(h.info == 31 && h.major == 7)) {
+            error(q - 1, "invalid byte");
+        }
+        h.next = q;
+        return h;
+    }
+
+    // the payload of a definite-length string must be in the buffer.
+    void check_payload(const head &h) const
+    {
+        if (static_cast<uint64_t>(end_ - h.next) < h.arg) error(h.next, "unexpected end of input");
+    }
+
+    // the end of the item at q.
+    const uint8_t *skip(const uint8_t *q) const
+    {
+        auto h = read_head(q);
+        switch (h.major) {
+        case 2:
+        case 3:
+            if (h.indefinite) {
+                q = h.next;
+                while (q < end_ && *q != 0xFF) q = skip(q);
+                if (q >= end_) error(q, "unexpected end of input");
+                return q + 1;
+            }
+            check_payload(h);
+            return h.next + h.arg;
+        case 4:
+        case 5:
+            {
+                q = h.next;
+                if (h.indefinite) {
+                    while (q < end_ && *q != 0xFF) q = skip(q);
+                    if (q >= end_) error(q, "unexpected end of input");
+                    return q + 1;
+                }
+                auto n = (h.major == 5) ? h.arg * 2 : h.arg;
+                for (uint64_t i = 0; i < n; i++) q = skip(q);
+                return q;
+            }
+        case 6:
+            return skip(h.next);
+        default:
+            return h.next;
+        }
+    }
+
+    static bool is_typed_array_tag(uint64_t tag)
+    {
+        return tag >= 64 && tag <= 86 && tag != 76 && tag != 83;
+    }
+
+    static std::size_t typed_element_size(uint8_t tag)
+    {
+        return (tag & 0x10) ? (std::size_t(2) << (tag & 0x03)) : (std::size_t(1) << (tag & 0x03));
+    }
+
+    // the item without its tags. (typed arrays keep the tag, indexed documents are the document)
+    const uint8_t *content() const
+    {
+        auto q = p;
+        for (;;) {
+            auto h = read_head(q);
+            if (h.major != 6) return q;
+            if (is_typed_array_tag(h.arg) && read_head(h.next).major == 2 && !read_head(h.next).indefinite) return q;
+            if (h.arg == nlohmann::detail::cbor_index_tag) {
+                auto a = read_head(h.next);
+                if (a.major == 4 && a.arg == 2) {
+                    q = skip(a.next);
+                    continue;
+                }
+            }
+            q = h.next;
+        }
+    }
+
+    // the item an index entry [offset, size(, chunk, offsets)] points to. (offsets from origin)
+    cbor_view indexed_item(const cbor_view &entry, const uint8_t *origin) const
+    {
+        auto offset = entry[0].get<uint64_t>();
+        if (offset >= static_cast<uint64_t>(end_ - origin)) error(origin, "invalid index");
+
+        cbor_view v{base, origin + offset, end_};
+        if (entry.size() >= 4) {
+            v.chunk_size = entry[2].get<std::size_t>();
+            v.chunk_offsets = entry[3].p;
+            v.chunk_origin = origin;
+        }
+        return v;
+    }
+
+    // the entry of key by the sorted hash table of the index. (see to_cbor_indexed)
+    cbor_view lookup_entry(const cbor_view &keys, const cbor_view &lookup, std::string_view key) const
+    {
+        auto hash = nlohmann::detail::cbor_index_hash(key.data(), key.size());
+        std::size_t lo = 0;
+        std::size_t hi = lookup.size() / 2;
+        while (lo < hi) {
+            auto mid = lo + (hi - lo) / 2;
+            if (lookup[2 * mid].get<uint64_t>() < hash) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        for (; lo < lookup.size() / 2 && lookup[2 * lo].get<uint64_t>() == hash; lo++) {
+            auto pos = lookup[2 * lo + 1].get<uint64_t>();
+            if (pos >= static_cast<uint64_t>(keys.end_ - keys.p)) error(keys.p, "invalid index");
+            cbor_view k{base, keys.p + pos, keys.end_};
+            if (!k.is_string()) error(k.p, "invalid index");
+            auto h = k.read_head(k.content());
+            if (h.indefinite) error(k.p, "invalid index");
+            k.check_payload(h);
+            if (key == std::string_view{reinterpret_cast<const char *>(h.next), static_cast<std::size_t>(h.arg)}) {
+                return {base, h.next + h.arg, keys.end_};
+            }
+        }
+        return {};
+    }
+
+    std::size_t typed_array_size() const
+    {
+        auto h = read_head(content());
+        auto bytes = read_head(h.next);
+        check_payload(bytes);
+        return static_cast<std::size_t>(bytes.arg) / typed_element_size(static_cast<uint8_t>(h.arg));
+    }
+
+    cbor_view typed_array_element(std::size_t idx) const
+    {
+        auto h = read_head(content());
+        auto bytes = read_head(h.next);
+        check_payload(bytes);
+        auto tag = static_cast<uint8_t>(h.arg);
+        auto q = bytes.next + idx * typed_element_size(tag);
+        return {base, q, end_, tag};
+    }
+
+    head string_head() const
+    {
+        if (!is_string()) throw type_error("string");
+        return read_head(content());
+    }
+
+    void append_string(const head &h, std::string &str) const
+    {
+        if (!h.indefinite) {
+            check_payload(h);
+            str.append(reinterpret_cast<const char *>(h.next), static_cast<std::size_t>(h.arg));
+            return;
+        }
+        for (auto q = h.next;; q = skip(q)) {
+            if (q >= end_) error(q, "unexpected end of input");
+            if (*q == 0xFF) break;
+            auto chunk = read_head(q);
+            if (chunk.major != 3 || chunk.indefinite) error(q, "expected a definite-length text string chunk");
+            append_string(chunk, str);
+        }
+    }
+
+    template<typename T> T get_number() const
+    {
+        if (element_tag != 0) return get_typed_element<T>();
+
+        auto h = read_head(content());
+        switch (h.major) {
+        case 0:
+            return static_cast<T>(h.arg);
+        case 1:
+            return static_cast<T>(static_cast<int64_t>(-1) - static_cast<int64_t>(h.arg));
+        case 7:
+            if (h.info == 25) return static_cast<T>(nlohmann::detail::half_float::to_float(static_cast<uint16_t>(h.arg)));
+            if (h.info == 26) {
+                auto bits = static_cast<uint32_t>(h.arg);
+                float f;
+                std::memcpy(&f, &bits, sizeof(f));
+                return static_cast<T>(f);
+            }
+            if (h.info == 27) {
+                double d;
+                std::memcpy(&d, &h.arg, sizeof(d));
+                return static_cast<T>(d);
+            }
+            break;
+        default:
+            break;
+        }
+        throw type_error("number");
+    }
+
+    template<typename U> U read_typed(bool little) const
+    {
+        std::array<uint8_t, sizeof(U)> vec{};
+        std::memcpy(vec.data(), p, sizeof(U));
+        if (little != nlohmann::detail::little_endianness()) std::reverse(vec.begin(), vec.end());
+        U val;
+        std::memcpy(&val, vec.data(), sizeof(U));
+        return val;
+    }
+
+    template<typename T> T get_typed_element() const
+    {
+        bool little = (element_tag & 0x04) != 0;
+        auto size = typed_element_size(element_tag);
+        if (element_tag & 0x10) {
+            if (size == 2) return static_cast<T>(nlohmann::detail::half_float::to_float(read_typed<uint16_t>(little)));
+            if (size == 4) return static_cast<T>(read_typed<float>(little));
+            return static_cast<T>(read_typed<double>(little));
+        }
+        if (element_tag & 0x08) {
+            if (size == 1) return static_cast<T>(read_typed<int8_t>(little));
+            if (size == 2) return static_cast<T>(read_typed<int16_t>(little));
+            if (size == 4) return static_cast<T>(read_typed<int32_t>(little));
+            return static_cast<T>(read_typed<int64_t>(little));
+        }
+        if (size == 1) return static_cast<T>(read_typed<uint8_t>(little));
+        if (size == 2) return static_cast<T>(read_typed<uint16_t>(little));
+        if (size == 4) return static_cast<T>(read_typed<uint32_t>(little));
+        return static_cast<T>(read_typed<uint64_t>(little));
+    }
+
+    const uint8_t *base = nullptr;
+    const uint8_t *p = nullptr;
+    const uint8_t *end_ = nullptr;
+    uint8_t element_tag = 0;  // typed array element: the tag of the array, p is the raw number.
+
+    // array of an indexed document: offsets of every chunk_size-th element. (from chunk_origin)
+    std::size_t chunk_size = 0;
+    const uint8_t *chunk_offsets = nullptr;
+    const uint8_t *chunk_origin = nullptr;
+};
+
+// iterates the elements of an array, or the key / value pairs of an object.
+// (*it and it.value() are the element or the value, it.key() is the key)
+class cbor_view::iterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = cbor_view;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const cbor_view *;
+    using reference = cbor_view;
+
+    iterator() = default;
+
+    cbor_view operator*() const { return value(); }
+    cbor_view value() const
+    {
+        if (element_tag != 0) return {owner.base, q, owner.end_, element_tag};
+        return {owner.base, is_object ? owner.skip(q) : q, owner.end_};
+    }
+
+    std::string_view key() const
+    {
+        if (!is_object) throw nlohmann::detail::invalid_iterator::create(207, "cannot use key() for non-object iterators", nullptr);
+        return cbor_view{owner.base, q, owner.end_}.get<std::string_view>();
+    }
+
+    iterator &operator++()
+    {
+        if (element_tag != 0) {
+            q += cbor_view::typed_element_size(element_tag);
+        } else {
+            q = owner.skip(q);
+            if (is_object) q = owner.skip(q);
+        }
+        if (!indefinite) remaining--;
+        if (indefinite && q >= owner.end_) owner.error(q, "unexpected end of input");
+        if (indefinite ? (*q == 0xFF) : (remaining == 0)) q = nullptr;
+        return *this;
+    }
+
+    iterator operator++(int)
+    {
+        auto it = *this;
+        ++*this;
+        return it;
+    }
+
+    bool operator==(const iterator &rhs) const { return q == rhs.q; }
+    bool operator!=(const iterator &rhs) const { return q != rhs.q; }
+
+private:
+    friend class cbor_view;
+
+    bool key_equals(std::string_view key) const
+    {
+        cbor_view k{owner.base, q, owner.end_};
+        if (!k.is_string()) return false;
+        auto h = k.read_head(k.content());
+        if (!h.indefinite) {
+            k.check_payload(h);
+            return key == std::string_view{reinterpret_cast<const char *>(h.next), static_cast<std::size_t>(h.arg)};
+        }
+        return key == k.get<std::string>();
+    }
+
+    cbor_view owner;
+    const uint8_t *q = nullptr;  // current item (object: its key), nullptr at the end.
+    uint64_t remaining = 0;
+    bool indefinite = false;
+    bool is_object = false;
+    uint8_t element_tag = 0;
+};
+
+inline cbor_view::iterator cbor_view::begin() const
+{
+    iterator it;
+    auto t = type();
+    if (t != value_t::array && t != value_t::object) return it;
+
+    it.owner = *this;
+    it.is_object = (t == value_t::object);
+    auto h = read_head(content());
+    if (h.major == 6) {
+        auto bytes = read_head(h.next);
+        it.element_tag = static_cast<uint8_t>(h.arg);
+        it.q = bytes.next;
+        it.remaining = typed_array_size();
+    } else {
+        it.q = h.next;
+        it.remaining = h.arg;
+        it.indefinite = h.indefinite;
+    }
+    if (it.indefinite ? (it.q >= end_ || *it.q == 0xFF) : (it.remaining == 0)) it.q = nullptr;
+    return it;
+}
+
+inline cbor_view::iterator cbor_view::end() const
+{
+    return {};
+}
+
+inline std::size_t cbor_view::size() const
+{
+    switch (type()) {
+    case value_t::discarded:
+    case value_t::null:
+        return 0;
+    case value_t::array:
+    case value_t::object:
+        {
+            auto h = read_head(content());
+            if (h.major == 6) return typed_array_size();
+            if (!h.indefinite) return static_cast<std::size_t>(h.arg);
+            std::size_t n = 0;
+            for (auto it = begin(); it != end(); ++it) n++;
+            return n;
+        }
+    default:
+        return 1;
+    }
+}
+
+inline cbor_view cbor_view::find(std::string_view key) const
+{
+    if (!is_object()) return {};
+
+    // indexed document: the index has the offset of the value.
+    if (auto idx = index(); idx.is_valid()) {
+        auto lookup = idx.find("lookup");
+        auto keys = idx.find("keys");
+        if (keys.is_valid()) {
+            auto entry = lookup.is_array() ? lookup_entry(keys, lookup, key) : keys.find(key);
+            return entry.is_valid() ? indexed_item(entry, idx.end_) : cbor_view{};
+        }
+    }
+
+    for (auto it = begin(); it != end(); ++it) {
+        if (it.key_equals(key)) return it.value();
+    }
+    return {};
+}
+
+inline cbor_view cbor_view::element(std::size_t idx) const
+{
+    if (!is_array()) return {};
+    auto h = read_head(content());
+    if (h.major == 6) {
+        if (idx >= typed_array_size()) return {};
+        return typed_array_element(idx);
+    }
+
+    // array with chunk offsets: start from the nearest one.
+    auto chunks = *this;
+    if (chunks.chunk_size == 0) {
+        auto ix = index();
+        if (ix.is_valid() && ix.contains("offsets")) {
+            chunks.chunk_size = ix["chunk"].get<std::size_t>();
+            chunks.chunk_offsets = ix["offsets"].p;
+            chunks.chunk_origin = ix.end_;
+        }
+    }
+    if (chunks.chunk_size != 0 && !h.indefinite) {
+        if (idx >= h.arg) return {};
+        auto offset = cbor_view{base, chunks.chunk_offsets, end_}[idx / chunks.chunk_size].get<uint64_t>();
+        if (offset >= static_cast<uint64_t>(end_ - chunks.chunk_origin)) error(chunks.chunk_origin, "invalid index");
+        auto q = chunks.chunk_origin + offset;
+        for (std::size_t i = 0; i < idx % chunks.chunk_size; i++) q = skip(q);
+        return {base, q, end_};
+    }
+    auto it = begin();
+    for (std::size_t i = 0; i < idx && it != end(); i++) ++it;
+    return (it != end()) ? *it : cbor_view{};
+}
+
+inline cbor_view cbor_view::find_pointer(std::string_view ptr) const
+{
+    if (ptr.empty()) return *this;
+    if (ptr[0] != '/') {
+        throw nlohmann::detail::parse_error::create(107, 1, "JSON pointer must be empty or begin with '/' - was: '" + std::string(ptr) + "'", nullptr);
+    }
+
+    auto v = *this;
+    std::size_t pos = 1;
+    for (;;) {
+        auto next = ptr.find('/', pos);
+        auto raw = ptr.substr(pos, (next == std::string_view::npos) ? std::string_view::npos : next - pos);
+
+        // unescape "~1" -> "/", "~0" -> "~"
+        std::string token;
+        if (raw.find('~') != std::string_view::npos) {
+            for (std::size_t i = 0; i < raw.size(); i++) {
+                if (raw[i] == '~' && i + 1 < raw.size() && (raw[i + 1] == '0' || raw[i + 1] == '1')) {
+                    token += (raw[i + 1] == '0') ? '~' : '/';
+                    i++;
+                } else {
+                    token += raw[i];
+                }
+            }
+            raw = token;
+        }
+
+        if (v.is_object()) {
+            v = v.find(raw);
+        } else if (v.is_array()) {
+            std::size_t idx = 0;
+            auto [end, ec] = std::from_chars(raw.data(), raw.data() + raw.size(), idx);
+            if (raw.empty() || ec != std::errc{} || end != raw.data() + raw.size() || (raw.size() > 1 && raw[0] == '0')) return {};
+            v = v.element(idx);
+        } else {
+            return {};
+        }
+
+        if (!v.is_valid() || next == std::string_view::npos) return v;
+        pos = next + 1;
+    }
+}
+
+// .dat(CBOR) file mapped to memory. (or read, if it can't be mapped)
+// view() is valid while the cbor_file is alive.
+class cbor_file
+{
+public:
+    cbor_file() = default;
+    explicit cbor_file(const std::string &filename) { open(filename); }
+
+    bool open(const std::string &filename)
+    {
+        buf.clear();
+        if (mf.open(filename)) return true;
+
+        std::ifstream ifs(filename, std::ios::binary);
+        if (!ifs.is_open()) return false;
+        buf.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    cbor_view view() const
+    {
+        return mf.is_open() ? cbor_view(mf.data(), mf.size()) : cbor_view(buf.data(), buf.size());
+    }
+
+private:
+    mapped_file mf;
+    std::vector<uint8_t> buf;
+};
+
+}
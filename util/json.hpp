@@ -3430,6 +3430,14 @@ NLOHMANN_JSON_NAMESPACE_END
     /// @sa https://json.nlohmann.me/api/ordered_json/
     using ordered_json = basic_json<nlohmann::ordered_map>;
 
+    /// @brief ordered_map with a hash index for large objects
+    template<class Key, class T, class IgnoredLess, class Allocator>
+    struct indexed_ordered_map;
+
+    /// @brief specialization that maintains the insertion order of object keys,
+    ///        and looks up keys of large objects by hash
+    using indexed_ordered_json = basic_json<nlohmann::indexed_ordered_map>;
+
     NLOHMANN_JSON_NAMESPACE_END
 
 #endif  // INCLUDE_NLOHMANN_JSON_FWD_HPP_
@@ -6274,6 +6282,23 @@ class input_stream_adapter
 };
 #endif  // JSON_NO_IO
 
+// whether the iterator walks over contiguous single-byte storage (pointers,
+// std::string and std::vector iterators)
+// only std::basic_string<char> is named: std::basic_string<unsigned char> needs
+// std::char_traits<unsigned char>, which not every standard library provides
+template<typename IteratorType>
+struct is_contiguous_byte_iterator
+{
+    using value_type = typename std::iterator_traits<IteratorType>::value_type;
+
+    static constexpr bool value = sizeof(value_type) == 1 && (
+                                      std::is_pointer<IteratorType>::value ||
+                                      std::is_same<IteratorType, typename std::string::const_iterator>::value ||
+                                      std::is_same<IteratorType, typename std::string::iterator>::value ||
+                                      std::is_same<IteratorType, typename std::vector<value_type>::const_iterator>::value ||
+                                      std::is_same<IteratorType, typename std::vector<value_type>::iterator>::value);
+};
+
 // General-purpose iterator-based adapter. It might not be as fast as
 // theoretically possible for some containers, but it is extremely versatile.
 template<typename IteratorType>
@@ -6282,6 +6307,9 @@ class iterator_input_adapter
   public:
     using char_type = typename std::iterator_traits<IteratorType>::value_type;
 
+    /// whether the remaining input can be accessed as one memory block
+    static constexpr bool is_contiguous = is_contiguous_byte_iterator<IteratorType>::value;
+
     iterator_input_adapter(IteratorType first, IteratorType last)
         : current(std::move(first)), end(std::move(last))
     {}
@@ -6298,6 +6326,24 @@ class iterator_input_adapter
         return char_traits<char_type>::eof();
     }
 
+    /// number of bytes not read yet
+    std::size_t remaining_size() const
+    {
+        return static_cast<std::size_t>(std::distance(current, end));
+    }
+
+    /// pointer to the bytes not read yet (only for contiguous input, remaining_size() > 0)
+    const char_type* remaining_data() const
+    {
+        return std::addressof(*current);
+    }
+
+    /// consume n bytes at once (n <= remaining_size())
+    void skip(std::size_t n)
+    {
+        std::advance(current, static_cast<typename std::iterator_traits<IteratorType>::difference_type>(n));
+    }
+
   private:
     IteratorType current;
     IteratorType end;
@@ -6782,6 +6828,40 @@ struct json_sax
 
 namespace detail
 {
+template<typename T>
+using reserve_function_t = decltype(std::declval<T&>().reserve(std::declval<std::size_t>()));
+
+/*!
+@brief reserve the storage of an array or an object for @a n elements
+
+Objects are only reserved when the object type can (e.g. ordered_map);
+std::map is left as it is.
+*/
+template<typename ContainerType>
+void reserve_elements(ContainerType& c, std::size_t n, std::true_type /*unused*/)
+{
+    c.reserve(n);
+}
+
+template<typename ContainerType>
+void reserve_elements(ContainerType& /*unused*/, std::size_t /*unused*/, std::false_type /*unused*/) noexcept {}
+
+template<typename BasicJsonType>
+void reserve_elements(BasicJsonType& j, std::size_t n)
+{
+    using array_t = typename BasicJsonType::array_t;
+    using object_t = typename BasicJsonType::object_t;
+
+    if (j.is_array())
+    {
+        reserve_elements(j.template get_ref<array_t&>(), n, is_detected<reserve_function_t, array_t> {});
+    }
+    else if (j.is_object())
+    {
+        reserve_elements(j.template get_ref<object_t&>(), n, is_detected<reserve_function_t, object_t> {});
+    }
+}
+
 /*!
 @brief SAX implementation to create a JSON value from SAX events
 
@@ -6809,9 +6889,11 @@ class json_sax_dom_parser
     @param[in,out] r  reference to a JSON value that is manipulated while
                        parsing
     @param[in] allow_exceptions_  whether parse errors yield exceptions
+    @param[in] narrow_float32_  whether floating-point numbers are rounded to
+                                single precision as they are parsed
     */
-    explicit json_sax_dom_parser(BasicJsonType& r, const bool allow_exceptions_ = true)
-        : root(r), allow_exceptions(allow_exceptions_)
+    explicit json_sax_dom_parser(BasicJsonType& r, const bool allow_exceptions_ = true, const bool narrow_float32_ = false)
+        : root(r), allow_exceptions(allow_exceptions_), narrow_float32(narrow_float32_)
     {}
 
     // make class move-only
@@ -6847,7 +6929,14 @@ class json_sax_dom_parser
 
     bool number_float(number_float_t val, const string_t& /*unused*/)
     {
-        handle_value(val);
+        if (narrow_float32)
+        {
+            handle_value(static_cast<number_float_t>(static_cast<float>(val)));
+        }
+        else
+        {
+            handle_value(val);
+        }
         return true;
     }
 
@@ -6872,6 +6961,7 @@ class json_sax_dom_parser
             JSON_THROW(out_of_range::create(408, concat("excessive object size: ", std::to_string(len)), ref_stack.back()));
         }
 
+        reserve_hinted();
         return true;
     }
 
@@ -6904,9 +6994,35 @@ class json_sax_dom_parser
             JSON_THROW(out_of_range::create(408, concat("excessive array size: ", std::to_string(len)), ref_stack.back()));
         }
 
+        reserve_hinted();
         return true;
     }
 
+    /*!
+    @brief reserve the array or object which has just been started
+
+    Called by the binary readers with the number of elements announced in a
+    header, as far as the input can hold them.
+    */
+    void reserve_back(std::size_t n)
+    {
+        JSON_ASSERT(!ref_stack.empty());
+        reserve_elements(*ref_stack.back(), n);
+    }
+
+    /*!
+    @brief use precomputed element counts for the containers of JSON text
+
+    @param[in] hints  number of elements of every array and object, in the
+                      order they are opened (see lexer_scan::container_sizes);
+                      it must outlive the parsing
+    */
+    void set_size_hints(const std::vector<std::size_t>* hints) noexcept
+    {
+        size_hints = hints;
+        size_hint_index = 0;
+    }
+
     bool end_array()
     {
         JSON_ASSERT(!ref_stack.empty());
@@ -6966,6 +7082,15 @@ class json_sax_dom_parser
         return object_element;
     }
 
+    /// reserve the container just started by the next size hint
+    void reserve_hinted()
+    {
+        if (size_hints != nullptr && size_hint_index < size_hints->size())
+        {
+            reserve_elements(*ref_stack.back(), (*size_hints)[size_hint_index++]);
+        }
+    }
+
     /// the parsed JSON value
     BasicJsonType& root;
     /// stack to model hierarchy of values
@@ -6976,6 +7101,12 @@ class json_sax_dom_parser
     bool errored = false;
     /// whether to throw exceptions in case of errors
     const bool allow_exceptions = true;
+    /// whether to round floating-point numbers to single precision
+    const bool narrow_float32 = false;
+    /// element counts of the containers in the order they are opened (may be null)
+    const std::vector<std::size_t>* size_hints = nullptr;
+    /// index of the next container in size_hints
+    std::size_t size_hint_index = 0;
 };
 
 template<typename BasicJsonType>
@@ -7135,6 +7266,16 @@ class json_sax_dom_callback_parser
         return true;
     }
 
+    /// reserve the array or object which has just been started (see json_sax_dom_parser::reserve_back)
+    void reserve_back(std::size_t n)
+    {
+        JSON_ASSERT(!ref_stack.empty());
+        if (ref_stack.back())
+        {
+            reserve_elements(*ref_stack.back(), n);
+        }
+    }
+
     bool end_array()
     {
         bool keep = true;
@@ -7379,7 +7520,10 @@ NLOHMANN_JSON_NAMESPACE_END
 #include <clocale> // localeconv
 #include <cstddef> // size_t
 #include <cstdio> // snprintf
+#include <cfloat> // FLT_EVAL_METHOD
+#include <cstdint> // uint64_t
 #include <cstdlib> // strtof, strtod, strtold, strtoll, strtoull
+#include <cstring> // memcpy
 #include <initializer_list> // initializer_list
 #include <string> // char_traits, string
 #include <utility> // move
@@ -7394,967 +7538,2218 @@ NLOHMANN_JSON_NAMESPACE_END
 // #include <nlohmann/detail/meta/type_traits.hpp>
 
 
+#if !defined(JSON_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define JSON_SIMD_SSE2 1
+    #include <emmintrin.h> // _mm_*
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h> // _BitScanForward
+    #endif
+    #if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+        #define JSON_SIMD_AVX2 1
+        #include <immintrin.h> // _mm256_*
+    #endif
+#endif
+
 NLOHMANN_JSON_NAMESPACE_BEGIN
 namespace detail
 {
 
-///////////
-// lexer //
-///////////
+////////////////////////
+// lexer scan helpers //
+////////////////////////
 
-template<typename BasicJsonType>
-class lexer_base
-{
-  public:
-    /// token types for the parser
-    enum class token_type
-    {
-        uninitialized,    ///< indicating the scanner is uninitialized
-        literal_true,     ///< the `true` literal
-        literal_false,    ///< the `false` literal
-        literal_null,     ///< the `null` literal
-        value_string,     ///< a string -- use get_string() for actual value
-        value_unsigned,   ///< an unsigned integer -- use get_number_unsigned() for actual value
-        value_integer,    ///< a signed integer -- use get_number_integer() for actual value
-        value_float,      ///< an floating point number -- use get_number_float() for actual value
-        begin_array,      ///< the character for array begin `[`
-        begin_object,     ///< the character for object begin `{`
-        end_array,        ///< the character for array end `]`
-        end_object,       ///< the character for object end `}`
-        name_separator,   ///< the name separator `:`
-        value_separator,  ///< the value separator `,`
-        parse_error,      ///< indicating a parse error
-        end_of_input,     ///< indicating the end of the input buffer
-        literal_or_value  ///< a literal or the begin of a value (only for diagnostics)
-    };
+/// whether the lexer can look at the input adapter's remaining bytes directly
+template<typename InputAdapterType, typename = void>
+struct is_contiguous_input_adapter : std::false_type {};
+
+template<typename InputAdapterType>
+struct is_contiguous_input_adapter<InputAdapterType, enable_if_t<InputAdapterType::is_contiguous>> : std::true_type {};
 
-    /// return name of values of type token_type (only used for errors)
-    JSON_HEDLEY_RETURNS_NON_NULL
-    JSON_HEDLEY_CONST
-    static const char* token_type_name(const token_type t) noexcept
-    {
-        switch (t)
-        {
-            case token_type::uninitialized:
-                return "<uninitialized>";
-            case token_type::literal_true:
-                return "true literal";
-            case token_type::literal_false:
-                return "false literal";
-            case token_type::literal_null:
-                return "null literal";
-            case token_type::value_string:
-                return "string literal";
-            case token_type::value_unsigned:
-            case token_type::value_integer:
-            case token_type::value_float:
-                return "number literal";
-            case token_type::begin_array:
-                return "'['";
-            case token_type::begin_object:
-                return "'{'";
-            case token_type::end_array:
-                return "']'";
-            case token_type::end_object:
-                return "'}'";
-            case token_type::name_separator:
-                return "':'";
-            case token_type::value_separator:
-                return "','";
-            case token_type::parse_error:
-                return "<parse error>";
-            case token_type::end_of_input:
-                return "end of input";
-            case token_type::literal_or_value:
-                return "'[', '{', or a literal";
-            // LCOV_EXCL_START
-            default: // catch non-enum values
-                return "unknown token";
-                // LCOV_EXCL_STOP
-        }
-    }
-};
 /*!
-@brief lexical analysis
+@brief block scanners used by the lexer on contiguous input
 
-This class organizes the lexical analysis during JSON deserialization.
+- string_run: length of the leading run of bytes which can be copied into a
+  string as they are (ASCII 0x20..0x7F except '"' and '\\')
+- whitespace_run: length of the leading run of ' ', '\t', '\n', '\r'
+
+The SSE2/AVX2 versions are selected once at runtime; the scalar versions are
+used everywhere else.
 */
-template<typename BasicJsonType, typename InputAdapterType>
-class lexer : public lexer_base<BasicJsonType>
+struct lexer_scan
 {
-    using number_integer_t = typename BasicJsonType::number_integer_t;
-    using number_unsigned_t = typename BasicJsonType::number_unsigned_t;
-    using number_float_t = typename BasicJsonType::number_float_t;
-    using string_t = typename BasicJsonType::string_t;
-    using char_type = typename InputAdapterType::char_type;
-    using char_int_type = typename char_traits<char_type>::int_type;
-
-  public:
-    using token_type = typename lexer_base<BasicJsonType>::token_type;
-
-    explicit lexer(InputAdapterType&& adapter, bool ignore_comments_ = false) noexcept
-        : ia(std::move(adapter))
-        , ignore_comments(ignore_comments_)
-        , decimal_point_char(static_cast<char_int_type>(get_decimal_point()))
-    {}
-
-    // delete because of pointer members
-    lexer(const lexer&) = delete;
-    lexer(lexer&&) = default; // NOLINT(hicpp-noexcept-move,performance-noexcept-move-constructor)
-    lexer& operator=(lexer&) = delete;
-    lexer& operator=(lexer&&) = default; // NOLINT(hicpp-noexcept-move,performance-noexcept-move-constructor)
-    ~lexer() = default;
-
-  private:
-    /////////////////////
-    // locales
-    /////////////////////
+    using scan_function_t = std::size_t (*)(const char*, std::size_t);
 
-    /// return the locale-dependent decimal point
-    JSON_HEDLEY_PURE
-    static char get_decimal_point() noexcept
+    static bool is_string_char(unsigned char c) noexcept
     {
-        const auto* loc = localeconv();
-        JSON_ASSERT(loc != nullptr);
-        return (loc->decimal_point == nullptr) ? '.' : *(loc->decimal_point);
+        return c >= 0x20 && c < 0x80 && c != '\"' && c != '\\';
     }
 
-    /////////////////////
-    // scan functions
-    /////////////////////
+    static bool is_whitespace(unsigned char c) noexcept
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
 
-    /*!
-    @brief get codepoint from 4 hex characters following `\u`
+    static std::size_t string_run_scalar(const char* p, std::size_t n) noexcept
+    {
+        std::size_t i = 0;
+        while (i < n && is_string_char(static_cast<unsigned char>(p[i])))
+        {
+            ++i;
+        }
+        return i;
+    }
 
-    For input "\u c1 c2 c3 c4" the codepoint is:
-      (c1 * 0x1000) + (c2 * 0x0100) + (c3 * 0x0010) + c4
-    = (c1 << 12) + (c2 << 8) + (c3 << 4) + (c4 << 0)
+    static std::size_t whitespace_run_scalar(const char* p, std::size_t n) noexcept
+    {
+        std::size_t i = 0;
+        while (i < n && is_whitespace(static_cast<unsigned char>(p[i])))
+        {
+            ++i;
+        }
+        return i;
+    }
 
-    Furthermore, the possible characters '0'..'9', 'A'..'F', and 'a'..'f'
-    must be converted to the integers 0x0..0x9, 0xA..0xF, 0xA..0xF, resp. The
-    conversion is done by subtracting the offset (0x30, 0x37, and 0x57)
-    between the ASCII value of the character and the desired integer value.
+#if defined(JSON_SIMD_SSE2)
+    static unsigned int first_bit(unsigned int mask) noexcept
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        unsigned long idx = 0;
+        _BitScanForward(&idx, mask);
+        return static_cast<unsigned int>(idx);
+#else
+        return static_cast<unsigned int>(__builtin_ctz(mask));
+#endif
+    }
 
-    @return codepoint (0x0000..0xFFFF) or -1 in case of an error (e.g. EOF or
-            non-hex character)
-    */
-    int get_codepoint()
+    static std::size_t string_run_sse2(const char* p, std::size_t n) noexcept
     {
-        // this function only makes sense after reading `\u`
-        JSON_ASSERT(current == 'u');
-        int codepoint = 0;
+        const __m128i quote = _mm_set1_epi8('\"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i space = _mm_set1_epi8(0x20);
 
-        const auto factors = { 12u, 8u, 4u, 0u };
-        for (const auto factor : factors)
+        std::size_t i = 0;
+        for (; i + 16 <= n; i += 16)
         {
-            get();
-
-            if (current >= '0' && current <= '9')
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+            // signed compare: control characters and bytes >= 0x80 are both "less than 0x20"
+            const __m128i stop = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+                                              _mm_cmplt_epi8(v, space));
+            const auto mask = static_cast<unsigned int>(_mm_movemask_epi8(stop));
+            if (mask != 0)
             {
-                codepoint += static_cast<int>((static_cast<unsigned int>(current) - 0x30u) << factor);
+                return i + first_bit(mask);
             }
-            else if (current >= 'A' && current <= 'F')
+        }
+        return i + string_run_scalar(p + i, n - i);
+    }
+
+    static std::size_t whitespace_run_sse2(const char* p, std::size_t n) noexcept
+    {
+        const __m128i space = _mm_set1_epi8(' ');
+        const __m128i tab = _mm_set1_epi8('\t');
+        const __m128i lf = _mm_set1_epi8('\n');
+        const __m128i cr = _mm_set1_epi8('\r');
+
+        std::size_t i = 0;
+        for (; i + 16 <= n; i += 16)
+        {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+            const __m128i ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, space), _mm_cmpeq_epi8(v, tab)),
+                                            _mm_or_si128(_mm_cmpeq_epi8(v, lf), _mm_cmpeq_epi8(v, cr)));
+            const auto mask = static_cast<unsigned int>(_mm_movemask_epi8(ws)) ^ 0xFFFFu;
+            if (mask != 0)
             {
-                codepoint += static_cast<int>((static_cast<unsigned int>(current) - 0x37u) << factor);
+                return i + first_bit(mask);
             }
-            else if (current >= 'a' && current <= 'f')
+        }
+        return i + whitespace_run_scalar(p + i, n - i);
+    }
+#endif
+
+#if defined(JSON_SIMD_AVX2)
+    __attribute__((target("avx2")))
+    static std::size_t string_run_avx2(const char* p, std::size_t n) noexcept
+    {
+        const __m256i quote = _mm256_set1_epi8('\"');
+        const __m256i backslash = _mm256_set1_epi8('\\');
+        const __m256i space = _mm256_set1_epi8(0x20);
+
+        std::size_t i = 0;
+        for (; i + 32 <= n; i += 32)
+        {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+            const __m256i stop = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash)),
+                                                 _mm256_cmpgt_epi8(space, v));
+            const auto mask = static_cast<unsigned int>(_mm256_movemask_epi8(stop));
+            if (mask != 0)
             {
-                codepoint += static_cast<int>((static_cast<unsigned int>(current) - 0x57u) << factor);
+                return i + first_bit(mask);
             }
-            else
+        }
+        return i + string_run_sse2(p + i, n - i);
+    }
+
+    __attribute__((target("avx2")))
+    static std::size_t whitespace_run_avx2(const char* p, std::size_t n) noexcept
+    {
+        const __m256i space = _mm256_set1_epi8(' ');
+        const __m256i tab = _mm256_set1_epi8('\t');
+        const __m256i lf = _mm256_set1_epi8('\n');
+        const __m256i cr = _mm256_set1_epi8('\r');
+
+        std::size_t i = 0;
+        for (; i + 32 <= n; i += 32)
+        {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+            const __m256i ws = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, space), _mm256_cmpeq_epi8(v, tab)),
+                                               _mm256_or_si256(_mm256_cmpeq_epi8(v, lf), _mm256_cmpeq_epi8(v, cr)));
+            const auto mask = ~static_cast<unsigned int>(_mm256_movemask_epi8(ws));
+            if (mask != 0)
             {
-                return -1;
+                return i + first_bit(mask);
             }
         }
+        return i + whitespace_run_sse2(p + i, n - i);
+    }
 
-        JSON_ASSERT(0x0000 <= codepoint && codepoint <= 0xFFFF);
-        return codepoint;
+    static bool has_avx2() noexcept
+    {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
     }
+#endif
 
-    /*!
-    @brief check if the next byte(s) are inside a given range
-
-    Adds the current byte and, for each passed range, reads a new byte and
-    checks if it is inside the range. If a violation was detected, set up an
-    error message and return false. Otherwise, return true.
+    static std::size_t string_run(const char* p, std::size_t n)
+    {
+#if defined(JSON_SIMD_AVX2)
+        static const scan_function_t f = has_avx2() ? &string_run_avx2 : &string_run_sse2;
+        return f(p, n);
+#elif defined(JSON_SIMD_SSE2)
+        return string_run_sse2(p, n);
+#else
+        return string_run_scalar(p, n);
+#endif
+    }
 
-    @param[in] ranges  list of integers; interpreted as list of pairs of
-                       inclusive lower and upper bound, respectively
+    static std::size_t whitespace_run(const char* p, std::size_t n)
+    {
+#if defined(JSON_SIMD_AVX2)
+        static const scan_function_t f = has_avx2() ? &whitespace_run_avx2 : &whitespace_run_sse2;
+        return f(p, n);
+#elif defined(JSON_SIMD_SSE2)
+        return whitespace_run_sse2(p, n);
+#else
+        return whitespace_run_scalar(p, n);
+#endif
+    }
 
-    @pre The passed list @a ranges must have 2, 4, or 6 elements; that is,
-         1, 2, or 3 pairs. This precondition is enforced by an assertion.
+    /*!
+    @brief count the elements of every array and object of JSON text
 
-    @return true if and only if no range violation was detected
+    A structural pass over the text: the elements of a container are counted
+    by the commas on its level, and strings are skipped. The counts are
+    appended to @a sizes in the order the containers are opened, which is the
+    order of the start_array / start_object events. Invalid text gives
+    meaningless counts; they are only used as reservation hints.
     */
-    bool next_byte_in_range(std::initializer_list<char_int_type> ranges)
+    static void container_sizes(const char* p, std::size_t n, std::vector<std::size_t>& sizes)
     {
-        JSON_ASSERT(ranges.size() == 2 || ranges.size() == 4 || ranges.size() == 6);
-        add(current);
+        struct open_container
+        {
+            std::size_t index;
+            std::size_t commas;
+            bool empty;
+        };
+        std::vector<open_container> stack;
 
-        for (auto range = ranges.begin(); range != ranges.end(); ++range)
+        for (std::size_t i = 0; i < n; ++i)
         {
-            get();
-            if (JSON_HEDLEY_LIKELY(*range <= current && current <= *(++range))) // NOLINT(bugprone-inc-dec-in-conditions)
+            switch (p[i])
             {
-                add(current);
-            }
-            else
-            {
-                error_message = "invalid string: ill-formed UTF-8 byte";
-                return false;
+                case '[':
+                case '{':
+                    if (!stack.empty())
+                    {
+                        stack.back().empty = false;
+                    }
+                    stack.push_back({sizes.size(), 0, true});
+                    sizes.push_back(0);
+                    break;
+
+                case ']':
+                case '}':
+                    if (!stack.empty())
+                    {
+                        const auto& top = stack.back();
+                        sizes[top.index] = top.empty ? 0 : top.commas + 1;
+                        stack.pop_back();
+                    }
+                    break;
+
+                case ',':
+                    if (!stack.empty())
+                    {
+                        ++stack.back().commas;
+                    }
+                    break;
+
+                case '\"':
+                {
+                    if (!stack.empty())
+                    {
+                        stack.back().empty = false;
+                    }
+                    // closing quote: the first one not escaped by an odd number of backslashes
+                    const std::size_t first = i;
+                    while (true)
+                    {
+                        const auto* q = static_cast<const char*>(std::memchr(p + i + 1, '\"', n - i - 1));
+                        if (q == nullptr)
+                        {
+                            return;
+                        }
+                        i = static_cast<std::size_t>(q - p);
+                        std::size_t backslashes = 0;
+                        while (i - backslashes - 1 > first && p[i - backslashes - 1] == '\\')
+                        {
+                            ++backslashes;
+                        }
+                        if (backslashes % 2 == 0)
+                        {
+                            break;
+                        }
+                    }
+                    break;
+                }
+
+                case ' ':
+                case '\t':
+                case '\n':
+                case '\r':
+                case ':':
+                    break;
+
+                default:
+                    if (!stack.empty())
+                    {
+                        stack.back().empty = false;
+                    }
+                    break;
             }
         }
+    }
+};
+
+/*!
+@brief decimal to binary conversion used by lexer::scan_number()
+
+- unsigned integers are accumulated 8 digits at a time (SWAR)
+- doubles are converted with the Clinger fast path and the Eisel-Lemire
+  algorithm (as in fast_float), which gives the correctly rounded result
+
+Every function returns false for the inputs it does not handle (more than 19
+significant digits, subnormals, overflow, ...); the caller then falls back to
+strtoull/strtod, so the results are bit-identical to the C library.
+Define JSON_NO_FAST_NUMBER to always use the C library.
+*/
+struct number_scan
+{
+    /// the 8 bytes at p as a little-endian word
+    static std::uint64_t load_eight(const char* p) noexcept
+    {
+        std::uint64_t v = 0;
+        for (int i = 7; i >= 0; --i)
+        {
+            v = (v << 8) | static_cast<unsigned char>(p[i]);
+        }
+        return v;
+    }
+
+    static bool is_eight_digits(std::uint64_t v) noexcept
+    {
+        return (((v & 0xF0F0F0F0F0F0F0F0u) | (((v + 0x0606060606060606u) & 0xF0F0F0F0F0F0F0F0u) >> 4)) == 0x3333333333333333u);
+    }
+
+    static std::uint32_t parse_eight_digits(std::uint64_t v) noexcept
+    {
+        v -= 0x3030303030303030u;
+        v = (v * 10) + (v >> 8);
+        v = (((v & 0x000000FF000000FFu) * 0x000F424000000064u) + (((v >> 16) & 0x000000FF000000FFu) * 0x0000271000000001u)) >> 32;
+        return static_cast<std::uint32_t>(v);
+    }
+
+    static bool is_digit(char c) noexcept
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    /// digits [p, end) to value; false if there are more than 19 digits
+    static bool parse_digits(const char* p, const char* end, std::uint64_t& value) noexcept
+    {
+        if (end - p > 19)
+        {
+            return false;
+        }
 
+        std::uint64_t v = 0;
+        while (end - p >= 8)
+        {
+            v = v * 100000000u + parse_eight_digits(load_eight(p));
+            p += 8;
+        }
+        while (p != end)
+        {
+            v = v * 10 + static_cast<std::uint64_t>(*p - '0');
+            ++p;
+        }
+        value = v;
         return true;
     }
 
+    static void mul_64x64(std::uint64_t a, std::uint64_t b, std::uint64_t& hi, std::uint64_t& lo) noexcept
+    {
+#if defined(__SIZEOF_INT128__)
+        const auto r = static_cast<unsigned __int128>(a) * b;
+        hi = static_cast<std::uint64_t>(r >> 64);
+        lo = static_cast<std::uint64_t>(r);
+#else
+        const std::uint64_t a_lo = a & 0xFFFFFFFFu;
+        const std::uint64_t a_hi = a >> 32;
+        const std::uint64_t b_lo = b & 0xFFFFFFFFu;
+        const std::uint64_t b_hi = b >> 32;
+        const std::uint64_t ll = a_lo * b_lo;
+        const std::uint64_t lh = a_lo * b_hi;
+        const std::uint64_t hl = a_hi * b_lo;
+        const std::uint64_t hh = a_hi * b_hi;
+        const std::uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFFu) + (hl & 0xFFFFFFFFu);
+        lo = (mid << 32) | (ll & 0xFFFFFFFFu);
+        hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+#endif
+    }
+
+    static int leading_zeroes(std::uint64_t v) noexcept
+    {
+        int n = 0;
+        while ((v & (std::uint64_t(1) << 63)) == 0)
+        {
+            v <<= 1;
+            ++n;
+        }
+        return n;
+    }
+
+    /// 128-bit approximations of 5^q for q in [-342, 308]
+    static const std::uint64_t* power_of_five_128() noexcept
+    {
+        static const std::uint64_t table[] =
+        {
+            0xeef453d6923bd65au, 0x113faa2906a13b3fu,
+            0x9558b4661b6565f8u, 0x4ac7ca59a424c507u,
+            0xbaaee17fa23ebf76u, 0x5d79bcf00d2df649u,
+            0xe95a99df8ace6f53u, 0xf4d82c2c107973dcu,
+            0x91d8a02bb6c10594u, 0x79071b9b8a4be869u,
+            0xb64ec836a47146f9u, 0x9748e2826cdee284u,
+            0xe3e27a444d8d98b7u, 0xfd1b1b2308169b25u,
+            0x8e6d8c6ab0787f72u, 0xfe30f0f5e50e20f7u,
+            0xb208ef855c969f4fu, 0xbdbd2d335e51a935u,
+            0xde8b2b66b3bc4723u, 0xad2c788035e61382u,
+            0x8b16fb203055ac76u, 0x4c3bcb5021afcc31u,
+            0xaddcb9e83c6b1793u, 0xdf4abe242a1bbf3du,
+            0xd953e8624b85dd78u, 0xd71d6dad34a2af0du,
+            0x87d4713d6f33aa6bu, 0x8672648c40e5ad68u,
+            0xa9c98d8ccb009506u, 0x680efdaf511f18c2u,
+            0xd43bf0effdc0ba48u, 0x0212bd1b2566def2u,
+            0x84a57695fe98746du, 0x014bb630f7604b57u,
+            0xa5ced43b7e3e9188u, 0x419ea3bd35385e2du,
+            0xcf42894a5dce35eau, 0x52064cac828675b9u,
+            0x818995ce7aa0e1b2u, 0x7343efebd1940993u,
+            0xa1ebfb4219491a1fu, 0x1014ebe6c5f90bf8u,
+            0xca66fa129f9b60a6u, 0xd41a26e077774ef6u,
+            0xfd00b897478238d0u, 0x8920b098955522b4u,
+            0x9e20735e8cb16382u, 0x55b46e5f5d5535b0u,
+            0xc5a890362fddbc62u, 0xeb2189f734aa831du,
+            0xf712b443bbd52b7bu, 0xa5e9ec7501d523e4u,
+            0x9a6bb0aa55653b2du, 0x47b233c92125366eu,
+            0xc1069cd4eabe89f8u, 0x999ec0bb696e840au,
+            0xf148440a256e2c76u, 0xc00670ea43ca250du,
+            0x96cd2a865764dbcau, 0x380406926a5e5728u,
+            0xbc807527ed3e12bcu, 0xc605083704f5ecf2u,
+            0xeba09271e88d976bu, 0xf7864a44c633682eu,
+            0x93445b8731587ea3u, 0x7ab3ee6afbe0211du,
+            0xb8157268fdae9e4cu, 0x5960ea05bad82964u,
+            0xe61acf033d1a45dfu, 0x6fb92487298e33bdu,
+            0x8fd0c16206306babu, 0xa5d3b6d479f8e056u,
+            0xb3c4f1ba87bc8696u, 0x8f48a4899877186cu,
+            0xe0b62e2929aba83cu, 0x331acdabfe94de87u,
+            0x8c71dcd9ba0b4925u, 0x9ff0c08b7f1d0b14u,
+            0xaf8e5410288e1b6fu, 0x07ecf0ae5ee44dd9u,
+            0xdb71e91432b1a24au, 0xc9e82cd9f69d6150u,
+            0x892731ac9faf056eu, 0xbe311c083a225cd2u,
+            0xab70fe17c79ac6cau, 0x6dbd630a48aaf406u,
+            0xd64d3d9db981787du, 0x092cbbccdad5b108u,
+            0x85f0468293f0eb4eu, 0x25bbf56008c58ea5u,
+            0xa76c582338ed2621u, 0xaf2af2b80af6f24eu,
+            0xd1476e2c07286faau, 0x1af5af660db4aee1u,
+            0x82cca4db847945cau, 0x50d98d9fc890ed4du,
+            0xa37fce126597973cu, 0xe50ff107bab528a0u,
+            0xcc5fc196fefd7d0cu, 0x1e53ed49a96272c8u,
+            0xff77b1fcbebcdc4fu, 0x25e8e89c13bb0f7au,
+            0x9faacf3df73609b1u, 0x77b191618c54e9acu,
+            0xc795830d75038c1du, 0xd59df5b9ef6a2417u,
+            0xf97ae3d0d2446f25u, 0x4b0573286b44ad1du,
+            0x9becce62836ac577u, 0x4ee367f9430aec32u,
+            0xc2e801fb244576d5u, 0x229c41f793cda73fu,
+            0xf3a20279ed56d48au, 0x6b43527578c1110fu,
+            0x9845418c345644d6u, 0x830a13896b78aaa9u,
+            0xbe5691ef416bd60cu, 0x23cc986bc656d553u,
+            0xedec366b11c6cb8fu, 0x2cbfbe86b7ec8aa8u,
+            0x94b3a202eb1c3f39u, 0x7bf7d71432f3d6a9u,
+            0xb9e08a83a5e34f07u, 0xdaf5ccd93fb0cc53u,
+            0xe858ad248f5c22c9u, 0xd1b3400f8f9cff68u,
+            0x91376c36d99995beu, 0x23100809b9c21fa1u,
+            0xb58547448ffffb2du, 0xabd40a0c2832a78au,
+            0xe2e69915b3fff9f9u, 0x16c90c8f323f516cu,
+            0x8dd01fad907ffc3bu, 0xae3da7d97f6792e3u,
+            0xb1442798f49ffb4au, 0x99cd11cfdf41779cu,
+            0xdd95317f31c7fa1du, 0x40405643d711d583u,
+            0x8a7d3eef7f1cfc52u, 0x482835ea666b2572u,
+            0xad1c8eab5ee43b66u, 0xda3243650005eecfu,
+            0xd863b256369d4a40u, 0x90bed43e40076a82u,
+            0x873e4f75e2224e68u, 0x5a7744a6e804a291u,
+            0xa90de3535aaae202u, 0x711515d0a205cb36u,
+            0xd3515c2831559a83u, 0x0d5a5b44ca873e03u,
+            0x8412d9991ed58091u, 0xe858790afe9486c2u,
+            0xa5178fff668ae0b6u, 0x626e974dbe39a872u,
+            0xce5d73ff402d98e3u, 0xfb0a3d212dc8128fu,
+            0x80fa687f881c7f8eu, 0x7ce66634bc9d0b99u,
+            0xa139029f6a239f72u, 0x1c1fffc1ebc44e80u,
+            0xc987434744ac874eu, 0xa327ffb266b56220u,
+            0xfbe9141915d7a922u, 0x4bf1ff9f0062baa8u,
+            0x9d71ac8fada6c9b5u, 0x6f773fc3603db4a9u,
+            0xc4ce17b399107c22u, 0xcb550fb4384d21d3u,
+            0xf6019da07f549b2bu, 0x7e2a53a146606a48u,
+            0x99c102844f94e0fbu, 0x2eda7444cbfc426du,
+            0xc0314325637a1939u, 0xfa911155fefb5308u,
+            0xf03d93eebc589f88u, 0x793555ab7eba27cau,
+            0x96267c7535b763b5u, 0x4bc1558b2f3458deu,
+            0xbbb01b9283253ca2u, 0x9eb1aaedfb016f16u,
+            0xea9c227723ee8bcbu, 0x465e15a979c1cadcu,
+            0x92a1958a7675175fu, 0x0bfacd89ec191ec9u,
+            0xb749faed14125d36u, 0xcef980ec671f667bu,
+            0xe51c79a85916f484u, 0x82b7e12780e7401au,
+            0x8f31cc0937ae58d2u, 0xd1b2ecb8b0908810u,
+            0xb2fe3f0b8599ef07u, 0x861fa7e6dcb4aa15u,
+            0xdfbdcece67006ac9u, 0x67a791e093e1d49au,
+            0x8bd6a141006042bdu, 0xe0c8bb2c5c6d24e0u,
+            0xaecc49914078536du, 0x58fae9f773886e18u,
+            0xda7f5bf590966848u, 0xaf39a475506a899eu,
+            0x888f99797a5e012du, 0x6d8406c952429603u,
+            0xaab37fd7d8f58178u, 0xc8e5087ba6d33b83u,
+            0xd5605fcdcf32e1d6u, 0xfb1e4a9a90880a64u,
+            0x855c3be0a17fcd26u, 0x5cf2eea09a55067fu,
+            0xa6b34ad8c9dfc06fu, 0xf42faa48c0ea481eu,
+            0xd0601d8efc57b08bu, 0xf13b94daf124da26u,
+            0x823c12795db6ce57u, 0x76c53d08d6b70858u,
+            0xa2cb1717b52481edu, 0x54768c4b0c64ca6eu,
+            0xcb7ddcdda26da268u, 0xa9942f5dcf7dfd09u,
+            0xfe5d54150b090b02u, 0xd3f93b35435d7c4cu,
+            0x9efa548d26e5a6e1u, 0xc47bc5014a1a6dafu,
+            0xc6b8e9b0709f109au, 0x359ab6419ca1091bu,
+            0xf867241c8cc6d4c0u, 0xc30163d203c94b62u,
+            0x9b407691d7fc44f8u, 0x79e0de63425dcf1du,
+            0xc21094364dfb5636u, 0x985915fc12f542e4u,
+            0xf294b943e17a2bc4u, 0x3e6f5b7b17b2939du,
+            0x979cf3ca6cec5b5au, 0xa705992ceecf9c42u,
+            0xbd8430bd08277231u, 0x50c6ff782a838353u,
+            0xece53cec4a314ebdu, 0xa4f8bf5635246428u,
+            0x940f4613ae5ed136u, 0x871b7795e136be99u,
+            0xb913179899f68584u, 0x28e2557b59846e3fu,
+            0xe757dd7ec07426e5u, 0x331aeada2fe589cfu,
+            0x9096ea6f3848984fu, 0x3ff0d2c85def7621u,
+            0xb4bca50b065abe63u, 0x0fed077a756b53a9u,
+            0xe1ebce4dc7f16dfbu, 0xd3e8495912c62894u,
+            0x8d3360f09cf6e4bdu, 0x64712dd7abbbd95cu,
+            0xb080392cc4349decu, 0xbd8d794d96aacfb3u,
+            0xdca04777f541c567u, 0xecf0d7a0fc5583a0u,
+            0x89e42caaf9491b60u, 0xf41686c49db57244u,
+            0xac5d37d5b79b6239u, 0x311c2875c522ced5u,
+            0xd77485cb25823ac7u, 0x7d633293366b828bu,
+            0x86a8d39ef77164bcu, 0xae5dff9c02033197u,
+            0xa8530886b54dbdebu, 0xd9f57f830283fdfcu,
+            0xd267caa862a12d66u, 0xd072df63c324fd7bu,
+            0x8380dea93da4bc60u, 0x4247cb9e59f71e6du,
+            0xa46116538d0deb78u, 0x52d9be85f074e608u,
+            0xcd795be870516656u, 0x67902e276c921f8bu,
+            0x806bd9714632dff6u, 0x00ba1cd8a3db53b6u,
+            0xa086cfcd97bf97f3u, 0x80e8a40eccd228a4u,
+            0xc8a883c0fdaf7df0u, 0x6122cd128006b2cdu,
+            0xfad2a4b13d1b5d6cu, 0x796b805720085f81u,
+            0x9cc3a6eec6311a63u, 0xcbe3303674053bb0u,
+            0xc3f490aa77bd60fcu, 0xbedbfc4411068a9cu,
+            0xf4f1b4d515acb93bu, 0xee92fb5515482d44u,
+            0x991711052d8bf3c5u, 0x751bdd152d4d1c4au,
+            0xbf5cd54678eef0b6u, 0xd262d45a78a0635du,
+            0xef340a98172aace4u, 0x86fb897116c87c34u,
+            0x9580869f0e7aac0eu, 0xd45d35e6ae3d4da0u,
+            0xbae0a846d2195712u, 0x8974836059cca109u,
+            0xe998d258869facd7u, 0x2bd1a438703fc94bu,
+            0x91ff83775423cc06u, 0x7b6306a34627ddcfu,
+            0xb67f6455292cbf08u, 0x1a3bc84c17b1d542u,
+            0xe41f3d6a7377eecau, 0x20caba5f1d9e4a93u,
+            0x8e938662882af53eu, 0x547eb47b7282ee9cu,
+            0xb23867fb2a35b28du, 0xe99e619a4f23aa43u,
+            0xdec681f9f4c31f31u, 0x6405fa00e2ec94d4u,
+            0x8b3c113c38f9f37eu, 0xde83bc408dd3dd04u,
+            0xae0b158b4738705eu, 0x9624ab50b148d445u,
+            0xd98ddaee19068c76u, 0x3badd624dd9b0957u,
+            0x87f8a8d4cfa417c9u, 0xe54ca5d70a80e5d6u,
+            0xa9f6d30a038d1dbcu, 0x5e9fcf4ccd211f4cu,
+            0xd47487cc8470652bu, 0x7647c3200069671fu,
+            0x84c8d4dfd2c63f3bu, 0x29ecd9f40041e073u,
+            0xa5fb0a17c777cf09u, 0xf468107100525890u,
+            0xcf79cc9db955c2ccu, 0x7182148d4066eeb4u,
+            0x81ac1fe293d599bfu, 0xc6f14cd848405530u,
+            0xa21727db38cb002fu, 0xb8ada00e5a506a7cu,
+            0xca9cf1d206fdc03bu, 0xa6d90811f0e4851cu,
+            0xfd442e4688bd304au, 0x908f4a166d1da663u,
+            0x9e4a9cec15763e2eu, 0x9a598e4e043287feu,
+            0xc5dd44271ad3cdbau, 0x40eff1e1853f29fdu,
+            0xf7549530e188c128u, 0xd12bee59e68ef47cu,
+            0x9a94dd3e8cf578b9u, 0x82bb74f8301958ceu,
+            0xc13a148e3032d6e7u, 0xe36a52363c1faf01u,
+            0xf18899b1bc3f8ca1u, 0xdc44e6c3cb279ac1u,
+            0x96f5600f15a7b7e5u, 0x29ab103a5ef8c0b9u,
+            0xbcb2b812db11a5deu, 0x7415d448f6b6f0e7u,
+            0xebdf661791d60f56u, 0x111b495b3464ad21u,
+            0x936b9fcebb25c995u, 0xcab10dd900beec34u,
+            0xb84687c269ef3bfbu, 0x3d5d514f40eea742u,
+            0xe65829b3046b0afau, 0x0cb4a5a3112a5112u,
+            0x8ff71a0fe2c2e6dcu, 0x47f0e785eaba72abu,
+            0xb3f4e093db73a093u, 0x59ed216765690f56u,
+            0xe0f218b8d25088b8u, 0x306869c13ec3532cu,
+            0x8c974f7383725573u, 0x1e414218c73a13fbu,
+            0xafbd2350644eeacfu, 0xe5d1929ef90898fau,
+            0xdbac6c247d62a583u, 0xdf45f746b74abf39u,
+            0x894bc396ce5da772u, 0x6b8bba8c328eb783u,
+            0xab9eb47c81f5114fu, 0x066ea92f3f326564u,
+            0xd686619ba27255a2u, 0xc80a537b0efefebdu,
+            0x8613fd0145877585u, 0xbd06742ce95f5f36u,
+            0xa798fc4196e952e7u, 0x2c48113823b73704u,
+            0xd17f3b51fca3a7a0u, 0xf75a15862ca504c5u,
+            0x82ef85133de648c4u, 0x9a984d73dbe722fbu,
+            0xa3ab66580d5fdaf5u, 0xc13e60d0d2e0ebbau,
+            0xcc963fee10b7d1b3u, 0x318df905079926a8u,
+            0xffbbcfe994e5c61fu, 0xfdf17746497f7052u,
+            0x9fd561f1fd0f9bd3u, 0xfeb6ea8bedefa633u,
+            0xc7caba6e7c5382c8u, 0xfe64a52ee96b8fc0u,
+            0xf9bd690a1b68637bu, 0x3dfdce7aa3c673b0u,
+            0x9c1661a651213e2du, 0x06bea10ca65c084eu,
+            0xc31bfa0fe5698db8u, 0x486e494fcff30a62u,
+            0xf3e2f893dec3f126u, 0x5a89dba3c3efccfau,
+            0x986ddb5c6b3a76b7u, 0xf89629465a75e01cu,
+            0xbe89523386091465u, 0xf6bbb397f1135823u,
+            0xee2ba6c0678b597fu, 0x746aa07ded582e2cu,
+            0x94db483840b717efu, 0xa8c2a44eb4571cdcu,
+            0xba121a4650e4ddebu, 0x92f34d62616ce413u,
+            0xe896a0d7e51e1566u, 0x77b020baf9c81d17u,
+            0x915e2486ef32cd60u, 0x0ace1474dc1d122eu,
+            0xb5b5ada8aaff80b8u, 0x0d819992132456bau,
+            0xe3231912d5bf60e6u, 0x10e1fff697ed6c69u,
+            0x8df5efabc5979c8fu, 0xca8d3ffa1ef463c1u,
+            0xb1736b96b6fd83b3u, 0xbd308ff8a6b17cb2u,
+            0xddd0467c64bce4a0u, 0xac7cb3f6d05ddbdeu,
+            0x8aa22c0dbef60ee4u, 0x6bcdf07a423aa96bu,
+            0xad4ab7112eb3929du, 0x86c16c98d2c953c6u,
+            0xd89d64d57a607744u, 0xe871c7bf077ba8b7u,
+            0x87625f056c7c4a8bu, 0x11471cd764ad4972u,
+            0xa93af6c6c79b5d2du, 0xd598e40d3dd89bcfu,
+            0xd389b47879823479u, 0x4aff1d108d4ec2c3u,
+            0x843610cb4bf160cbu, 0xcedf722a585139bau,
+            0xa54394fe1eedb8feu, 0xc2974eb4ee658828u,
+            0xce947a3da6a9273eu, 0x733d226229feea32u,
+            0x811ccc668829b887u, 0x0806357d5a3f525fu,
+            0xa163ff802a3426a8u, 0xca07c2dcb0cf26f7u,
+            0xc9bcff6034c13052u, 0xfc89b393dd02f0b5u,
+            0xfc2c3f3841f17c67u, 0xbbac2078d443ace2u,
+            0x9d9ba7832936edc0u, 0xd54b944b84aa4c0du,
+            0xc5029163f384a931u, 0x0a9e795e65d4df11u,
+            0xf64335bcf065d37du, 0x4d4617b5ff4a16d5u,
+            0x99ea0196163fa42eu, 0x504bced1bf8e4e45u,
+            0xc06481fb9bcf8d39u, 0xe45ec2862f71e1d6u,
+            0xf07da27a82c37088u, 0x5d767327bb4e5a4cu,
+            0x964e858c91ba2655u, 0x3a6a07f8d510f86fu,
+            0xbbe226efb628afeau, 0x890489f70a55368bu,
+            0xeadab0aba3b2dbe5u, 0x2b45ac74ccea842eu,
+            0x92c8ae6b464fc96fu, 0x3b0b8bc90012929du,
+            0xb77ada0617e3bbcbu, 0x09ce6ebb40173744u,
+            0xe55990879ddcaabdu, 0xcc420a6a101d0515u,
+            0x8f57fa54c2a9eab6u, 0x9fa946824a12232du,
+            0xb32df8e9f3546564u, 0x47939822dc96abf9u,
+            0xdff9772470297ebdu, 0x59787e2b93bc56f7u,
+            0x8bfbea76c619ef36u, 0x57eb4edb3c55b65au,
+            0xaefae51477a06b03u, 0xede622920b6b23f1u,
+            0xdab99e59958885c4u, 0xe95fab368e45ecedu,
+            0x88b402f7fd75539bu, 0x11dbcb0218ebb414u,
+            0xaae103b5fcd2a881u, 0xd652bdc29f26a119u,
+            0xd59944a37c0752a2u, 0x4be76d3346f0495fu,
+            0x857fcae62d8493a5u, 0x6f70a4400c562ddbu,
+            0xa6dfbd9fb8e5b88eu, 0xcb4ccd500f6bb952u,
+            0xd097ad07a71f26b2u, 0x7e2000a41346a7a7u,
+            0x825ecc24c873782fu, 0x8ed400668c0c28c8u,
+            0xa2f67f2dfa90563bu, 0x728900802f0f32fau,
+            0xcbb41ef979346bcau, 0x4f2b40a03ad2ffb9u,
+            0xfea126b7d78186bcu, 0xe2f610c84987bfa8u,
+            0x9f24b832e6b0f436u, 0x0dd9ca7d2df4d7c9u,
+            0xc6ede63fa05d3143u, 0x91503d1c79720dbbu,
+            0xf8a95fcf88747d94u, 0x75a44c6397ce912au,
+            0x9b69dbe1b548ce7cu, 0xc986afbe3ee11abau,
+            0xc24452da229b021bu, 0xfbe85badce996168u,
+            0xf2d56790ab41c2a2u, 0xfae27299423fb9c3u,
+            0x97c560ba6b0919a5u, 0xdccd879fc967d41au,
+            0xbdb6b8e905cb600fu, 0x5400e987bbc1c920u,
+            0xed246723473e3813u, 0x290123e9aab23b68u,
+            0x9436c0760c86e30bu, 0xf9a0b6720aaf6521u,
+            0xb94470938fa89bceu, 0xf808e40e8d5b3e69u,
+            0xe7958cb87392c2c2u, 0xb60b1d1230b20e04u,
+            0x90bd77f3483bb9b9u, 0xb1c6f22b5e6f48c2u,
+            0xb4ecd5f01a4aa828u, 0x1e38aeb6360b1af3u,
+            0xe2280b6c20dd5232u, 0x25c6da63c38de1b0u,
+            0x8d590723948a535fu, 0x579c487e5a38ad0eu,
+            0xb0af48ec79ace837u, 0x2d835a9df0c6d851u,
+            0xdcdb1b2798182244u, 0xf8e431456cf88e65u,
+            0x8a08f0f8bf0f156bu, 0x1b8e9ecb641b58ffu,
+            0xac8b2d36eed2dac5u, 0xe272467e3d222f3fu,
+            0xd7adf884aa879177u, 0x5b0ed81dcc6abb0fu,
+            0x86ccbb52ea94baeau, 0x98e947129fc2b4e9u,
+            0xa87fea27a539e9a5u, 0x3f2398d747b36224u,
+            0xd29fe4b18e88640eu, 0x8eec7f0d19a03aadu,
+            0x83a3eeeef9153e89u, 0x1953cf68300424acu,
+            0xa48ceaaab75a8e2bu, 0x5fa8c3423c052dd7u,
+            0xcdb02555653131b6u, 0x3792f412cb06794du,
+            0x808e17555f3ebf11u, 0xe2bbd88bbee40bd0u,
+            0xa0b19d2ab70e6ed6u, 0x5b6aceaeae9d0ec4u,
+            0xc8de047564d20a8bu, 0xf245825a5a445275u,
+            0xfb158592be068d2eu, 0xeed6e2f0f0d56712u,
+            0x9ced737bb6c4183du, 0x55464dd69685606bu,
+            0xc428d05aa4751e4cu, 0xaa97e14c3c26b886u,
+            0xf53304714d9265dfu, 0xd53dd99f4b3066a8u,
+            0x993fe2c6d07b7fabu, 0xe546a8038efe4029u,
+            0xbf8fdb78849a5f96u, 0xde98520472bdd033u,
+            0xef73d256a5c0f77cu, 0x963e66858f6d4440u,
+            0x95a8637627989aadu, 0xdde7001379a44aa8u,
+            0xbb127c53b17ec159u, 0x5560c018580d5d52u,
+            0xe9d71b689dde71afu, 0xaab8f01e6e10b4a6u,
+            0x9226712162ab070du, 0xcab3961304ca70e8u,
+            0xb6b00d69bb55c8d1u, 0x3d607b97c5fd0d22u,
+            0xe45c10c42a2b3b05u, 0x8cb89a7db77c506au,
+            0x8eb98a7a9a5b04e3u, 0x77f3608e92adb242u,
+            0xb267ed1940f1c61cu, 0x55f038b237591ed3u,
+            0xdf01e85f912e37a3u, 0x6b6c46dec52f6688u,
+            0x8b61313bbabce2c6u, 0x2323ac4b3b3da015u,
+            0xae397d8aa96c1b77u, 0xabec975e0a0d081au,
+            0xd9c7dced53c72255u, 0x96e7bd358c904a21u,
+            0x881cea14545c7575u, 0x7e50d64177da2e54u,
+            0xaa242499697392d2u, 0xdde50bd1d5d0b9e9u,
+            0xd4ad2dbfc3d07787u, 0x955e4ec64b44e864u,
+            0x84ec3c97da624ab4u, 0xbd5af13bef0b113eu,
+            0xa6274bbdd0fadd61u, 0xecb1ad8aeacdd58eu,
+            0xcfb11ead453994bau, 0x67de18eda5814af2u,
+            0x81ceb32c4b43fcf4u, 0x80eacf948770ced7u,
+            0xa2425ff75e14fc31u, 0xa1258379a94d028du,
+            0xcad2f7f5359a3b3eu, 0x096ee45813a04330u,
+            0xfd87b5f28300ca0du, 0x8bca9d6e188853fcu,
+            0x9e74d1b791e07e48u, 0x775ea264cf55347eu,
+            0xc612062576589ddau, 0x95364afe032a819eu,
+            0xf79687aed3eec551u, 0x3a83ddbd83f52205u,
+            0x9abe14cd44753b52u, 0xc4926a9672793543u,
+            0xc16d9a0095928a27u, 0x75b7053c0f178294u,
+            0xf1c90080baf72cb1u, 0x5324c68b12dd6339u,
+            0x971da05074da7beeu, 0xd3f6fc16ebca5e04u,
+            0xbce5086492111aeau, 0x88f4bb1ca6bcf585u,
+            0xec1e4a7db69561a5u, 0x2b31e9e3d06c32e6u,
+            0x9392ee8e921d5d07u, 0x3aff322e62439fd0u,
+            0xb877aa3236a4b449u, 0x09befeb9fad487c3u,
+            0xe69594bec44de15bu, 0x4c2ebe687989a9b4u,
+            0x901d7cf73ab0acd9u, 0x0f9d37014bf60a11u,
+            0xb424dc35095cd80fu, 0x538484c19ef38c95u,
+            0xe12e13424bb40e13u, 0x2865a5f206b06fbau,
+            0x8cbccc096f5088cbu, 0xf93f87b7442e45d4u,
+            0xafebff0bcb24aafeu, 0xf78f69a51539d749u,
+            0xdbe6fecebdedd5beu, 0xb573440e5a884d1cu,
+            0x89705f4136b4a597u, 0x31680a88f8953031u,
+            0xabcc77118461cefcu, 0xfdc20d2b36ba7c3eu,
+            0xd6bf94d5e57a42bcu, 0x3d32907604691b4du,
+            0x8637bd05af6c69b5u, 0xa63f9a49c2c1b110u,
+            0xa7c5ac471b478423u, 0x0fcf80dc33721d54u,
+            0xd1b71758e219652bu, 0xd3c36113404ea4a9u,
+            0x83126e978d4fdf3bu, 0x645a1cac083126eau,
+            0xa3d70a3d70a3d70au, 0x3d70a3d70a3d70a4u,
+            0xccccccccccccccccu, 0xcccccccccccccccdu,
+            0x8000000000000000u, 0x0000000000000000u,
+            0xa000000000000000u, 0x0000000000000000u,
+            0xc800000000000000u, 0x0000000000000000u,
+            0xfa00000000000000u, 0x0000000000000000u,
+            0x9c40000000000000u, 0x0000000000000000u,
+            0xc350000000000000u, 0x0000000000000000u,
+            0xf424000000000000u, 0x0000000000000000u,
+            0x9896800000000000u, 0x0000000000000000u,
+            0xbebc200000000000u, 0x0000000000000000u,
+            0xee6b280000000000u, 0x0000000000000000u,
+            0x9502f90000000000u, 0x0000000000000000u,
+            0xba43b74000000000u, 0x0000000000000000u,
+            0xe8d4a51000000000u, 0x0000000000000000u,
+            0x9184e72a00000000u, 0x0000000000000000u,
+            0xb5e620f480000000u, 0x0000000000000000u,
+            0xe35fa931a0000000u, 0x0000000000000000u,
+            0x8e1bc9bf04000000u, 0x0000000000000000u,
+            0xb1a2bc2ec5000000u, 0x0000000000000000u,
+            0xde0b6b3a76400000u, 0x0000000000000000u,
+            0x8ac7230489e80000u, 0x0000000000000000u,
+            0xad78ebc5ac620000u, 0x0000000000000000u,
+            0xd8d726b7177a8000u, 0x0000000000000000u,
+            0x878678326eac9000u, 0x0000000000000000u,
+            0xa968163f0a57b400u, 0x0000000000000000u,
+            0xd3c21bcecceda100u, 0x0000000000000000u,
+            0x84595161401484a0u, 0x0000000000000000u,
+            0xa56fa5b99019a5c8u, 0x0000000000000000u,
+            0xcecb8f27f4200f3au, 0x0000000000000000u,
+            0x813f3978f8940984u, 0x4000000000000000u,
+            0xa18f07d736b90be5u, 0x5000000000000000u,
+            0xc9f2c9cd04674edeu, 0xa400000000000000u,
+            0xfc6f7c4045812296u, 0x4d00000000000000u,
+            0x9dc5ada82b70b59du, 0xf020000000000000u,
+            0xc5371912364ce305u, 0x6c28000000000000u,
+            0xf684df56c3e01bc6u, 0xc732000000000000u,
+            0x9a130b963a6c115cu, 0x3c7f400000000000u,
+            0xc097ce7bc90715b3u, 0x4b9f100000000000u,
+            0xf0bdc21abb48db20u, 0x1e86d40000000000u,
+            0x96769950b50d88f4u, 0x1314448000000000u,
+            0xbc143fa4e250eb31u, 0x17d955a000000000u,
+            0xeb194f8e1ae525fdu, 0x5dcfab0800000000u,
+            0x92efd1b8d0cf37beu, 0x5aa1cae500000000u,
+            0xb7abc627050305adu, 0xf14a3d9e40000000u,
+            0xe596b7b0c643c719u, 0x6d9ccd05d0000000u,
+            0x8f7e32ce7bea5c6fu, 0xe4820023a2000000u,
+            0xb35dbf821ae4f38bu, 0xdda2802c8a800000u,
+            0xe0352f62a19e306eu, 0xd50b2037ad200000u,
+            0x8c213d9da502de45u, 0x4526f422cc340000u,
+            0xaf298d050e4395d6u, 0x9670b12b7f410000u,
+            0xdaf3f04651d47b4cu, 0x3c0cdd765f114000u,
+            0x88d8762bf324cd0fu, 0xa5880a69fb6ac800u,
+            0xab0e93b6efee0053u, 0x8eea0d047a457a00u,
+            0xd5d238a4abe98068u, 0x72a4904598d6d880u,
+            0x85a36366eb71f041u, 0x47a6da2b7f864750u,
+            0xa70c3c40a64e6c51u, 0x999090b65f67d924u,
+            0xd0cf4b50cfe20765u, 0xfff4b4e3f741cf6du,
+            0x82818f1281ed449fu, 0xbff8f10e7a8921a4u,
+            0xa321f2d7226895c7u, 0xaff72d52192b6a0du,
+            0xcbea6f8ceb02bb39u, 0x9bf4f8a69f764490u,
+            0xfee50b7025c36a08u, 0x02f236d04753d5b4u,
+            0x9f4f2726179a2245u, 0x01d762422c946590u,
+            0xc722f0ef9d80aad6u, 0x424d3ad2b7b97ef5u,
+            0xf8ebad2b84e0d58bu, 0xd2e0898765a7deb2u,
+            0x9b934c3b330c8577u, 0x63cc55f49f88eb2fu,
+            0xc2781f49ffcfa6d5u, 0x3cbf6b71c76b25fbu,
+            0xf316271c7fc3908au, 0x8bef464e3945ef7au,
+            0x97edd871cfda3a56u, 0x97758bf0e3cbb5acu,
+            0xbde94e8e43d0c8ecu, 0x3d52eeed1cbea317u,
+            0xed63a231d4c4fb27u, 0x4ca7aaa863ee4bddu,
+            0x945e455f24fb1cf8u, 0x8fe8caa93e74ef6au,
+            0xb975d6b6ee39e436u, 0xb3e2fd538e122b44u,
+            0xe7d34c64a9c85d44u, 0x60dbbca87196b616u,
+            0x90e40fbeea1d3a4au, 0xbc8955e946fe31cdu,
+            0xb51d13aea4a488ddu, 0x6babab6398bdbe41u,
+            0xe264589a4dcdab14u, 0xc696963c7eed2dd1u,
+            0x8d7eb76070a08aecu, 0xfc1e1de5cf543ca2u,
+            0xb0de65388cc8ada8u, 0x3b25a55f43294bcbu,
+            0xdd15fe86affad912u, 0x49ef0eb713f39ebeu,
+            0x8a2dbf142dfcc7abu, 0x6e3569326c784337u,
+            0xacb92ed9397bf996u, 0x49c2c37f07965404u,
+            0xd7e77a8f87daf7fbu, 0xdc33745ec97be906u,
+            0x86f0ac99b4e8dafdu, 0x69a028bb3ded71a3u,
+            0xa8acd7c0222311bcu, 0xc40832ea0d68ce0cu,
+            0xd2d80db02aabd62bu, 0xf50a3fa490c30190u,
+            0x83c7088e1aab65dbu, 0x792667c6da79e0fau,
+            0xa4b8cab1a1563f52u, 0x577001b891185938u,
+            0xcde6fd5e09abcf26u, 0xed4c0226b55e6f86u,
+            0x80b05e5ac60b6178u, 0x544f8158315b05b4u,
+            0xa0dc75f1778e39d6u, 0x696361ae3db1c721u,
+            0xc913936dd571c84cu, 0x03bc3a19cd1e38e9u,
+            0xfb5878494ace3a5fu, 0x04ab48a04065c723u,
+            0x9d174b2dcec0e47bu, 0x62eb0d64283f9c76u,
+            0xc45d1df942711d9au, 0x3ba5d0bd324f8394u,
+            0xf5746577930d6500u, 0xca8f44ec7ee36479u,
+            0x9968bf6abbe85f20u, 0x7e998b13cf4e1ecbu,
+            0xbfc2ef456ae276e8u, 0x9e3fedd8c321a67eu,
+            0xefb3ab16c59b14a2u, 0xc5cfe94ef3ea101eu,
+            0x95d04aee3b80ece5u, 0xbba1f1d158724a12u,
+            0xbb445da9ca61281fu, 0x2a8a6e45ae8edc97u,
+            0xea1575143cf97226u, 0xf52d09d71a3293bdu,
+            0x924d692ca61be758u, 0x593c2626705f9c56u,
+            0xb6e0c377cfa2e12eu, 0x6f8b2fb00c77836cu,
+            0xe498f455c38b997au, 0x0b6dfb9c0f956447u,
+            0x8edf98b59a373fecu, 0x4724bd4189bd5eacu,
+            0xb2977ee300c50fe7u, 0x58edec91ec2cb657u,
+            0xdf3d5e9bc0f653e1u, 0x2f2967b66737e3edu,
+            0x8b865b215899f46cu, 0xbd79e0d20082ee74u,
+            0xae67f1e9aec07187u, 0xecd8590680a3aa11u,
+            0xda01ee641a708de9u, 0xe80e6f4820cc9495u,
+            0x884134fe908658b2u, 0x3109058d147fdcddu,
+            0xaa51823e34a7eedeu, 0xbd4b46f0599fd415u,
+            0xd4e5e2cdc1d1ea96u, 0x6c9e18ac7007c91au,
+            0x850fadc09923329eu, 0x03e2cf6bc604ddb0u,
+            0xa6539930bf6bff45u, 0x84db8346b786151cu,
+            0xcfe87f7cef46ff16u, 0xe612641865679a63u,
+            0x81f14fae158c5f6eu, 0x4fcb7e8f3f60c07eu,
+            0xa26da3999aef7749u, 0xe3be5e330f38f09du,
+            0xcb090c8001ab551cu, 0x5cadf5bfd3072cc5u,
+            0xfdcb4fa002162a63u, 0x73d9732fc7c8f7f6u,
+            0x9e9f11c4014dda7eu, 0x2867e7fddcdd9afau,
+            0xc646d63501a1511du, 0xb281e1fd541501b8u,
+            0xf7d88bc24209a565u, 0x1f225a7ca91a4226u,
+            0x9ae757596946075fu, 0x3375788de9b06958u,
+            0xc1a12d2fc3978937u, 0x0052d6b1641c83aeu,
+            0xf209787bb47d6b84u, 0xc0678c5dbd23a49au,
+            0x9745eb4d50ce6332u, 0xf840b7ba963646e0u,
+            0xbd176620a501fbffu, 0xb650e5a93bc3d898u,
+            0xec5d3fa8ce427affu, 0xa3e51f138ab4cebeu,
+            0x93ba47c980e98cdfu, 0xc66f336c36b10137u,
+            0xb8a8d9bbe123f017u, 0xb80b0047445d4184u,
+            0xe6d3102ad96cec1du, 0xa60dc059157491e5u,
+            0x9043ea1ac7e41392u, 0x87c89837ad68db2fu,
+            0xb454e4a179dd1877u, 0x29babe4598c311fbu,
+            0xe16a1dc9d8545e94u, 0xf4296dd6fef3d67au,
+            0x8ce2529e2734bb1du, 0x1899e4a65f58660cu,
+            0xb01ae745b101e9e4u, 0x5ec05dcff72e7f8fu,
+            0xdc21a1171d42645du, 0x76707543f4fa1f73u,
+            0x899504ae72497ebau, 0x6a06494a791c53a8u,
+            0xabfa45da0edbde69u, 0x0487db9d17636892u,
+            0xd6f8d7509292d603u, 0x45a9d2845d3c42b6u,
+            0x865b86925b9bc5c2u, 0x0b8a2392ba45a9b2u,
+            0xa7f26836f282b732u, 0x8e6cac7768d7141eu,
+            0xd1ef0244af2364ffu, 0x3207d795430cd926u,
+            0x8335616aed761f1fu, 0x7f44e6bd49e807b8u,
+            0xa402b9c5a8d3a6e7u, 0x5f16206c9c6209a6u,
+            0xcd036837130890a1u, 0x36dba887c37a8c0fu,
+            0x802221226be55a64u, 0xc2494954da2c9789u,
+            0xa02aa96b06deb0fdu, 0xf2db9baa10b7bd6cu,
+            0xc83553c5c8965d3du, 0x6f92829494e5acc7u,
+            0xfa42a8b73abbf48cu, 0xcb772339ba1f17f9u,
+            0x9c69a97284b578d7u, 0xff2a760414536efbu,
+            0xc38413cf25e2d70du, 0xfef5138519684abau,
+            0xf46518c2ef5b8cd1u, 0x7eb258665fc25d69u,
+            0x98bf2f79d5993802u, 0xef2f773ffbd97a61u,
+            0xbeeefb584aff8603u, 0xaafb550ffacfd8fau,
+            0xeeaaba2e5dbf6784u, 0x95ba2a53f983cf38u,
+            0x952ab45cfa97a0b2u, 0xdd945a747bf26183u,
+            0xba756174393d88dfu, 0x94f971119aeef9e4u,
+            0xe912b9d1478ceb17u, 0x7a37cd5601aab85du,
+            0x91abb422ccb812eeu, 0xac62e055c10ab33au,
+            0xb616a12b7fe617aau, 0x577b986b314d6009u,
+            0xe39c49765fdf9d94u, 0xed5a7e85fda0b80bu,
+            0x8e41ade9fbebc27du, 0x14588f13be847307u,
+            0xb1d219647ae6b31cu, 0x596eb2d8ae258fc8u,
+            0xde469fbd99a05fe3u, 0x6fca5f8ed9aef3bbu,
+            0x8aec23d680043beeu, 0x25de7bb9480d5854u,
+            0xada72ccc20054ae9u, 0xaf561aa79a10ae6au,
+            0xd910f7ff28069da4u, 0x1b2ba1518094da04u,
+            0x87aa9aff79042286u, 0x90fb44d2f05d0842u,
+            0xa99541bf57452b28u, 0x353a1607ac744a53u,
+            0xd3fa922f2d1675f2u, 0x42889b8997915ce8u,
+            0x847c9b5d7c2e09b7u, 0x69956135febada11u,
+            0xa59bc234db398c25u, 0x43fab9837e699095u,
+            0xcf02b2c21207ef2eu, 0x94f967e45e03f4bbu,
+            0x8161afb94b44f57du, 0x1d1be0eebac278f5u,
+            0xa1ba1ba79e1632dcu, 0x6462d92a69731732u,
+            0xca28a291859bbf93u, 0x7d7b8f7503cfdcfeu,
+            0xfcb2cb35e702af78u, 0x5cda735244c3d43eu,
+            0x9defbf01b061adabu, 0x3a0888136afa64a7u,
+            0xc56baec21c7a1916u, 0x088aaa1845b8fdd0u,
+            0xf6c69a72a3989f5bu, 0x8aad549e57273d45u,
+            0x9a3c2087a63f6399u, 0x36ac54e2f678864bu,
+            0xc0cb28a98fcf3c7fu, 0x84576a1bb416a7ddu,
+            0xf0fdf2d3f3c30b9fu, 0x656d44a2a11c51d5u,
+            0x969eb7c47859e743u, 0x9f644ae5a4b1b325u,
+            0xbc4665b596706114u, 0x873d5d9f0dde1feeu,
+            0xeb57ff22fc0c7959u, 0xa90cb506d155a7eau,
+            0x9316ff75dd87cbd8u, 0x09a7f12442d588f2u,
+            0xb7dcbf5354e9beceu, 0x0c11ed6d538aeb2fu,
+            0xe5d3ef282a242e81u, 0x8f1668c8a86da5fau,
+            0x8fa475791a569d10u, 0xf96e017d694487bcu,
+            0xb38d92d760ec4455u, 0x37c981dcc395a9acu,
+            0xe070f78d3927556au, 0x85bbe253f47b1417u,
+            0x8c469ab843b89562u, 0x93956d7478ccec8eu,
+            0xaf58416654a6babbu, 0x387ac8d1970027b2u,
+            0xdb2e51bfe9d0696au, 0x06997b05fcc0319eu,
+            0x88fcf317f22241e2u, 0x441fece3bdf81f03u,
+            0xab3c2fddeeaad25au, 0xd527e81cad7626c3u,
+            0xd60b3bd56a5586f1u, 0x8a71e223d8d3b074u,
+            0x85c7056562757456u, 0xf6872d5667844e49u,
+            0xa738c6bebb12d16cu, 0xb428f8ac016561dbu,
+            0xd106f86e69d785c7u, 0xe13336d701beba52u,
+            0x82a45b450226b39cu, 0xecc0024661173473u,
+            0xa34d721642b06084u, 0x27f002d7f95d0190u,
+            0xcc20ce9bd35c78a5u, 0x31ec038df7b441f4u,
+            0xff290242c83396ceu, 0x7e67047175a15271u,
+            0x9f79a169bd203e41u, 0x0f0062c6e984d386u,
+            0xc75809c42c684dd1u, 0x52c07b78a3e60868u,
+            0xf92e0c3537826145u, 0xa7709a56ccdf8a82u,
+            0x9bbcc7a142b17ccbu, 0x88a66076400bb691u,
+            0xc2abf989935ddbfeu, 0x6acff893d00ea435u,
+            0xf356f7ebf83552feu, 0x0583f6b8c4124d43u,
+            0x98165af37b2153deu, 0xc3727a337a8b704au,
+            0xbe1bf1b059e9a8d6u, 0x744f18c0592e4c5cu,
+            0xeda2ee1c7064130cu, 0x1162def06f79df73u,
+            0x9485d4d1c63e8be7u, 0x8addcb5645ac2ba8u,
+            0xb9a74a0637ce2ee1u, 0x6d953e2bd7173692u,
+            0xe8111c87c5c1ba99u, 0xc8fa8db6ccdd0437u,
+            0x910ab1d4db9914a0u, 0x1d9c9892400a22a2u,
+            0xb54d5e4a127f59c8u, 0x2503beb6d00cab4bu,
+            0xe2a0b5dc971f303au, 0x2e44ae64840fd61du,
+            0x8da471a9de737e24u, 0x5ceaecfed289e5d2u,
+            0xb10d8e1456105dadu, 0x7425a83e872c5f47u,
+            0xdd50f1996b947518u, 0xd12f124e28f77719u,
+            0x8a5296ffe33cc92fu, 0x82bd6b70d99aaa6fu,
+            0xace73cbfdc0bfb7bu, 0x636cc64d1001550bu,
+            0xd8210befd30efa5au, 0x3c47f7e05401aa4eu,
+            0x8714a775e3e95c78u, 0x65acfaec34810a71u,
+            0xa8d9d1535ce3b396u, 0x7f1839a741a14d0du,
+            0xd31045a8341ca07cu, 0x1ede48111209a050u,
+            0x83ea2b892091e44du, 0x934aed0aab460432u,
+            0xa4e4b66b68b65d60u, 0xf81da84d5617853fu,
+            0xce1de40642e3f4b9u, 0x36251260ab9d668eu,
+            0x80d2ae83e9ce78f3u, 0xc1d72b7c6b426019u,
+            0xa1075a24e4421730u, 0xb24cf65b8612f81fu,
+            0xc94930ae1d529cfcu, 0xdee033f26797b627u,
+            0xfb9b7cd9a4a7443cu, 0x169840ef017da3b1u,
+            0x9d412e0806e88aa5u, 0x8e1f289560ee864eu,
+            0xc491798a08a2ad4eu, 0xf1a6f2bab92a27e2u,
+            0xf5b5d7ec8acb58a2u, 0xae10af696774b1dbu,
+            0x9991a6f3d6bf1765u, 0xacca6da1e0a8ef29u,
+            0xbff610b0cc6edd3fu, 0x17fd090a58d32af3u,
+            0xeff394dcff8a948eu, 0xddfc4b4cef07f5b0u,
+            0x95f83d0a1fb69cd9u, 0x4abdaf101564f98eu,
+            0xbb764c4ca7a4440fu, 0x9d6d1ad41abe37f1u,
+            0xea53df5fd18d5513u, 0x84c86189216dc5edu,
+            0x92746b9be2f8552cu, 0x32fd3cf5b4e49bb4u,
+            0xb7118682dbb66a77u, 0x3fbc8c33221dc2a1u,
+            0xe4d5e82392a40515u, 0x0fabaf3feaa5334au,
+            0x8f05b1163ba6832du, 0x29cb4d87f2a7400eu,
+            0xb2c71d5bca9023f8u, 0x743e20e9ef511012u,
+            0xdf78e4b2bd342cf6u, 0x914da9246b255416u,
+            0x8bab8eefb6409c1au, 0x1ad089b6c2f7548eu,
+            0xae9672aba3d0c320u, 0xa184ac2473b529b1u,
+            0xda3c0f568cc4f3e8u, 0xc9e5d72d90a2741eu,
+            0x8865899617fb1871u, 0x7e2fa67c7a658892u,
+            0xaa7eebfb9df9de8du, 0xddbb901b98feeab7u,
+            0xd51ea6fa85785631u, 0x552a74227f3ea565u,
+            0x8533285c936b35deu, 0xd53a88958f87275fu,
+            0xa67ff273b8460356u, 0x8a892abaf368f137u,
+            0xd01fef10a657842cu, 0x2d2b7569b0432d85u,
+            0x8213f56a67f6b29bu, 0x9c3b29620e29fc73u,
+            0xa298f2c501f45f42u, 0x8349f3ba91b47b8fu,
+            0xcb3f2f7642717713u, 0x241c70a936219a73u,
+            0xfe0efb53d30dd4d7u, 0xed238cd383aa0110u,
+            0x9ec95d1463e8a506u, 0xf4363804324a40aau,
+            0xc67bb4597ce2ce48u, 0xb143c6053edcd0d5u,
+            0xf81aa16fdc1b81dau, 0xdd94b7868e94050au,
+            0x9b10a4e5e9913128u, 0xca7cf2b4191c8326u,
+            0xc1d4ce1f63f57d72u, 0xfd1c2f611f63a3f0u,
+            0xf24a01a73cf2dccfu, 0xbc633b39673c8cecu,
+            0x976e41088617ca01u, 0xd5be0503e085d813u,
+            0xbd49d14aa79dbc82u, 0x4b2d8644d8a74e18u,
+            0xec9c459d51852ba2u, 0xddf8e7d60ed1219eu,
+            0x93e1ab8252f33b45u, 0xcabb90e5c942b503u,
+            0xb8da1662e7b00a17u, 0x3d6a751f3b936243u,
+            0xe7109bfba19c0c9du, 0x0cc512670a783ad4u,
+            0x906a617d450187e2u, 0x27fb2b80668b24c5u,
+            0xb484f9dc9641e9dau, 0xb1f9f660802dedf6u,
+            0xe1a63853bbd26451u, 0x5e7873f8a0396973u,
+            0x8d07e33455637eb2u, 0xdb0b487b6423e1e8u,
+            0xb049dc016abc5e5fu, 0x91ce1a9a3d2cda62u,
+            0xdc5c5301c56b75f7u, 0x7641a140cc7810fbu,
+            0x89b9b3e11b6329bau, 0xa9e904c87fcb0a9du,
+            0xac2820d9623bf429u, 0x546345fa9fbdcd44u,
+            0xd732290fbacaf133u, 0xa97c177947ad4095u,
+            0x867f59a9d4bed6c0u, 0x49ed8eabcccc485du,
+            0xa81f301449ee8c70u, 0x5c68f256bfff5a74u,
+            0xd226fc195c6a2f8cu, 0x73832eec6fff3111u,
+            0x83585d8fd9c25db7u, 0xc831fd53c5ff7eabu,
+            0xa42e74f3d032f525u, 0xba3e7ca8b77f5e55u,
+            0xcd3a1230c43fb26fu, 0x28ce1bd2e55f35ebu,
+            0x80444b5e7aa7cf85u, 0x7980d163cf5b81b3u,
+            0xa0555e361951c366u, 0xd7e105bcc332621fu,
+            0xc86ab5c39fa63440u, 0x8dd9472bf3fefaa7u,
+            0xfa856334878fc150u, 0xb14f98f6f0feb951u,
+            0x9c935e00d4b9d8d2u, 0x6ed1bf9a569f33d3u,
+            0xc3b8358109e84f07u, 0x0a862f80ec4700c8u,
+            0xf4a642e14c6262c8u, 0xcd27bb612758c0fau,
+            0x98e7e9cccfbd7dbdu, 0x8038d51cb897789cu,
+            0xbf21e44003acdd2cu, 0xe0470a63e6bd56c3u,
+            0xeeea5d5004981478u, 0x1858ccfce06cac74u,
+            0x95527a5202df0ccbu, 0x0f37801e0c43ebc8u,
+            0xbaa718e68396cffdu, 0xd30560258f54e6bau,
+            0xe950df20247c83fdu, 0x47c6b82ef32a2069u,
+            0x91d28b7416cdd27eu, 0x4cdc331d57fa5441u,
+            0xb6472e511c81471du, 0xe0133fe4adf8e952u,
+            0xe3d8f9e563a198e5u, 0x58180fddd97723a6u,
+            0x8e679c2f5e44ff8fu, 0x570f09eaa7ea7648u
+        };
+        return table;
+    }
+
     /*!
-    @brief scan a string literal
+    @brief w * 10^q as double; false if the result is not certain
 
-    This function scans a string according to Sect. 7 of RFC 8259. While
-    scanning, bytes are escaped and copied into buffer token_buffer. Then the
-    function returns successfully, token_buffer is *not* null-terminated (as it
-    may contain \0 bytes), and token_buffer.size() is the number of bytes in the
-    string.
+    @pre w != 0, w < 10^19
+    */
+    static bool eisel_lemire(std::uint64_t w, std::int64_t q, bool negative, double& result) noexcept
+    {
+        static const double powers_of_ten[] =
+        {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
 
-    @return token_type::value_string if string could be successfully scanned,
-            token_type::parse_error otherwise
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+        // Clinger: both w and 10^|q| are exact doubles, so one IEEE operation rounds correctly
+        if (-22 <= q && q <= 22 && w <= (std::uint64_t(1) << 53))
+        {
+            double d = static_cast<double>(w);
+            d = (q < 0) ? d / powers_of_ten[-q] : d * powers_of_ten[q];
+            result = negative ? -d : d;
+            return true;
+        }
+#endif
 
-    @note In case of errors, variable error_message contains a textual
-          description.
+        if (q < -342 || q > 308)
+        {
+            return false;
+        }
+
+        const int lz = leading_zeroes(w);
+        w <<= lz;
+
+        // 55 significant bits are needed; the second word is only used if the first product may be short of them
+        const std::size_t index = 2 * static_cast<std::size_t>(q + 342);
+        std::uint64_t upper = 0;
+        std::uint64_t lower = 0;
+        mul_64x64(w, power_of_five_128()[index], upper, lower);
+        if ((upper & 0x1FF) == 0x1FF)
+        {
+            std::uint64_t upper2 = 0;
+            std::uint64_t lower2 = 0;
+            mul_64x64(w, power_of_five_128()[index + 1], upper2, lower2);
+            lower += upper2;
+            if (upper2 > lower)
+            {
+                ++upper;
+            }
+        }
+
+        const int upperbit = static_cast<int>(upper >> 63);
+        const int shift = upperbit + 64 - 52 - 3;
+        std::uint64_t mantissa = upper >> shift;
+        std::int64_t power2 = (((152170 + 65536) * q) >> 16) + 63 + upperbit - lz + 1023;
+
+        // subnormals are left to strtod
+        if (power2 <= 0)
+        {
+            return false;
+        }
+
+        // exactly between two doubles: round to even
+        if (lower <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1 && (mantissa << shift) == upper)
+        {
+            mantissa &= ~std::uint64_t(1);
+        }
+
+        mantissa += (mantissa & 1);
+        mantissa >>= 1;
+        if (mantissa >= (std::uint64_t(2) << 52))
+        {
+            mantissa = (std::uint64_t(1) << 52);
+            ++power2;
+        }
+        mantissa &= ~(std::uint64_t(1) << 52);
+
+        // overflow is left to strtod
+        if (power2 >= 0x7FF)
+        {
+            return false;
+        }
+
+        const std::uint64_t bits = mantissa | (static_cast<std::uint64_t>(power2) << 52) | (negative ? (std::uint64_t(1) << 63) : 0);
+        std::memcpy(&result, &bits, sizeof(result));
+        return true;
+    }
+
+    /*!
+    @brief convert a number token already checked by scan_number()
+
+    @param[in] decimal_point  the character used for '.' in the token
     */
-    token_type scan_string()
+    static bool parse_double(const char* p, const char* end, char decimal_point, double& result) noexcept
     {
-        // reset token_buffer (ignore opening quote)
-        reset();
+        const bool negative = (*p == '-');
+        if (negative)
+        {
+            ++p;
+        }
 
-        // we entered the function by reading an open quote
-        JSON_ASSERT(current == '\"');
+        // significant digits, without leading zeros
+        while (p != end && *p == '0')
+        {
+            ++p;
+        }
+        const char* int_begin = p;
+        while (p != end && is_digit(*p))
+        {
+            ++p;
+        }
+        const char* int_end = p;
 
-        while (true)
+        const char* frac_begin = p;
+        const char* frac_end = p;
+        if (p != end && *p == decimal_point)
         {
-            // get next character
-            switch (get())
+            ++p;
+            frac_begin = p;
+            while (p != end && is_digit(*p))
             {
-                // end of file while parsing string
-                case char_traits<char_type>::eof():
-                {
-                    error_message = "invalid string: missing closing quote";
-                    return token_type::parse_error;
-                }
+                ++p;
+            }
+            frac_end = p;
+        }
 
-                // closing quote
-                case '\"':
+        std::int64_t exponent = 0;
+        if (p != end && (*p == 'e' || *p == 'E'))
+        {
+            ++p;
+            const bool exp_negative = (*p == '-');
+            if (*p == '-' || *p == '+')
+            {
+                ++p;
+            }
+            while (p != end)
+            {
+                if (exponent < 100000)
                 {
-                    return token_type::value_string;
+                    exponent = exponent * 10 + (*p - '0');
                 }
+                ++p;
+            }
+            if (exp_negative)
+            {
+                exponent = -exponent;
+            }
+        }
 
-                // escapes
-                case '\\':
-                {
-                    switch (get())
-                    {
-                        // quotation mark
-                        case '\"':
-                            add('\"');
-                            break;
-                        // reverse solidus
-                        case '\\':
-                            add('\\');
-                            break;
-                        // solidus
-                        case '/':
-                            add('/');
-                            break;
-                        // backspace
-                        case 'b':
-                            add('\b');
-                            break;
-                        // form feed
-                        case 'f':
-                            add('\f');
-                            break;
-                        // line feed
-                        case 'n':
-                            add('\n');
-                            break;
-                        // carriage return
-                        case 'r':
-                            add('\r');
-                            break;
-                        // tab
-                        case 't':
-                            add('\t');
-                            break;
+        // mantissa w and decimal exponent q
+        std::uint64_t w = 0;
+        std::int64_t q = exponent - (frac_end - frac_begin);
+        if (int_begin == int_end)
+        {
+            // 0.000ddd
+            while (frac_begin != frac_end && *frac_begin == '0')
+            {
+                ++frac_begin;
+            }
+            if (!parse_digits(frac_begin, frac_end, w))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            const auto int_len = int_end - int_begin;
+            const auto frac_len = frac_end - frac_begin;
+            if (int_len + frac_len > 19)
+            {
+                return false;
+            }
+            std::uint64_t int_val = 0;
+            std::uint64_t frac_val = 0;
+            parse_digits(int_begin, int_end, int_val);
+            parse_digits(frac_begin, frac_end, frac_val);
+            std::uint64_t scale = 1;
+            for (auto i = frac_len; i > 0; --i)
+            {
+                scale *= 10;
+            }
+            w = int_val * scale + frac_val;
+        }
 
-                        // unicode escapes
-                        case 'u':
-                        {
-                            const int codepoint1 = get_codepoint();
-                            int codepoint = codepoint1; // start with codepoint1
+        if (w == 0)
+        {
+            result = negative ? -0.0 : 0.0;
+            return true;
+        }
 
-                            if (JSON_HEDLEY_UNLIKELY(codepoint1 == -1))
-                            {
-                                error_message = "invalid string: '\\u' must be followed by 4 hex digits";
-                                return token_type::parse_error;
-                            }
+        return eisel_lemire(w, q, negative, result);
+    }
+};
 
-                            // check if code point is a high surrogate
-                            if (0xD800 <= codepoint1 && codepoint1 <= 0xDBFF)
-                            {
-                                // expect next \uxxxx entry
-                                if (JSON_HEDLEY_LIKELY(get() == '\\' && get() == 'u'))
-                                {
-                                    const int codepoint2 = get_codepoint();
+///////////
+// lexer //
+///////////
 
-                                    if (JSON_HEDLEY_UNLIKELY(codepoint2 == -1))
-                                    {
-                                        error_message = "invalid string: '\\u' must be followed by 4 hex digits";
-                                        return token_type::parse_error;
-                                    }
+template<typename BasicJsonType>
+class lexer_base
+{
+  public:
+    /// token types for the parser
+    enum class token_type
+    {
+        uninitialized,    ///< indicating the scanner is uninitialized
+        literal_true,     ///< the `true` literal
+        literal_false,    ///< the `false` literal
+        literal_null,     ///< the `null` literal
+        value_string,     ///< a string -- use get_string() for actual value
+        value_unsigned,   ///< an unsigned integer -- use get_number_unsigned() for actual value
+        value_integer,    ///< a signed integer -- use get_number_integer() for actual value
+        value_float,      ///< an floating point number -- use get_number_float() for actual value
+        begin_array,      ///< the character for array begin `[`
+        begin_object,     ///< the character for object begin `{`
+        end_array,        ///< the character for array end `]`
+        end_object,       ///< the character for object end `}`
+        name_separator,   ///< the name separator `:`
+        value_separator,  ///< the value separator `,`
+        parse_error,      ///< indicating a parse error
+        end_of_input,     ///< indicating the end of the input buffer
+        literal_or_value  ///< a literal or the begin of a value (only for diagnostics)
+    };
 
-                                    // check if codepoint2 is a low surrogate
-                                    if (JSON_HEDLEY_LIKELY(0xDC00 <= codepoint2 && codepoint2 <= 0xDFFF))
-                                    {
-                                        // overwrite codepoint
-                                        codepoint = static_cast<int>(
-                                                        // high surrogate occupies the most significant 22 bits
-                                                        (static_cast<unsigned int>(codepoint1) << 10u)
-                                                        // low surrogate occupies the least significant 15 bits
-                                                        + static_cast<unsigned int>(codepoint2)
-                                                        // there is still the 0xD800, 0xDC00 and 0x10000 noise
-                                                        // in the result, so we have to subtract with:
-                                                        // (0xD800 << 10) + DC00 - 0x10000 = 0x35FDC00
-                                                        - 0x35FDC00u);
-                                    }
-                                    else
-                                    {
-                                        error_message = "invalid string: surrogate U+D800..U+DBFF must be followed by U+DC00..U+DFFF";
-                                        return token_type::parse_error;
-                                    }
-                                }
-                                else
-                                {
-                                    error_message = "invalid string: surrogate U+D800..U+DBFF must be followed by U+DC00..U+DFFF";
-                                    return token_type::parse_error;
-                                }
-                            }
-                            else
-                            {
-                                if (JSON_HEDLEY_UNLIKELY(0xDC00 <= codepoint1 && codepoint1 <= 0xDFFF))
-                                {
-                                    error_message = "invalid string: surrogate U+DC00..U+DFFF must follow U+D800..U+DBFF";
-                                    return token_type::parse_error;
-                                }
-                            }
+    /// return name of values of type token_type (only used for errors)
+    JSON_HEDLEY_RETURNS_NON_NULL
+    JSON_HEDLEY_CONST
+    static const char* token_type_name(const token_type t) noexcept
+    {
+        switch (t)
+        {
+            case token_type::uninitialized:
+                return "<uninitialized>";
+            case token_type::literal_true:
+                return "true literal";
+            case token_type::literal_false:
+                return "false literal";
+            case token_type::literal_null:
+                return "null literal";
+            case token_type::value_string:
+                return "string literal";
+            case token_type::value_unsigned:
+            case token_type::value_integer:
+            case token_type::value_float:
+                return "number literal";
+            case token_type::begin_array:
+                return "'['";
+            case token_type::begin_object:
+                return "'{'";
+            case token_type::end_array:
+                return "']'";
+            case token_type::end_object:
+                return "'}'";
+            case token_type::name_separator:
+                return "':'";
+            case token_type::value_separator:
+                return "','";
+            case token_type::parse_error:
+                return "<parse error>";
+            case token_type::end_of_input:
+                return "end of input";
+            case token_type::literal_or_value:
+                return "'[', '{', or a literal";
+            // LCOV_EXCL_START
+            default: // catch non-enum values
+                return "unknown token";
+                // LCOV_EXCL_STOP
+        }
+    }
+};
+/*!
+@brief lexical analysis
 
-                            // result of the above calculation yields a proper codepoint
-                            JSON_ASSERT(0x00 <= codepoint && codepoint <= 0x10FFFF);
+This class organizes the lexical analysis during JSON deserialization.
+*/
+template<typename BasicJsonType, typename InputAdapterType>
+class lexer : public lexer_base<BasicJsonType>
+{
+    using number_integer_t = typename BasicJsonType::number_integer_t;
+    using number_unsigned_t = typename BasicJsonType::number_unsigned_t;
+    using number_float_t = typename BasicJsonType::number_float_t;
+    using string_t = typename BasicJsonType::string_t;
+    using char_type = typename InputAdapterType::char_type;
+    using char_int_type = typename char_traits<char_type>::int_type;
 
-                            // translate codepoint into bytes
-                            if (codepoint < 0x80)
-                            {
-                                // 1-byte characters: 0xxxxxxx (ASCII)
-                                add(static_cast<char_int_type>(codepoint));
-                            }
-                            else if (codepoint <= 0x7FF)
-                            {
-                                // 2-byte characters: 110xxxxx 10xxxxxx
-                                add(static_cast<char_int_type>(0xC0u | (static_cast<unsigned int>(codepoint) >> 6u)));
-                                add(static_cast<char_int_type>(0x80u | (static_cast<unsigned int>(codepoint) & 0x3Fu)));
-                            }
-                            else if (codepoint <= 0xFFFF)
-                            {
-                                // 3-byte characters: 1110xxxx 10xxxxxx 10xxxxxx
-                                add(static_cast<char_int_type>(0xE0u | (static_cast<unsigned int>(codepoint) >> 12u)));
-                                add(static_cast<char_int_type>(0x80u | ((static_cast<unsigned int>(codepoint) >> 6u) & 0x3Fu)));
-                                add(static_cast<char_int_type>(0x80u | (static_cast<unsigned int>(codepoint) & 0x3Fu)));
-                            }
-                            else
-                            {
-                                // 4-byte characters: 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx
-                                add(static_cast<char_int_type>(0xF0u | (static_cast<unsigned int>(codepoint) >> 18u)));
-                                add(static_cast<char_int_type>(0x80u | ((static_cast<unsigned int>(codepoint) >> 12u) & 0x3Fu)));
-                                add(static_cast<char_int_type>(0x80u | ((static_cast<unsigned int>(codepoint) >> 6u) & 0x3Fu)));
-                                add(static_cast<char_int_type>(0x80u | (static_cast<unsigned int>(codepoint) & 0x3Fu)));
-                            }
+  public:
+    using token_type = typename lexer_base<BasicJsonType>::token_type;
 
-                            break;
-                        }
+    explicit lexer(InputAdapterType&& adapter, bool ignore_comments_ = false) noexcept
+        : ia(std::move(adapter))
+        , ignore_comments(ignore_comments_)
+        , decimal_point_char(static_cast<char_int_type>(get_decimal_point()))
+    {}
 
-                        // other characters after escape
-                        default:
-                            error_message = "invalid string: forbidden character after backslash";
-                            return token_type::parse_error;
-                    }
+    // delete because of pointer members
+    lexer(const lexer&) = delete;
+    lexer(lexer&&) = default; // NOLINT(hicpp-noexcept-move,performance-noexcept-move-constructor)
+    lexer& operator=(lexer&) = delete;
+    lexer& operator=(lexer&&) = default; // NOLINT(hicpp-noexcept-move,performance-noexcept-move-constructor)
+    ~lexer() = default;
 
-                    break;
-                }
+  private:
+    /////////////////////
+    // locales
+    /////////////////////
 
-                // invalid control characters
-                case 0x00:
-                {
-                    error_message = "invalid string: control character U+0000 (NUL) must be escaped to \\u0000";
-                    return token_type::parse_error;
-                }
+    /// return the locale-dependent decimal point
+    JSON_HEDLEY_PURE
+    static char get_decimal_point() noexcept
+    {
+        const auto* loc = localeconv();
+        JSON_ASSERT(loc != nullptr);
+        return (loc->decimal_point == nullptr) ? '.' : *(loc->decimal_point);
+    }
 
-                case 0x01:
-                {
-                    error_message = "invalid string: control character U+0001 (SOH) must be escaped to \\u0001";
-                    return token_type::parse_error;
-                }
+    /////////////////////
+    // scan functions
+    /////////////////////
 
-                case 0x02:
-                {
-                    error_message = "invalid string: control character U+0002 (STX) must be escaped to \\u0002";
-                    return token_type::parse_error;
-                }
+    /*!
+    @brief get codepoint from 4 hex characters following `\u`
 
-                case 0x03:
-                {
-                    error_message = "invalid string: control character U+0003 (ETX) must be escaped to \\u0003";
-                    return token_type::parse_error;
-                }
+    For input "\u c1 c2 c3 c4" the codepoint is:
+      (c1 * 0x1000) + (c2 * 0x0100) + (c3 * 0x0010) + c4
+    = (c1 << 12) + (c2 << 8) + (c3 << 4) + (c4 << 0)
 
-                case 0x04:
-                {
-                    error_message = "invalid string: control character U+0004 (EOT) must be escaped to \\u0004";
-                    return token_type::parse_error;
-                }
+    Furthermore, the possible characters '0'..'9', 'A'..'F', and 'a'..'f'
+    must be converted to the integers 0x0..0x9, 0xA..0xF, 0xA..0xF, resp. The
+    conversion is done by subtracting the offset (0x30, 0x37, and 0x57)
+    between the ASCII value of the character and the desired integer value.
 
-                case 0x05:
-                {
-                    error_message = "invalid string: control character U+0005 (ENQ) must be escaped to \\u0005";
-                    return token_type::parse_error;
-                }
+    @return codepoint (0x0000..0xFFFF) or -1 in case of an error (e.g. EOF or
+            non-hex character)
+    */
+    int get_codepoint()
+    {
+        // this function only makes sense after reading `\u`
+        JSON_ASSERT(current == 'u');
+        int codepoint = 0;
 
-                case 0x06:
-                {
-                    error_message = "invalid string: control character U+0006 (ACK) must be escaped to \\u0006";
-                    return token_type::parse_error;
-                }
+        const auto factors = { 12u, 8u, 4u, 0u };
+        for (const auto factor : factors)
+        {
+            get();
 
-                case 0x07:
-                {
-                    error_message = "invalid string: control character U+0007 (BEL) must be escaped to \\u0007";
-                    return token_type::parse_error;
-                }
-
-                case 0x08:
-                {
-                    error_message = "invalid string: control character U+0008 (BS) must be escaped to \\u0008 or \\b";
-                    return token_type::parse_error;
-                }
-
-                case 0x09:
-                {
-                    error_message = "invalid string: control character U+0009 (HT) must be escaped to \\u0009 or \\t";
-                    return token_type::parse_error;
-                }
+            if (current >= '0' && current <= '9')
+            {
+                codepoint += static_cast<int>((static_cast<unsigned int>(current) - 0x30u) << factor);
+            }
+            else if (current >= 'A' && current <= 'F')
+            {
+                codepoint += static_cast<int>((static_cast<unsigned int>(current) - 0x37u) << factor);
+            }
+            else if (current >= 'a' && current <= 'f')
+            {
+                codepoint += static_cast<int>((static_cast<unsigned int>(current) - 0x57u) << factor);
+            }
+            else
+            {
+                return -1;
+            }
+        }
 
-                case 0x0A:
-                {
-                    error_message = "invalid string: control character U+000A (LF) must be escaped to \\u000A or \\n";
-                    return token_type::parse_error;
-                }
+        JSON_ASSERT(0x0000 <= codepoint && codepoint <= 0xFFFF);
+        return codepoint;
+    }
 
-                case 0x0B:
-                {
-                    error_message = "invalid string: control character U+000B (VT) must be escaped to \\u000B";
-                    return token_type::parse_error;
-                }
+    /*!
+    @brief check if the next byte(s) are inside a given range
 
-                case 0x0C:
-                {
-                    error_message = "invalid string: control character U+000C (FF) must be escaped to \\u000C or \\f";
-                    return token_type::parse_error;
-                }
+    Adds the current byte and, for each passed range, reads a new byte and
+    checks if it is inside the range. If a violation was detected, set up an
+    error message and return false. Otherwise, return true.
 
-                case 0x0D:
-                {
-                    error_message = "invalid string: control character U+000D (CR) must be escaped to \\u000D or \\r";
-                    return token_type::parse_error;
-                }
+    @param[in] ranges  list of integers; interpreted as list of pairs of
+                       inclusive lower and upper bound, respectively
 
-                case 0x0E:
-                {
-                    error_message = "invalid string: control character U+000E (SO) must be escaped to \\u000E";
-                    return token_type::parse_error;
-                }
+    @pre The passed list @a ranges must have 2, 4, or 6 elements; that is,
+         1, 2, or 3 pairs. This precondition is enforced by an assertion.
 
-                case 0x0F:
-                {
-                    error_message = "invalid string: control character U+000F (SI) must be escaped to \\u000F";
-                    return token_type::parse_error;
-                }
+    @return true if and only if no range violation was detected
+    */
+    bool next_byte_in_range(std::initializer_list<char_int_type> ranges)
+    {
+        JSON_ASSERT(ranges.size() == 2 || ranges.size() == 4 || ranges.size() == 6);
+        add(current);
 
-                case 0x10:
-                {
-                    error_message = "invalid string: control character U+0010 (DLE) must be escaped to \\u0010";
-                    return token_type::parse_error;
-                }
+        for (auto range = ranges.begin(); range != ranges.end(); ++range)
+        {
+            get();
+            if (JSON_HEDLEY_LIKELY(*range <= current && current <= *(++range))) // NOLINT(bugprone-inc-dec-in-conditions)
+            {
+                add(current);
+            }
+            else
+            {
+                error_message = "invalid string: ill-formed UTF-8 byte";
+                return false;
+            }
+        }
 
-                case 0x11:
-                {
-                    error_message = "invalid string: control character U+0011 (DC1) must be escaped to \\u0011";
-                    return token_type::parse_error;
-                }
+        return true;
+    }
 
-                case 0x12:
-                {
-                    error_message = "invalid string: control character U+0012 (DC2) must be escaped to \\u0012";
-                    return token_type::parse_error;
-                }
+    /*!
+    @brief scan a string literal
 
-                case 0x13:
-                {
-                    error_message = "invalid string: control character U+0013 (DC3) must be escaped to \\u0013";
-                    return token_type::parse_error;
-                }
+    This function scans a string according to Sect. 7 of RFC 8259. While
+    scanning, bytes are escaped and copied into buffer token_buffer. Then the
+    function returns successfully, token_buffer is *not* null-terminated (as it
+    may contain \0 bytes), and token_buffer.size() is the number of bytes in the
+    string.
 
-                case 0x14:
-                {
-                    error_message = "invalid string: control character U+0014 (DC4) must be escaped to \\u0014";
-                    return token_type::parse_error;
-                }
+    @return token_type::value_string if string could be successfully scanned,
+            token_type::parse_error otherwise
 
-                case 0x15:
-                {
-                    error_message = "invalid string: control character U+0015 (NAK) must be escaped to \\u0015";
-                    return token_type::parse_error;
-                }
+    @note In case of errors, variable error_message contains a textual
+          description.
+    */
+    token_type scan_string()
+    {
+        // reset token_buffer (ignore opening quote)
+        reset();
 
-                case 0x16:
-                {
-                    error_message = "invalid string: control character U+0016 (SYN) must be escaped to \\u0016";
-                    return token_type::parse_error;
-                }
+        // we entered the function by reading an open quote
+        JSON_ASSERT(current == '\"');
 
-                case 0x17:
-                {
-                    error_message = "invalid string: control character U+0017 (ETB) must be escaped to \\u0017";
-                    return token_type::parse_error;
-                }
+        while (true)
+        {
+            // copy a run of plain ASCII characters at once (contiguous input only)
+            scan_string_run(is_contiguous_input_adapter<InputAdapterType> {});
 
-                case 0x18:
+            // get next character
+            switch (get())
+            {
+                // end of file while parsing string
+                case char_traits<char_type>::eof():
                 {
-                    error_message = "invalid string: control character U+0018 (CAN) must be escaped to \\u0018";
+                    error_message = "invalid string: missing closing quote";
                     return token_type::parse_error;
                 }
 
-                case 0x19:
+                // closing quote
+                case '\"':
                 {
-                    error_message = "invalid string: control character U+0019 (EM) must be escaped to \\u0019";
-                    return token_type::parse_error;
+                    return token_type::value_string;
                 }
 
-                case 0x1A:
+                // escapes
+                case '\\':
                 {
-                    error_message = "invalid string: control character U+001A (SUB) must be escaped to \\u001A";
-                    return token_type::parse_error;
-                }
+                    switch (get())
+                    {
+                        // quotation mark
+                        case '\"':
+                            add('\"');
+                            break;
+                        // reverse solidus
+                        case '\\':
+                            add('\\');
+                            break;
+                        // solidus
+                        case '/':
+                            add('/');
+                            break;
+                        // backspace
+                        case 'b':
+                            add('\b');
+                            break;
+                        // form feed
+                        case 'f':
+                            add('\f');
+                            break;
+                        // line feed
+                        case 'n':
+                            add('\n');
+                            break;
+                        // carriage return
+                        case 'r':
+                            add('\r');
+                            break;
+                        // tab
+                        case 't':
+                            add('\t');
+                            break;
 
-                case 0x1B:
-                {
-                    error_message = "invalid string: control character U+001B (ESC) must be escaped to \\u001B";
-                    return token_type::parse_error;
-                }
+                        // unicode escapes
+                        case 'u':
+                        {
+                            const int codepoint1 = get_codepoint();
+                            int codepoint = codepoint1; // start with codepoint1
 
-                case 0x1C:
-                {
-                    error_message = "invalid string: control character U+001C (FS) must be escaped to \\u001C";
-                    return token_type::parse_error;
-                }
+                            if (JSON_HEDLEY_UNLIKELY(codepoint1 == -1))
+                            {
+                                error_message = "invalid string: '\\u' must be followed by 4 hex digits";
+                                return token_type::parse_error;
+                            }
 
-                case 0x1D:
-                {
-                    error_message = "invalid string: control character U+001D (GS) must be escaped to \\u001D";
-                    return token_type::parse_error;
-                }
+                            // check if code point is a high surrogate
+                            if (0xD800 <= codepoint1 && codepoint1 <= 0xDBFF)
+                            {
+                                // expect next \uxxxx entry
+                                if (JSON_HEDLEY_LIKELY(get() == '\\' && get() == 'u'))
+                                {
+                                    const int codepoint2 = get_codepoint();
 
-                case 0x1E:
-                {
-                    error_message = "invalid string: control character U+001E (RS) must be escaped to \\u001E";
-                    return token_type::parse_error;
-                }
+                                    if (JSON_HEDLEY_UNLIKELY(codepoint2 == -1))
+                                    {
+                                        error_message = "invalid string: '\\u' must be followed by 4 hex digits";
+                                        return token_type::parse_error;
+                                    }
 
-                case 0x1F:
-                {
-                    error_message = "invalid string: control character U+001F (US) must be escaped to \\u001F";
-                    return token_type::parse_error;
-                }
+                                    // check if codepoint2 is a low surrogate
+                                    if (JSON_HEDLEY_LIKELY(0xDC00 <= codepoint2 && codepoint2 <= 0xDFFF))
+                                    {
+                                        // overwrite codepoint
+                                        codepoint = static_cast<int>(
+                                                        // high surrogate occupies the most significant 22 bits
+                                                        (static_cast<unsigned int>(codepoint1) << 10u)
+                                                        // low surrogate occupies the least significant 15 bits
+                                                        + static_cast<unsigned int>(codepoint2)
+                                                        // there is still the 0xD800, 0xDC00 and 0x10000 noise
+                                                        // in the result, so we have to subtract with:
+                                                        // (0xD800 << 10) + DC00 - 0x10000 = 0x35FDC00
+                                                        - 0x35FDC00u);
+                                    }
+                                    else
+                                    {
+                                        error_message = "invalid string: surrogate U+D800..U+DBFF must be followed by U+DC00..U+DFFF";
+                                        return token_type::parse_error;
+                                    }
+                                }
+                                else
+                                {
+                                    error_message = "invalid string: surrogate U+D800..U+DBFF must be followed by U+DC00..U+DFFF";
+                                    return token_type::parse_error;
+                                }
+                            }
+                            else
+                            {
+                                if (JSON_HEDLEY_UNLIKELY(0xDC00 <= codepoint1 && codepoint1 <= 0xDFFF))
+                                {
+                                    error_message = "invalid string: surrogate U+DC00..U+DFFF must follow U+D800..U+DBFF";
+                                    return token_type::parse_error;
+                                }
+                            }
 
-                // U+0020..U+007F (except U+0022 (quote) and U+005C (backspace))
-                case 0x20:
-                case 0x21:
-                case 0x23:
-                case 0x24:
-                case 0x25:
-                case 0x26:
-                case 0x27:
-                case 0x28:
-                case 0x29:
-                case 0x2A:
-                case 0x2B:
-                case 0x2C:
-                case 0x2D:
-                case 0x2E:
-                case 0x2F:
-                case 0x30:
-                case 0x31:
-                case 0x32:
-                case 0x33:
-                case 0x34:
-                case 0x35:
-                case 0x36:
-                case 0x37:
-                case 0x38:
-                case 0x39:
-                case 0x3A:
-                case 0x3B:
-                case 0x3C:
-                case 0x3D:
-                case 0x3E:
-                case 0x3F:
-                case 0x40:
-                case 0x41:
-                case 0x42:
-                case 0x43:
-                case 0x44:
-                case 0x45:
-                case 0x46:
-                case 0x47:
-                case 0x48:
-                case 0x49:
-                case 0x4A:
-                case 0x4B:
-                case 0x4C:
-                case 0x4D:
-                case 0x4E:
-                case 0x4F:
-                case 0x50:
-                case 0x51:
-                case 0x52:
-                case 0x53:
-                case 0x54:
-                case 0x55:
-                case 0x56:
-                case 0x57:
-                case 0x58:
-                case 0x59:
-                case 0x5A:
-                case 0x5B:
-                case 0x5D:
-                case 0x5E:
-                case 0x5F:
-                case 0x60:
-                case 0x61:
-                case 0x62:
-                case 0x63:
-                case 0x64:
-                case 0x65:
-                case 0x66:
-                case 0x67:
-                case 0x68:
-                case 0x69:
-                case 0x6A:
-                case 0x6B:
-                case 0x6C:
-                case 0x6D:
-                case 0x6E:
-                case 0x6F:
-                case 0x70:
-                case 0x71:
-                case 0x72:
-                case 0x73:
-                case 0x74:
-                case 0x75:
-                case 0x76:
-                case 0x77:
-                case 0x78:
-                case 0x79:
-                case 0x7A:
-                case 0x7B:
-                case 0x7C:
-                case 0x7D:
-                case 0x7E:
-                case 0x7F:
-                {
-                    add(current);
-                    break;
-                }
+                            // result of the above calculation yields a proper codepoint
+                            JSON_ASSERT(0x00 <= codepoint && codepoint <= 0x10FFFF);
 
-                // U+0080..U+07FF: bytes C2..DF 80..BF
-                case 0xC2:
-                case 0xC3:
-                case 0xC4:
-                case 0xC5:
-                case 0xC6:
-                case 0xC7:
-                case 0xC8:
-                case 0xC9:
-                case 0xCA:
-                case 0xCB:
-                case 0xCC:
-                case 0xCD:
-                case 0xCE:
-                case 0xCF:
-                case 0xD0:
-                case 0xD1:
-                case 0xD2:
-                case 0xD3:
-                case 0xD4:
-                case 0xD5:
-                case 0xD6:
-                case 0xD7:
-                case 0xD8:
-                case 0xD9:
-                case 0xDA:
-                case 0xDB:
-                case 0xDC:
-                case 0xDD:
-                case 0xDE:
-                case 0xDF:
-                {
-                    if (JSON_HEDLEY_UNLIKELY(!next_byte_in_range({0x80, 0xBF})))
-                    {
-                        return token_type::parse_error;
+                            // translate codepoint into bytes
+                            if (codepoint < 0x80)
+                            {
+                                // 1-byte characters: 0xxxxxxx (ASCII)
+                                add(static_cast<char_int_type>(codepoint));
+                            }
+                            else if (codepoint <= 0x7FF)
+                            {
+                                // 2-byte characters: 110xxxxx 10xxxxxx
+                                add(static_cast<char_int_type>(0xC0u | (static_cast<unsigned int>(codepoint) >> 6u)));
+                                add(static_cast<char_int_type>(0x80u | (static_cast<unsigned int>(codepoint) & 0x3Fu)));
+                            }
+                            else if (codepoint <= 0xFFFF)
+                            {
+                                // 3-byte characters: 1110xxxx 10xxxxxx 10xxxxxx
+                                add(static_cast<char_int_type>(0xE0u | (static_cast<unsigned int>(codepoint) >> 12u)));
+                                add(static_cast<char_int_type>(0x80u | ((static_cast<unsigned int>(codepoint) >> 6u) & 0x3Fu)));
+                                add(static_cast<char_int_type>(0x80u | (static_cast<unsigned int>(codepoint) & 0x3Fu)));
+                            }
+                            else
+                            {
+                                // 4-byte characters: 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx
+                                add(static_cast<char_int_type>(0xF0u | (static_cast<unsigned int>(codepoint) >> 18u)));
+                                add(static_cast<char_int_type>(0x80u | ((static_cast<unsigned int>(codepoint) >> 12u) & 0x3Fu)));
+                                add(static_cast<char_int_type>(0x80u | ((static_cast<unsigned int>(codepoint) >> 6u) & 0x3Fu)));
+                                add(static_cast<char_int_type>(0x80u | (static_cast<unsigned int>(codepoint) & 0x3Fu)));
+                            }
+
+                            break;
+                        }
+
+                        // other characters after escape
+                        default:
+                            error_message = "invalid string: forbidden character after backslash";
+                            return token_type::parse_error;
                     }
+
                     break;
                 }
 
-                // U+0800..U+0FFF: bytes E0 A0..BF 80..BF
-                case 0xE0:
+                // invalid control characters
+                case 0x00:
                 {
-                    if (JSON_HEDLEY_UNLIKELY(!(next_byte_in_range({0xA0, 0xBF, 0x80, 0xBF}))))
-                    {
-                        return token_type::parse_error;
-                    }
-                    break;
+                    error_message = "invalid string: control character U+0000 (NUL) must be escaped to \\u0000";
+                    return token_type::parse_error;
                 }
 
-                // U+1000..U+CFFF: bytes E1..EC 80..BF 80..BF
-                // U+E000..U+FFFF: bytes EE..EF 80..BF 80..BF
-                case 0xE1:
-                case 0xE2:
-                case 0xE3:
-                case 0xE4:
-                case 0xE5:
-                case 0xE6:
-                case 0xE7:
-                case 0xE8:
-                case 0xE9:
-                case 0xEA:
-                case 0xEB:
-                case 0xEC:
-                case 0xEE:
-                case 0xEF:
+                case 0x01:
                 {
-                    if (JSON_HEDLEY_UNLIKELY(!(next_byte_in_range({0x80, 0xBF, 0x80, 0xBF}))))
-                    {
-                        return token_type::parse_error;
-                    }
-                    break;
+                    error_message = "invalid string: control character U+0001 (SOH) must be escaped to \\u0001";
+                    return token_type::parse_error;
                 }
 
-                // U+D000..U+D7FF: bytes ED 80..9F 80..BF
-                case 0xED:
+                case 0x02:
                 {
-                    if (JSON_HEDLEY_UNLIKELY(!(next_byte_in_range({0x80, 0x9F, 0x80, 0xBF}))))
-                    {
-                        return token_type::parse_error;
-                    }
-                    break;
+                    error_message = "invalid string: control character U+0002 (STX) must be escaped to \\u0002";
+                    return token_type::parse_error;
                 }
 
-                // U+10000..U+3FFFF F0 90..BF 80..BF 80..BF
-                case 0xF0:
+                case 0x03:
                 {
-                    if (JSON_HEDLEY_UNLIKELY(!(next_byte_in_range({0x90, 0xBF, 0x80, 0xBF, 0x80, 0xBF}))))
-                    {
-                        return token_type::parse_error;
-                    }
-                    break;
+                    error_message = "invalid string: control character U+0003 (ETX) must be escaped to \\u0003";
+                    return token_type::parse_error;
                 }
 
-                // U+40000..U+FFFFF F1..F3 80..BF 80..BF 80..BF
-                case 0xF1:
-                case 0xF2:
-                case 0xF3:
+                case 0x04:
                 {
-                    if (JSON_HEDLEY_UNLIKELY(!(next_byte_in_range({0x80, 0xBF, 0x80, 0xBF, 0x80, 0xBF}))))
-                    {
-                        return token_type::parse_error;
-                    }
-                    break;
+                    error_message = "invalid string: control character U+0004 (EOT) must be escaped to \\u0004";
+                    return token_type::parse_error;
                 }
 
-                // U+100000..U+10FFFF F4 80..8F 80..BF 80..BF
-                case 0xF4:
+                case 0x05:
                 {
-                    if (JSON_HEDLEY_UNLIKELY(!(next_byte_in_range({0x80, 0x8F, 0x80, 0xBF, 0x80, 0xBF}))))
-                    {
-                        return token_type::parse_error;
-                    }
-                    break;
+                    error_message = "invalid string: control character U+0005 (ENQ) must be escaped to \\u0005";
+                    return token_type::parse_error;
                 }
 
-                // remaining bytes (80..C1 and F5..FF) are ill-formed
-                default:
+                case 0x06:
                 {
-                    error_message = "invalid string: ill-formed UTF-8 byte";
+                    error_message = "invalid string: control character U+0006 (ACK) must be escaped to \\u0006";
                     return token_type::parse_error;
                 }
-            }
-        }
-    }
 
-    /*!
-     * @brief scan a comment
-     * @return whether comment could be scanned successfully
-     */
-    bool scan_comment()
-    {
-        switch (get())
-        {
-            // single-line comments skip input until a newline or EOF is read
-            case '/':
-            {
-                while (true)
+                case 0x07:
                 {
-                    switch (get())
-                    {
-                        case '\n':
-                        case '\r':
-                        case char_traits<char_type>::eof():
-                        case '\0':
-                            return true;
+                    error_message = "invalid string: control character U+0007 (BEL) must be escaped to \\u0007";
+                    return token_type::parse_error;
+                }
 
-                        default:
-                            break;
-                    }
+                case 0x08:
+                {
+                    error_message = "invalid string: control character U+0008 (BS) must be escaped to \\u0008 or \\b";
+                    return token_type::parse_error;
                 }
-            }
 
-            // multi-line comments skip input until */ is read
-            case '*':
-            {
-                while (true)
+                case 0x09:
                 {
-                    switch (get())
-                    {
-                        case char_traits<char_type>::eof():
-                        case '\0':
-                        {
-                            error_message = "invalid comment; missing closing '*/'";
-                            return false;
-                        }
+                    error_message = "invalid string: control character U+0009 (HT) must be escaped to \\u0009 or \\t";
+                    return token_type::parse_error;
+                }
 
-                        case '*':
-                        {
-                            switch (get())
-                            {
-                                case '/':
-                                    return true;
+                case 0x0A:
+                {
+                    error_message = "invalid string: control character U+000A (LF) must be escaped to \\u000A or \\n";
+                    return token_type::parse_error;
+                }
 
-                                default:
-                                {
-                                    unget();
-                                    continue;
-                                }
-                            }
-                        }
+                case 0x0B:
+                {
+                    error_message = "invalid string: control character U+000B (VT) must be escaped to \\u000B";
+                    return token_type::parse_error;
+                }
 
-                        default:
-                            continue;
-                    }
+                case 0x0C:
+                {
+                    error_message = "invalid string: control character U+000C (FF) must be escaped to \\u000C or \\f";
+                    return token_type::parse_error;
                 }
-            }
 
-            // unexpected character after reading '/'
-            default:
-            {
-                error_message = "invalid comment; expecting '/' or '*' after '/'";
-                return false;
-            }
-        }
-    }
+                case 0x0D:
+                {
+                    error_message = "invalid string: control character U+000D (CR) must be escaped to \\u000D or \\r";
+                    return token_type::parse_error;
+                }
 
-    JSON_HEDLEY_NON_NULL(2)
-    static void strtof(float& f, const char* str, char** endptr) noexcept
-    {
-        f = std::strtof(str, endptr);
-    }
+                case 0x0E:
+                {
+                    error_message = "invalid string: control character U+000E (SO) must be escaped to \\u000E";
+                    return token_type::parse_error;
+                }
 
-    JSON_HEDLEY_NON_NULL(2)
-    static void strtof(double& f, const char* str, char** endptr) noexcept
-    {
-        f = std::strtod(str, endptr);
-    }
+                case 0x0F:
+                {
+                    error_message = "invalid string: control character U+000F (SI) must be escaped to \\u000F";
+                    return token_type::parse_error;
+                }
 
-    JSON_HEDLEY_NON_NULL(2)
-    static void strtof(long double& f, const char* str, char** endptr) noexcept
-    {
-        f = std::strtold(str, endptr);
-    }
+                case 0x10:
+                {
+                    error_message = "invalid string: control character U+0010 (DLE) must be escaped to \\u0010";
+                    return token_type::parse_error;
+                }
 
-    /*!
-    @brief scan a number literal
+                case 0x11:
+                {
+                    error_message = "invalid string: control character U+0011 (DC1) must be escaped to \\u0011";
+                    return token_type::parse_error;
+                }
 
-    This function scans a string according to Sect. 6 of RFC 8259.
+                case 0x12:
+                {
+                    error_message = "invalid string: control character U+0012 (DC2) must be escaped to \\u0012";
+                    return token_type::parse_error;
+                }
 
-    The function is realized with a deterministic finite state machine derived
-    from the grammar described in RFC 8259. Starting in state "init", the
-    input is read and used to determined the next state. Only state "done"
-    accepts the number. State "error" is a trap state to model errors. In the
-    table below, "anything" means any character but the ones listed before.
+                case 0x13:
+                {
+                    error_message = "invalid string: control character U+0013 (DC3) must be escaped to \\u0013";
+                    return token_type::parse_error;
+                }
 
-    state    | 0        | 1-9      | e E      | +       | -       | .        | anything
-    ---------|----------|----------|----------|---------|---------|----------|-----------
-    init     | zero     | any1     | [error]  | [error] | minus   | [error]  | [error]
-    minus    | zero     | any1     | [error]  | [error] | [error] | [error]  | [error]
-    zero     | done     | done     | exponent | done    | done    | decimal1 | done
-    any1     | any1     | any1     | exponent | done    | done    | decimal1 | done
-    decimal1 | decimal2 | decimal2 | [error]  | [error] | [error] | [error]  | [error]
-    decimal2 | decimal2 | decimal2 | exponent | done    | done    | done     | done
-    exponent | any2     | any2     | [error]  | sign    | sign    | [error]  | [error]
-    sign     | any2     | any2     | [error]  | [error] | [error] | [error]  | [error]
-    any2     | any2     | any2     | done     | done    | done    | done     | done
+                case 0x14:
+                {
+                    error_message = "invalid string: control character U+0014 (DC4) must be escaped to \\u0014";
+                    return token_type::parse_error;
+                }
 
-    The state machine is realized with one label per state (prefixed with
-    "scan_number_") and `goto` statements between them. The state machine
-    contains cycles, but any cycle can be left when EOF is read. Therefore,
-    the function is guaranteed to terminate.
+                case 0x15:
+                {
+                    error_message = "invalid string: control character U+0015 (NAK) must be escaped to \\u0015";
+                    return token_type::parse_error;
+                }
 
-    During scanning, the read bytes are stored in token_buffer. This string is
-    then converted to a signed integer, an unsigned integer, or a
-    floating-point number.
+                case 0x16:
+                {
+                    error_message = "invalid string: control character U+0016 (SYN) must be escaped to \\u0016";
+                    return token_type::parse_error;
+                }
 
-    @return token_type::value_unsigned, token_type::value_integer, or
-            token_type::value_float if number could be successfully scanned,
-            token_type::parse_error otherwise
+                case 0x17:
+                {
+                    error_message = "invalid string: control character U+0017 (ETB) must be escaped to \\u0017";
+                    return token_type::parse_error;
+                }
 
-    @note The scanner is independent of the current locale. Internally, the
-          locale's decimal point is used instead of `.` to work with the
-          locale-dependent converters.
-    */
-    token_type scan_number()  // lgtm [cpp/use-of-goto]
-    {
-        // reset token_buffer to store the number's bytes
-        reset();
+                case 0x18:
+                {
+                    error_message = "invalid string: control character U+0018 (CAN) must be escaped to \\u0018";
+                    return token_type::parse_error;
+                }
 
-        // the type of the parsed number; initially set to unsigned; will be
-        // changed if minus sign, decimal point or exponent is read
-        token_type number_type = token_type::value_unsigned;
+                case 0x19:
+                {
+                    error_message = "invalid string: control character U+0019 (EM) must be escaped to \\u0019";
+                    return token_type::parse_error;
+                }
 
-        // state (init): we just found out we need to scan a number
-        switch (current)
-        {
-            case '-':
-            {
-                add(current);
-                goto scan_number_minus;
-            }
+                case 0x1A:
+                {
+                    error_message = "invalid string: control character U+001A (SUB) must be escaped to \\u001A";
+                    return token_type::parse_error;
+                }
+
+                case 0x1B:
+                {
+                    error_message = "invalid string: control character U+001B (ESC) must be escaped to \\u001B";
+                    return token_type::parse_error;
+                }
+
+                case 0x1C:
+                {
+                    error_message = "invalid string: control character U+001C (FS) must be escaped to \\u001C";
+                    return token_type::parse_error;
+                }
+
+                case 0x1D:
+                {
+                    error_message = "invalid string: control character U+001D (GS) must be escaped to \\u001D";
+                    return token_type::parse_error;
+                }
+
+                case 0x1E:
+                {
+                    error_message = "invalid string: control character U+001E (RS) must be escaped to \\u001E";
+                    return token_type::parse_error;
+                }
+
+                case 0x1F:
+                {
+                    error_message = "invalid string: control character U+001F (US) must be escaped to \\u001F";
+                    return token_type::parse_error;
+                }
+
+                // U+0020..U+007F (except U+0022 (quote) and U+005C (backspace))
+                case 0x20:
+                case 0x21:
+                case 0x23:
+                case 0x24:
+                case 0x25:
+                case 0x26:
+                case 0x27:
+                case 0x28:
+                case 0x29:
+                case 0x2A:
+                case 0x2B:
+                case 0x2C:
+                case 0x2D:
+                case 0x2E:
+                case 0x2F:
+                case 0x30:
+                case 0x31:
+                case 0x32:
+                case 0x33:
+                case 0x34:
+                case 0x35:
+                case 0x36:
+                case 0x37:
+                case 0x38:
+                case 0x39:
+                case 0x3A:
+                case 0x3B:
+                case 0x3C:
+                case 0x3D:
+                case 0x3E:
+                case 0x3F:
+                case 0x40:
+                case 0x41:
+                case 0x42:
+                case 0x43:
+                case 0x44:
+                case 0x45:
+                case 0x46:
+                case 0x47:
+                case 0x48:
+                case 0x49:
+                case 0x4A:
+                case 0x4B:
+                case 0x4C:
+                case 0x4D:
+                case 0x4E:
+                case 0x4F:
+                case 0x50:
+                case 0x51:
+                case 0x52:
+                case 0x53:
+                case 0x54:
+                case 0x55:
+                case 0x56:
+                case 0x57:
+                case 0x58:
+                case 0x59:
+                case 0x5A:
+                case 0x5B:
+                case 0x5D:
+                case 0x5E:
+                case 0x5F:
+                case 0x60:
+                case 0x61:
+                case 0x62:
+                case 0x63:
+                case 0x64:
+                case 0x65:
+                case 0x66:
+                case 0x67:
+                case 0x68:
+                case 0x69:
+                case 0x6A:
+                case 0x6B:
+                case 0x6C:
+                case 0x6D:
+                case 0x6E:
+                case 0x6F:
+                case 0x70:
+                case 0x71:
+                case 0x72:
+                case 0x73:
+                case 0x74:
+                case 0x75:
+                case 0x76:
+                case 0x77:
+                case 0x78:
+                case 0x79:
+                case 0x7A:
+                case 0x7B:
+                case 0x7C:
+                case 0x7D:
+                case 0x7E:
+                case 0x7F:
+                {
+                    add(current);
+                    break;
+                }
+
+                // U+0080..U+07FF: bytes C2..DF 80..BF
+                case 0xC2:
+                case 0xC3:
+                case 0xC4:
+                case 0xC5:
+                case 0xC6:
+                case 0xC7:
+                case 0xC8:
+                case 0xC9:
+                case 0xCA:
+                case 0xCB:
+                case 0xCC:
+                case 0xCD:
+                case 0xCE:
+                case 0xCF:
+                case 0xD0:
+                case 0xD1:
+                case 0xD2:
+                case 0xD3:
+                case 0xD4:
+                case 0xD5:
+                case 0xD6:
+                case 0xD7:
+                case 0xD8:
+                case 0xD9:
+                case 0xDA:
+                case 0xDB:
+                case 0xDC:
+                case 0xDD:
+                case 0xDE:
+                case 0xDF:
+                {
+                    if (JSON_HEDLEY_UNLIKELY(!next_byte_in_range({0x80, 0xBF})))
+                    {
+                        return token_type::parse_error;
+                    }
+                    break;
+                }
+
+                // U+0800..U+0FFF: bytes E0 A0..BF 80..BF
+                case 0xE0:
+                {
+                    if (JSON_HEDLEY_UNLIKELY(!(next_byte_in_range({0xA0, 0xBF, 0x80, 0xBF}))))
+                    {
+                        return token_type::parse_error;
+                    }
+                    break;
+                }
+
+                // U+1000..U+CFFF: bytes E1..EC 80..BF 80..BF
+                // U+E000..U+FFFF: bytes EE..EF 80..BF 80..BF
+                case 0xE1:
+                case 0xE2:
+                case 0xE3:
+                case 0xE4:
+                case 0xE5:
+                case 0xE6:
+                case 0xE7:
+                case 0xE8:
+                case 0xE9:
+                case 0xEA:
+                case 0xEB:
+                case 0xEC:
+                case 0xEE:
+                case 0xEF:
+                {
+                    if (JSON_HEDLEY_UNLIKELY(!(next_byte_in_range({0x80, 0xBF, 0x80, 0xBF}))))
+                    {
+                        return token_type::parse_error;
+                    }
+                    break;
+                }
+
+                // U+D000..U+D7FF: bytes ED 80..9F 80..BF
+                case 0xED:
+                {
+                    if (JSON_HEDLEY_UNLIKELY(!(next_byte_in_range({0x80, 0x9F, 0x80, 0xBF}))))
+                    {
+                        return token_type::parse_error;
+                    }
+                    break;
+                }
+
+                // U+10000..U+3FFFF F0 90..BF 80..BF 80..BF
+                case 0xF0:
+                {
+                    if (JSON_HEDLEY_UNLIKELY(!(next_byte_in_range({0x90, 0xBF, 0x80, 0xBF, 0x80, 0xBF}))))
+                    {
+                        return token_type::parse_error;
+                    }
+                    break;
+                }
+
+                // U+40000..U+FFFFF F1..F3 80..BF 80..BF 80..BF
+                case 0xF1:
+                case 0xF2:
+                case 0xF3:
+                {
+                    if (JSON_HEDLEY_UNLIKELY(!(next_byte_in_range({0x80, 0xBF, 0x80, 0xBF, 0x80, 0xBF}))))
+                    {
+                        return token_type::parse_error;
+                    }
+                    break;
+                }
+
+                // U+100000..U+10FFFF F4 80..8F 80..BF 80..BF
+                case 0xF4:
+                {
+                    if (JSON_HEDLEY_UNLIKELY(!(next_byte_in_range({0x80, 0x8F, 0x80, 0xBF, 0x80, 0xBF}))))
+                    {
+                        return token_type::parse_error;
+                    }
+                    break;
+                }
+
+                // remaining bytes (80..C1 and F5..FF) are ill-formed
+                default:
+                {
+                    error_message = "invalid string: ill-formed UTF-8 byte";
+                    return token_type::parse_error;
+                }
+            }
+        }
+    }
+
+    /*!
+     * @brief scan a comment
+     * @return whether comment could be scanned successfully
+     */
+    bool scan_comment()
+    {
+        switch (get())
+        {
+            // single-line comments skip input until a newline or EOF is read
+            case '/':
+            {
+                while (true)
+                {
+                    switch (get())
+                    {
+                        case '\n':
+                        case '\r':
+                        case char_traits<char_type>::eof():
+                        case '\0':
+                            return true;
+
+                        default:
+                            break;
+                    }
+                }
+            }
+
+            // multi-line comments skip input until */ is read
+            case '*':
+            {
+                while (true)
+                {
+                    switch (get())
+                    {
+                        case char_traits<char_type>::eof():
+                        case '\0':
+                        {
+                            error_message = "invalid comment; missing closing '*/'";
+                            return false;
+                        }
+
+                        case '*':
+                        {
+                            switch (get())
+                            {
+                                case '/':
+                                    return true;
+
+                                default:
+                                {
+                                    unget();
+                                    continue;
+                                }
+                            }
+                        }
+
+                        default:
+                            continue;
+                    }
+                }
+            }
+
+            // unexpected character after reading '/'
+            default:
+            {
+                error_message = "invalid comment; expecting '/' or '*' after '/'";
+                return false;
+            }
+        }
+    }
+
+    JSON_HEDLEY_NON_NULL(2)
+    static void strtof(float& f, const char* str, char** endptr) noexcept
+    {
+        f = std::strtof(str, endptr);
+    }
+
+    JSON_HEDLEY_NON_NULL(2)
+    static void strtof(double& f, const char* str, char** endptr) noexcept
+    {
+        f = std::strtod(str, endptr);
+    }
+
+    JSON_HEDLEY_NON_NULL(2)
+    static void strtof(long double& f, const char* str, char** endptr) noexcept
+    {
+        f = std::strtold(str, endptr);
+    }
+
+    /*!
+    @brief scan a number literal
+
+    This function scans a string according to Sect. 6 of RFC 8259.
+
+    The function is realized with a deterministic finite state machine derived
+    from the grammar described in RFC 8259. Starting in state "init", the
+    input is read and used to determined the next state. Only state "done"
+    accepts the number. State "error" is a trap state to model errors. In the
+    table below, "anything" means any character but the ones listed before.
+
+    state    | 0        | 1-9      | e E      | +       | -       | .        | anything
+    ---------|----------|----------|----------|---------|---------|----------|-----------
+    init     | zero     | any1     | [error]  | [error] | minus   | [error]  | [error]
+    minus    | zero     | any1     | [error]  | [error] | [error] | [error]  | [error]
+    zero     | done     | done     | exponent | done    | done    | decimal1 | done
+    any1     | any1     | any1     | exponent | done    | done    | decimal1 | done
+    decimal1 | decimal2 | decimal2 | [error]  | [error] | [error] | [error]  | [error]
+    decimal2 | decimal2 | decimal2 | exponent | done    | done    | done     | done
+    exponent | any2     | any2     | [error]  | sign    | sign    | [error]  | [error]
+    sign     | any2     | any2     | [error]  | [error] | [error] | [error]  | [error]
+    any2     | any2     | any2     | done     | done    | done    | done     | done
+
+    The state machine is realized with one label per state (prefixed with
+    "scan_number_") and `goto` statements between them. The state machine
+    contains cycles, but any cycle can be left when EOF is read. Therefore,
+    the function is guaranteed to terminate.
+
+    During scanning, the read bytes are stored in token_buffer. This string is
+    then converted to a signed integer, an unsigned integer, or a
+    floating-point number.
+
+    @return token_type::value_unsigned, token_type::value_integer, or
+            token_type::value_float if number could be successfully scanned,
+            token_type::parse_error otherwise
+
+    @note The scanner is independent of the current locale. Internally, the
+          locale's decimal point is used instead of `.` to work with the
+          locale-dependent converters.
+    */
+    token_type scan_number()  // lgtm [cpp/use-of-goto]
+    {
+        // reset token_buffer to store the number's bytes
+        reset();
+
+        // the type of the parsed number; initially set to unsigned; will be
+        // changed if minus sign, decimal point or exponent is read
+        token_type number_type = token_type::value_unsigned;
+
+        // state (init): we just found out we need to scan a number
+        switch (current)
+        {
+            case '-':
+            {
+                add(current);
+                goto scan_number_minus;
+            }
 
             case '0':
             {
@@ -8616,6 +10011,13 @@ scan_number_done:
         // we are done scanning a number)
         unget();
 
+#if !defined(JSON_NO_FAST_NUMBER)
+        if (scan_number_fast(number_type))
+        {
+            return number_type;
+        }
+#endif
+
         char* endptr = nullptr; // NOLINT(cppcoreguidelines-pro-type-vararg,hicpp-vararg)
         errno = 0;
 
@@ -8663,6 +10065,56 @@ scan_number_done:
         return token_type::value_float;
     }
 
+    /*!
+    @brief convert token_buffer without the C library
+
+    @return true if the value was set; false if the token has to go through
+            strtoull/strtoll/strtod (long numbers, subnormals, overflow, and
+            number_float_t other than double)
+    */
+    bool scan_number_fast(const token_type number_type)
+    {
+        const char* begin = token_buffer.data();
+        const char* end = begin + token_buffer.size();
+
+        if (number_type == token_type::value_unsigned)
+        {
+            std::uint64_t x = 0;
+            if (!number_scan::parse_digits(begin, end, x))
+            {
+                return false;
+            }
+            value_unsigned = static_cast<number_unsigned_t>(x);
+            return static_cast<std::uint64_t>(value_unsigned) == x;
+        }
+
+        if (number_type == token_type::value_integer)
+        {
+            std::uint64_t x = 0;
+            if (!number_scan::parse_digits(begin + 1, end, x) || x > (std::uint64_t(1) << 63))
+            {
+                return false;
+            }
+            const auto v = (x == (std::uint64_t(1) << 63))
+                           ? (std::numeric_limits<std::int64_t>::min)()
+                           : -static_cast<std::int64_t>(x);
+            value_integer = static_cast<number_integer_t>(v);
+            return static_cast<std::int64_t>(value_integer) == v;
+        }
+
+        return scan_number_fast_float(begin, end, std::is_same<number_float_t, double> {});
+    }
+
+    bool scan_number_fast_float(const char* /*unused*/, const char* /*unused*/, std::false_type /*unused*/) noexcept
+    {
+        return false;
+    }
+
+    bool scan_number_fast_float(const char* begin, const char* end, std::true_type /*unused*/) noexcept
+    {
+        return number_scan::parse_double(begin, end, static_cast<char>(decimal_point_char), value_float);
+    }
+
     /*!
     @param[in] literal_text  the literal text to expect
     @param[in] length        the length of the passed literal text
@@ -8874,10 +10326,100 @@ scan_number_done:
         do
         {
             get();
+            if (current == ' ' || current == '\t' || current == '\n' || current == '\r')
+            {
+                skip_whitespace_run(is_contiguous_input_adapter<InputAdapterType> {});
+            }
         }
         while (current == ' ' || current == '\t' || current == '\n' || current == '\r');
     }
 
+    /////////////////////
+    // contiguous input
+    /////////////////////
+
+    /*!
+    @brief consume the plain characters of a string at once
+
+    The bytes which scan_string() would only copy (ASCII 0x20..0x7F except
+    '"' and '\\') are appended to token_buffer in one step. The position and
+    token_string are updated as if get() had been called for each byte.
+    */
+    void scan_string_run(std::false_type /*unused*/) noexcept {}
+
+    void scan_string_run(std::true_type /*unused*/)
+    {
+        const std::size_t n = ia.remaining_size();
+        if (next_unget || n == 0)
+        {
+            return;
+        }
+
+        const auto* p = ia.remaining_data();
+        const std::size_t len = lexer_scan::string_run(reinterpret_cast<const char*>(p), n);
+        if (len == 0)
+        {
+            return;
+        }
+
+        token_buffer.append(reinterpret_cast<const typename string_t::value_type*>(p), len);
+        consume_run(p, len);
+    }
+
+    /*!
+    @brief consume the following whitespace at once
+
+    Called with a whitespace character in current. The lines are counted so
+    the position is the same as with the character-wise skip.
+    */
+    void skip_whitespace_run(std::false_type /*unused*/) noexcept {}
+
+    void skip_whitespace_run(std::true_type /*unused*/)
+    {
+        const std::size_t n = ia.remaining_size();
+        if (next_unget || n == 0)
+        {
+            return;
+        }
+
+        const auto* p = ia.remaining_data();
+        const std::size_t len = lexer_scan::whitespace_run(reinterpret_cast<const char*>(p), n);
+        if (len == 0)
+        {
+            return;
+        }
+
+        // newlines in the run
+        std::size_t lines = 0;
+        std::size_t last_newline = 0;
+        for (std::size_t i = 0; i < len; ++i)
+        {
+            if (p[i] == '\n')
+            {
+                ++lines;
+                last_newline = i + 1;
+            }
+        }
+
+        consume_run(p, len);
+        if (lines > 0)
+        {
+            position.lines_read += lines;
+            position.chars_read_current_line = len - last_newline;
+        }
+    }
+
+    /// skip len bytes of the input; same bookkeeping as get() for bytes other than '\n'
+    template<typename CharType>
+    void consume_run(const CharType* p, std::size_t len)
+    {
+        token_string.insert(token_string.end(), p, p + len);
+        ia.skip(len);
+        position.chars_read_total += len;
+        position.chars_read_current_line += len;
+        current = char_traits<char_type>::to_int_type(static_cast<char_type>(p[len - 1]));
+    }
+
     token_type scan()
     {
         // initially, skip the BOM
@@ -9034,6 +10576,9 @@ namespace detail
 template<typename T>
 using null_function_t = decltype(std::declval<T&>().null());
 
+template<typename T>
+using reserve_back_function_t = decltype(std::declval<T&>().reserve_back(std::declval<std::size_t>()));
+
 template<typename T>
 using boolean_function_t =
     decltype(std::declval<T&>().boolean(std::declval<bool>()));
@@ -9176,29 +10721,191 @@ NLOHMANN_JSON_NAMESPACE_END
 // #include <nlohmann/detail/value_t.hpp>
 
 
-NLOHMANN_JSON_NAMESPACE_BEGIN
-namespace detail
-{
+NLOHMANN_JSON_NAMESPACE_BEGIN
+namespace detail
+{
+
+/// how to treat CBOR tags
+enum class cbor_tag_handler_t
+{
+    error,   ///< throw a parse_error exception in case of a tag
+    ignore,  ///< ignore tags
+    store    ///< store tags as binary type
+};
+
+/*!
+@brief CBOR tag of an indexed document
+
+`tag(cbor_index_tag) [bstr(index), document]`: the byte string holds the
+CBOR-encoded byte offsets of the document's top-level items, so a reader
+can seek to one of them. binary_reader skips the index and reads the
+document unless tags are stored.
+*/
+JSON_INLINE_VARIABLE constexpr std::uint32_t cbor_index_tag = 0x6A736F6E;
+
+/*!
+@brief hash of a top-level key in the index of an indexed document (64-bit FNV-1a)
+
+The index holds the hashes of the keys in a sorted table, so a reader can
+find a key by a binary search instead of a scan of all keys.
+*/
+inline std::uint64_t cbor_index_hash(const char* str, std::size_t len) noexcept
+{
+    std::uint64_t hash = 0xCBF29CE484222325ull;
+    for (std::size_t i = 0; i < len; ++i)
+    {
+        hash ^= static_cast<std::uint8_t>(str[i]);
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+/*!
+@brief determine system byte order
+
+@return true if and only if system's byte order is little endian
+
+@note from https://stackoverflow.com/a/1001328/266378
+*/
+static inline bool little_endianness(int num = 1) noexcept
+{
+    return *reinterpret_cast<char*>(&num) == 1;
+}
+
+////////////////
+// half float //
+////////////////
+
+/*!
+@brief IEEE 754 half-precision (binary16) conversion
+
+from_float() rounds to nearest even like the F16C instruction VCVTPS2PH, so
+convert() gives the same bits on every CPU; F16C is used when the CPU has it.
+*/
+struct half_float
+{
+    static std::uint16_t from_float(const float f) noexcept
+    {
+        std::uint32_t x = 0;
+        std::memcpy(&x, &f, sizeof(x));
+        const auto sign = static_cast<std::uint16_t>((x >> 16) & 0x8000u);
+        const std::uint32_t abs_x = x & 0x7FFFFFFFu;
+
+        if (abs_x >= 0x7F800000u)
+        {
+            // NaN keeps the upper payload bits and is quiet, infinity stays infinity
+            return static_cast<std::uint16_t>(sign | (abs_x > 0x7F800000u ? (0x7E00u | ((abs_x >> 13) & 0x3FFu)) : 0x7C00u));
+        }
+        if (abs_x >= 0x477FF000u)
+        {
+            // 65520 and above round to infinity
+            return static_cast<std::uint16_t>(sign | 0x7C00u);
+        }
+        if (abs_x < 0x38800000u)
+        {
+            // below 2^-14: subnormal half in units of 2^-24
+            const std::uint32_t e = abs_x >> 23;
+            if (e < 102)
+            {
+                return sign;
+            }
+            const std::uint32_t m = (abs_x & 0x7FFFFFu) | 0x800000u;
+            const std::uint32_t shift = 126 - e;
+            std::uint32_t h = m >> shift;
+            const std::uint32_t rem = m & ((1u << shift) - 1);
+            const std::uint32_t halfway = 1u << (shift - 1);
+            if (rem > halfway || (rem == halfway && (h & 1u) != 0))
+            {
+                ++h;
+            }
+            return static_cast<std::uint16_t>(sign | h);
+        }
+
+        // rebias the exponent (127 -> 15); a carry out of the mantissa increments the exponent
+        const std::uint32_t r = abs_x - 0x38000000u;
+        std::uint32_t h = r >> 13;
+        const std::uint32_t rem = r & 0x1FFFu;
+        if (rem > 0x1000u || (rem == 0x1000u && (h & 1u) != 0))
+        {
+            ++h;
+        }
+        return static_cast<std::uint16_t>(sign | h);
+    }
+
+    static float to_float(const std::uint16_t h) noexcept
+    {
+        const std::uint32_t sign = static_cast<std::uint32_t>(h & 0x8000u) << 16;
+        const std::uint32_t exp = (h >> 10) & 0x1Fu;
+        const std::uint32_t mant = h & 0x3FFu;
+
+        std::uint32_t bits = 0;
+        if (exp == 0)
+        {
+            // zero and subnormals: mant * 2^-24 is exact in float
+            const float f = static_cast<float>(mant) * 5.9604644775390625e-8f;
+            std::memcpy(&bits, &f, sizeof(bits));
+            bits |= sign;
+        }
+        else if (exp == 31)
+        {
+            bits = sign | 0x7F800000u | (mant << 13);
+        }
+        else
+        {
+            bits = sign | ((exp + 112) << 23) | (mant << 13);
+        }
+
+        float result{};
+        std::memcpy(&result, &bits, sizeof(result));
+        return result;
+    }
 
-/// how to treat CBOR tags
-enum class cbor_tag_handler_t
-{
-    error,   ///< throw a parse_error exception in case of a tag
-    ignore,  ///< ignore tags
-    store    ///< store tags as binary type
-};
+    /*!
+    @brief convert @a n floats to half floats
 
-/*!
-@brief determine system byte order
+    @param[in] in  values to convert
+    @param[out] out  the half floats
+    @param[out] back  the values of @a out as float (to check the error)
+    */
+    static void convert(const float* in, std::uint16_t* out, float* back, std::size_t n) noexcept
+    {
+        std::size_t i = 0;
+#if defined(JSON_SIMD_AVX2)
+        static const bool f16c = has_f16c();
+        if (f16c)
+        {
+            i = convert_f16c(in, out, back, n);
+        }
+#endif
+        for (; i < n; ++i)
+        {
+            out[i] = from_float(in[i]);
+            back[i] = to_float(out[i]);
+        }
+    }
 
-@return true if and only if system's byte order is little endian
+  private:
+#if defined(JSON_SIMD_AVX2)
+    __attribute__((target("avx,f16c")))
+    static std::size_t convert_f16c(const float* in, std::uint16_t* out, float* back, std::size_t n) noexcept
+    {
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), h);
+            _mm256_storeu_ps(back + i, _mm256_cvtph_ps(h));
+        }
+        return i;
+    }
 
-@note from https://stackoverflow.com/a/1001328/266378
-*/
-static inline bool little_endianness(int num = 1) noexcept
-{
-    return *reinterpret_cast<char*>(&num) == 1;
-}
+    static bool has_f16c() noexcept
+    {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx") != 0 && __builtin_cpu_supports("f16c") != 0;
+    }
+#endif
+};
 
 ///////////////////
 // binary reader //
@@ -9872,6 +11579,41 @@ class binary_reader
             case 0xDA: // tagged item (4 bytes follow)
             case 0xDB: // tagged item (8 bytes follow)
             {
+                // RFC 8746 typed arrays and indexed documents are read as their content unless tags are stored
+                if ((current == 0xD8 || current == 0xDA) && tag_handler != cbor_tag_handler_t::store)
+                {
+                    const auto tag_position = chars_read;
+                    auto tag_token = get_token_string();
+                    std::uint32_t tag{};
+                    if (current == 0xD8)
+                    {
+                        std::uint8_t tag8{};
+                        if (JSON_HEDLEY_UNLIKELY(!get_number(input_format_t::cbor, tag8)))
+                        {
+                            return false;
+                        }
+                        if (is_cbor_typed_array_tag(tag8))
+                        {
+                            return get_cbor_typed_array(tag8);
+                        }
+                        tag = tag8;
+                    }
+                    else if (JSON_HEDLEY_UNLIKELY(!get_number(input_format_t::cbor, tag)))
+                    {
+                        return false;
+                    }
+                    if (tag == cbor_index_tag)
+                    {
+                        return get_cbor_indexed(tag_handler);
+                    }
+                    if (tag_handler == cbor_tag_handler_t::error)
+                    {
+                        return sax->parse_error(tag_position, tag_token, parse_error::create(112, tag_position,
+                                                exception_message(input_format_t::cbor, concat("invalid byte: 0x", tag_token), "value"), nullptr));
+                    }
+                    return parse_cbor_internal(true, tag_handler);
+                }
+
                 switch (tag_handler)
                 {
                     case cbor_tag_handler_t::error:
@@ -9988,36 +11730,8 @@ class binary_reader
                 const auto byte1 = static_cast<unsigned char>(byte1_raw);
                 const auto byte2 = static_cast<unsigned char>(byte2_raw);
 
-                // code from RFC 7049, Appendix D, Figure 3:
-                // As half-precision floating-point numbers were only added
-                // to IEEE 754 in 2008, today's programming platforms often
-                // still only have limited support for them. It is very
-                // easy to include at least decoding support for them even
-                // without such support. An example of a small decoder for
-                // half-precision floating-point numbers in the C language
-                // is shown in Fig. 3.
-                const auto half = static_cast<unsigned int>((byte1 << 8u) + byte2);
-                const double val = [&half]
-                {
-                    const int exp = (half >> 10u) & 0x1Fu;
-                    const unsigned int mant = half & 0x3FFu;
-                    JSON_ASSERT(0 <= exp&& exp <= 32);
-                    JSON_ASSERT(mant <= 1024);
-                    switch (exp)
-                    {
-                        case 0:
-                            return std::ldexp(mant, -24);
-                        case 31:
-                            return (mant == 0)
-                            ? std::numeric_limits<double>::infinity()
-                            : std::numeric_limits<double>::quiet_NaN();
-                        default:
-                            return std::ldexp(mant + 1024, exp - 25);
-                    }
-                }();
-                return sax->number_float((half & 0x8000u) != 0
-                                         ? static_cast<number_float_t>(-val)
-                                         : static_cast<number_float_t>(val), "");
+                const auto half = static_cast<std::uint16_t>((byte1 << 8u) + byte2);
+                return sax->number_float(static_cast<number_float_t>(half_float::to_float(half)), "");
             }
 
             case 0xFA: // Single-Precision Float (four-byte IEEE 754)
@@ -10137,6 +11851,180 @@ class binary_reader
         }
     }
 
+    /*!
+    @brief read the document of an indexed document (see cbor_index_tag)
+
+    @param[in] tag_handler how CBOR tags should be treated
+
+    @return whether the document was successfully parsed
+    */
+    bool get_cbor_indexed(const cbor_tag_handler_t tag_handler)
+    {
+        get();
+        if (JSON_HEDLEY_UNLIKELY(!unexpect_eof(input_format_t::cbor, "indexed document")))
+        {
+            return false;
+        }
+        if (JSON_HEDLEY_UNLIKELY(current != 0x82))
+        {
+            auto last_token = get_token_string();
+            return sax->parse_error(chars_read, last_token, parse_error::create(113, chars_read,
+                                    exception_message(input_format_t::cbor, concat("expected an array of index and document; last byte: 0x", last_token), "indexed document"), nullptr));
+        }
+
+        // the index is only needed for random access
+        binary_t index;
+        get();
+        if (JSON_HEDLEY_UNLIKELY(!get_cbor_binary(index)))
+        {
+            return false;
+        }
+        return parse_cbor_internal(true, tag_handler);
+    }
+
+    /// whether @a tag is an RFC 8746 typed array this reader decodes (no float128, no tag 76)
+    static bool is_cbor_typed_array_tag(const std::uint8_t tag) noexcept
+    {
+        return tag >= 64 && tag <= 86 && tag != 76 && tag != 83;
+    }
+
+    /*!
+    @brief read an RFC 8746 typed array as an array of numbers
+
+    @param[in] tag  the tag (is_cbor_typed_array_tag() is true); the byte
+                    string with the elements follows
+
+    @return whether the array was successfully parsed
+    */
+    bool get_cbor_typed_array(const std::uint8_t tag)
+    {
+        binary_t data;
+        get();
+        if (JSON_HEDLEY_UNLIKELY(!get_cbor_binary(data)))
+        {
+            return false;
+        }
+
+        // tag bits: 0b010 f s e ll (float, signed, little endian, size)
+        const bool is_float = (tag & 0x10u) != 0;
+        const bool reverse = ((tag & 0x04u) != 0) != is_little_endian;
+        const std::size_t element_size = is_float ? (std::size_t(2) << (tag & 0x03u)) : (std::size_t(1) << (tag & 0x03u));
+        if (JSON_HEDLEY_UNLIKELY(data.size() % element_size != 0))
+        {
+            auto last_token = get_token_string();
+            return sax->parse_error(chars_read, last_token, parse_error::create(113, chars_read,
+                                    exception_message(input_format_t::cbor, concat("typed array length must be a multiple of ", std::to_string(element_size), "; last byte: 0x", last_token), "typed array"), nullptr));
+        }
+
+        const std::size_t n = data.size() / element_size;
+        if (JSON_HEDLEY_UNLIKELY(!start_array(n)))
+        {
+            return false;
+        }
+
+        bool ok = true;
+        switch (tag)
+        {
+            case 64: // uint8
+            case 68: // uint8, clamped
+                ok = get_cbor_typed_array_elements<std::uint8_t>(data, n, reverse);
+                break;
+            case 65: // uint16, big endian
+            case 69: // uint16, little endian
+                ok = get_cbor_typed_array_elements<std::uint16_t>(data, n, reverse);
+                break;
+            case 66: // uint32, big endian
+            case 70: // uint32, little endian
+                ok = get_cbor_typed_array_elements<std::uint32_t>(data, n, reverse);
+                break;
+            case 67: // uint64, big endian
+            case 71: // uint64, little endian
+                ok = get_cbor_typed_array_elements<std::uint64_t>(data, n, reverse);
+                break;
+            case 72: // sint8
+                ok = get_cbor_typed_array_elements<std::int8_t>(data, n, reverse);
+                break;
+            case 73: // sint16, big endian
+            case 77: // sint16, little endian
+                ok = get_cbor_typed_array_elements<std::int16_t>(data, n, reverse);
+                break;
+            case 74: // sint32, big endian
+            case 78: // sint32, little endian
+                ok = get_cbor_typed_array_elements<std::int32_t>(data, n, reverse);
+                break;
+            case 75: // sint64, big endian
+            case 79: // sint64, little endian
+                ok = get_cbor_typed_array_elements<std::int64_t>(data, n, reverse);
+                break;
+            case 80: // float16, big endian
+            case 84: // float16, little endian
+                for (std::size_t i = 0; ok && i < n; ++i)
+                {
+                    const auto h = typed_array_element<std::uint16_t>(data.data() + i * 2, reverse);
+                    ok = sax->number_float(static_cast<number_float_t>(half_float::to_float(h)), "");
+                }
+                break;
+            case 81: // float32, big endian
+            case 85: // float32, little endian
+                ok = get_cbor_typed_array_elements<float>(data, n, reverse);
+                break;
+            case 82: // float64, big endian
+            case 86: // float64, little endian
+                ok = get_cbor_typed_array_elements<double>(data, n, reverse);
+                break;
+            default:                 // LCOV_EXCL_LINE
+                JSON_ASSERT(false); // NOLINT(cert-dcl03-c,hicpp-static-assert,misc-static-assert) LCOV_EXCL_LINE
+                return false;        // LCOV_EXCL_LINE
+        }
+
+        return ok && sax->end_array();
+    }
+
+    template<typename NumberType>
+    static NumberType typed_array_element(const std::uint8_t* p, const bool reverse) noexcept
+    {
+        std::array<std::uint8_t, sizeof(NumberType)> vec{};
+        std::memcpy(vec.data(), p, sizeof(NumberType));
+        if (reverse)
+        {
+            std::reverse(vec.begin(), vec.end());
+        }
+        NumberType result{};
+        std::memcpy(&result, vec.data(), sizeof(NumberType));
+        return result;
+    }
+
+    template<typename NumberType>
+    bool get_cbor_typed_array_elements(const binary_t& data, const std::size_t n, const bool reverse)
+    {
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (JSON_HEDLEY_UNLIKELY(!sax_typed_array_value(typed_array_element<NumberType>(data.data() + i * sizeof(NumberType), reverse))))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template < typename NumberType, enable_if_t < std::is_floating_point<NumberType>::value, int > = 0 >
+    bool sax_typed_array_value(const NumberType v)
+    {
+        return sax->number_float(static_cast<number_float_t>(v), "");
+    }
+
+    template < typename NumberType, enable_if_t < std::is_integral<NumberType>::value&& std::is_signed<NumberType>::value, int > = 0 >
+    bool sax_typed_array_value(const NumberType v)
+    {
+        return sax->number_integer(static_cast<number_integer_t>(v));
+    }
+
+    template < typename NumberType, enable_if_t < std::is_integral<NumberType>::value&& std::is_unsigned<NumberType>::value, int > = 0 >
+    bool sax_typed_array_value(const NumberType v)
+    {
+        return sax->number_unsigned(static_cast<number_unsigned_t>(v));
+    }
+
     /*!
     @brief reads a CBOR byte array
 
@@ -10246,33 +12134,201 @@ class binary_reader
     bool get_cbor_array(const std::size_t len,
                         const cbor_tag_handler_t tag_handler)
     {
-        if (JSON_HEDLEY_UNLIKELY(!sax->start_array(len)))
+        if (JSON_HEDLEY_UNLIKELY(!start_array(len)))
         {
             return false;
         }
 
         if (len != static_cast<std::size_t>(-1))
         {
-            for (std::size_t i = 0; i < len; ++i)
+            std::size_t remaining = len;
+            while (remaining > 0)
             {
+                // numbers sharing one header byte are decoded as a run (contiguous input only)
+                if (JSON_HEDLEY_UNLIKELY(!get_cbor_number_run(remaining, is_contiguous_input_adapter<InputAdapterType> {})))
+                {
+                    return false;
+                }
+                if (remaining == 0)
+                {
+                    break;
+                }
+
                 if (JSON_HEDLEY_UNLIKELY(!parse_cbor_internal(true, tag_handler)))
                 {
                     return false;
                 }
+                --remaining;
+            }
+        }
+        else
+        {
+            while (get() != 0xFF)
+            {
+                if (JSON_HEDLEY_UNLIKELY(!parse_cbor_internal(false, tag_handler)))
+                {
+                    return false;
+                }
             }
         }
-        else
+
+        return sax->end_array();
+    }
+
+    /*!
+    @brief read the following array elements which are numbers with the same header byte
+
+    Arrays of numbers repeat one header byte (0x1A, 0xFA, 0xFB, ...) before
+    every big-endian payload. Such a run is found by looking at the input
+    directly, and decoded in blocks without going through
+    parse_cbor_internal() and get() for every byte. Only complete items are
+    taken; anything else (and a truncated item) is left to
+    parse_cbor_internal(), so errors are reported as before.
+
+    @param[in,out] remaining  number of elements of the array not read yet
+    @return whether the SAX accepted the values
+    */
+    bool get_cbor_number_run(std::size_t& /*unused*/, std::false_type /*unused*/) noexcept
+    {
+        return true;
+    }
+
+    bool get_cbor_number_run(std::size_t& remaining, std::true_type /*unused*/)
+    {
+        const std::size_t available = ia.remaining_size();
+        if (available == 0)
+        {
+            return true;
+        }
+
+        const auto* p = reinterpret_cast<const std::uint8_t*>(ia.remaining_data());
+        switch (p[0])
+        {
+            case 0x18:
+                return get_cbor_number_run<std::uint8_t>(p, available, remaining, [this](std::uint8_t v)
+                {
+                    return sax->number_unsigned(v);
+                });
+            case 0x19:
+                return get_cbor_number_run<std::uint16_t>(p, available, remaining, [this](std::uint16_t v)
+                {
+                    return sax->number_unsigned(v);
+                });
+            case 0x1A:
+                return get_cbor_number_run<std::uint32_t>(p, available, remaining, [this](std::uint32_t v)
+                {
+                    return sax->number_unsigned(v);
+                });
+            case 0x1B:
+                return get_cbor_number_run<std::uint64_t>(p, available, remaining, [this](std::uint64_t v)
+                {
+                    return sax->number_unsigned(v);
+                });
+            case 0x38:
+                return get_cbor_number_run<std::uint8_t>(p, available, remaining, [this](std::uint8_t v)
+                {
+                    return sax->number_integer(static_cast<number_integer_t>(-1) - v);
+                });
+            case 0x39:
+                return get_cbor_number_run<std::uint16_t>(p, available, remaining, [this](std::uint16_t v)
+                {
+                    return sax->number_integer(static_cast<number_integer_t>(-1) - v);
+                });
+            case 0x3A:
+                return get_cbor_number_run<std::uint32_t>(p, available, remaining, [this](std::uint32_t v)
+                {
+                    return sax->number_integer(static_cast<number_integer_t>(-1) - v);
+                });
+            case 0x3B:
+                return get_cbor_number_run<std::uint64_t>(p, available, remaining, [this](std::uint64_t v)
+                {
+                    return sax->number_integer(static_cast<number_integer_t>(-1) - static_cast<number_integer_t>(v));
+                });
+            case 0xF9:
+                return get_cbor_number_run<std::uint16_t>(p, available, remaining, [this](std::uint16_t v)
+                {
+                    return sax->number_float(static_cast<number_float_t>(half_float::to_float(v)), empty_string);
+                });
+            case 0xFA:
+                return get_cbor_number_run<std::uint32_t>(p, available, remaining, [this](std::uint32_t v)
+                {
+                    float number{};
+                    std::memcpy(&number, &v, sizeof(number));
+                    return sax->number_float(static_cast<number_float_t>(number), empty_string);
+                });
+            case 0xFB:
+                return get_cbor_number_run<std::uint64_t>(p, available, remaining, [this](std::uint64_t v)
+                {
+                    double number{};
+                    std::memcpy(&number, &v, sizeof(number));
+                    return sax->number_float(static_cast<number_float_t>(number), empty_string);
+                });
+            default:
+                return true;
+        }
+    }
+
+    /*!
+    @param[in] p          the remaining input, starting with a header byte
+    @param[in] available  number of bytes in the input
+    @param[in,out] remaining  number of elements of the array not read yet
+    @param[in] emit       passes a payload (as an unsigned integer) to the SAX
+    */
+    template<typename UIntType, typename EmitType>
+    bool get_cbor_number_run(const std::uint8_t* p, const std::size_t available, std::size_t& remaining, EmitType emit)
+    {
+        constexpr std::size_t stride = 1 + sizeof(UIntType);
+        constexpr std::size_t block = 64;
+
+        // length of the run
+        const std::uint8_t header = p[0];
+        const std::size_t limit = (std::min)(remaining, available / stride);
+        std::size_t n = 0;
+        while (n < limit && p[n * stride] == header)
+        {
+            ++n;
+        }
+        if (n == 0)
+        {
+            return true;
+        }
+
+        std::array<UIntType, block> values{};
+        for (std::size_t i = 0; i < n; i += block)
         {
-            while (get() != 0xFF)
+            const std::size_t m = (std::min)(block, n - i);
+            const std::uint8_t* q = p + i * stride + 1;
+            for (std::size_t k = 0; k < m; ++k)
             {
-                if (JSON_HEDLEY_UNLIKELY(!parse_cbor_internal(false, tag_handler)))
+                values[k] = big_endian_value<UIntType>(q + k * stride);
+            }
+
+            ia.skip(m * stride);
+            chars_read += m * stride;
+            current = char_traits<char_type>::to_int_type(static_cast<char_type>(q[(m - 1) * stride + sizeof(UIntType) - 1]));
+            remaining -= m;
+
+            for (std::size_t k = 0; k < m; ++k)
+            {
+                if (JSON_HEDLEY_UNLIKELY(!emit(values[k])))
                 {
                     return false;
                 }
             }
         }
+        return true;
+    }
 
-        return sax->end_array();
+    /// unsigned integer from sizeof(UIntType) big-endian bytes
+    template<typename UIntType>
+    static UIntType big_endian_value(const std::uint8_t* p) noexcept
+    {
+        UIntType v = 0;
+        for (std::size_t i = 0; i < sizeof(UIntType); ++i)
+        {
+            v = static_cast<UIntType>((static_cast<std::uint64_t>(v) << 8u) | p[i]);
+        }
+        return v;
     }
 
     /*!
@@ -10284,7 +12340,7 @@ class binary_reader
     bool get_cbor_object(const std::size_t len,
                          const cbor_tag_handler_t tag_handler)
     {
-        if (JSON_HEDLEY_UNLIKELY(!sax->start_object(len)))
+        if (JSON_HEDLEY_UNLIKELY(!start_object(len)))
         {
             return false;
         }
@@ -10914,7 +12970,7 @@ class binary_reader
     */
     bool get_msgpack_array(const std::size_t len)
     {
-        if (JSON_HEDLEY_UNLIKELY(!sax->start_array(len)))
+        if (JSON_HEDLEY_UNLIKELY(!start_array(len)))
         {
             return false;
         }
@@ -10936,7 +12992,7 @@ class binary_reader
     */
     bool get_msgpack_object(const std::size_t len)
     {
-        if (JSON_HEDLEY_UNLIKELY(!sax->start_object(len)))
+        if (JSON_HEDLEY_UNLIKELY(!start_object(len)))
         {
             return false;
         }
@@ -11661,7 +13717,7 @@ class binary_reader
             }
 
             key = "_ArrayData_";
-            if (JSON_HEDLEY_UNLIKELY(!sax->key(key) || !sax->start_array(size_and_type.first) ))
+            if (JSON_HEDLEY_UNLIKELY(!sax->key(key) || !start_array(size_and_type.first)))
             {
                 return false;
             }
@@ -11679,7 +13735,7 @@ class binary_reader
 
         if (size_and_type.first != npos)
         {
-            if (JSON_HEDLEY_UNLIKELY(!sax->start_array(size_and_type.first)))
+            if (JSON_HEDLEY_UNLIKELY(!start_array(size_and_type.first)))
             {
                 return false;
             }
@@ -11750,7 +13806,7 @@ class binary_reader
         string_t key;
         if (size_and_type.first != npos)
         {
-            if (JSON_HEDLEY_UNLIKELY(!sax->start_object(size_and_type.first)))
+            if (JSON_HEDLEY_UNLIKELY(!start_object(size_and_type.first)))
             {
                 return false;
             }
@@ -11859,7 +13915,7 @@ class binary_reader
             case token_type::value_unsigned:
                 return sax->number_unsigned(number_lexer.get_number_unsigned());
             case token_type::value_float:
-                return sax->number_float(number_lexer.get_number_float(), std::move(number_string));
+                return sax->number_float(number_lexer.get_number_float(), string_t(number_string.begin(), number_string.end()));
             case token_type::uninitialized:
             case token_type::literal_true:
             case token_type::literal_false:
@@ -11977,7 +14033,7 @@ class binary_reader
                     string_t& result)
     {
         bool success = true;
-        for (NumberType i = 0; i < len; i++)
+        for (NumberType i = get_run(len, result, is_contiguous_input_adapter<InputAdapterType> {}); i < len; i++)
         {
             get();
             if (JSON_HEDLEY_UNLIKELY(!unexpect_eof(format, "string")))
@@ -12010,7 +14066,7 @@ class binary_reader
                     binary_t& result)
     {
         bool success = true;
-        for (NumberType i = 0; i < len; i++)
+        for (NumberType i = get_run(len, result, is_contiguous_input_adapter<InputAdapterType> {}); i < len; i++)
         {
             get();
             if (JSON_HEDLEY_UNLIKELY(!unexpect_eof(format, "binary")))
@@ -12023,6 +14079,86 @@ class binary_reader
         return success;
     }
 
+    /*!
+    @brief append the next bytes of a string or byte array at once
+
+    Up to @a len bytes available in the input are appended to @a result in one
+    step (contiguous input only). The position and current are updated as if
+    get() had been called for each byte, so the caller reads the rest (and
+    reports the end of input) byte by byte as before.
+
+    @return number of bytes appended
+    */
+    template<typename NumberType, typename ContainerType>
+    NumberType get_run(const NumberType /*unused*/, ContainerType& /*unused*/, std::false_type /*unused*/) noexcept
+    {
+        return 0;
+    }
+
+    template<typename NumberType, typename ContainerType>
+    NumberType get_run(const NumberType len, ContainerType& result, std::true_type /*unused*/)
+    {
+        const std::size_t available = ia.remaining_size();
+        if (!(len > 0) || available == 0)
+        {
+            return 0;
+        }
+
+        const std::size_t n = static_cast<std::uint64_t>(len) < available ? static_cast<std::size_t>(len) : available;
+        const auto* p = ia.remaining_data();
+        const auto* first = reinterpret_cast<const typename ContainerType::value_type*>(p);
+        result.insert(result.end(), first, first + n);
+
+        ia.skip(n);
+        chars_read += n;
+        current = char_traits<char_type>::to_int_type(p[n - 1]);
+        return static_cast<NumberType>(n);
+    }
+
+    /*!
+    @brief start an array / object of @a len elements and let the SAX reserve it
+
+    A SAX with reserve_back() (the DOM parsers) is asked to reserve @a len
+    elements. Every element takes at least one byte, so the reservations of
+    the whole input are bounded by its size (contiguous input only); a header
+    announcing more elements than the input holds does not allocate for them.
+    */
+    bool start_array(std::size_t len)
+    {
+        return sax->start_array(len) && reserve_back(len);
+    }
+
+    bool start_object(std::size_t len)
+    {
+        return sax->start_object(len) && reserve_back(len);
+    }
+
+    bool reserve_back(std::size_t len)
+    {
+        if (len != static_cast<std::size_t>(-1) && len > 0)
+        {
+            reserve_back(len, std::integral_constant < bool, is_contiguous_input_adapter<InputAdapterType>::value&&
+                         is_detected<reserve_back_function_t, SAX>::value > {});
+        }
+        return true;
+    }
+
+    void reserve_back(std::size_t /*unused*/, std::false_type /*unused*/) noexcept {}
+
+    void reserve_back(std::size_t len, std::true_type /*unused*/)
+    {
+        if (reserve_budget == static_cast<std::size_t>(-1))
+        {
+            reserve_budget = ia.remaining_size();
+        }
+        const std::size_t n = (std::min)(len, reserve_budget);
+        reserve_budget -= n;
+        if (n > 0)
+        {
+            sax->reserve_back(n);
+        }
+    }
+
     /*!
     @param[in] format   the current format (for diagnostics)
     @param[in] context  further context information (for diagnostics)
@@ -12103,6 +14239,12 @@ class binary_reader
     /// the number of characters read
     std::size_t chars_read = 0;
 
+    /// number of elements the SAX may still reserve (see start_array)
+    std::size_t reserve_budget = static_cast<std::size_t>(-1);
+
+    /// string_t argument of number_float for the binary formats
+    const string_t empty_string {};
+
     /// whether we can assume little endianness
     const bool is_little_endian = little_endianness();
 
@@ -15073,8 +17215,12 @@ namespace detail
 
 /*!
 @brief serialization to CBOR and MessagePack values
+
+@tparam OutputAdapterType  pointer-like handle of the output; any type with
+        write_character() and write_characters() can be used instead of the
+        output_adapter_protocol to avoid the virtual call per byte
 */
-template<typename BasicJsonType, typename CharType>
+template<typename BasicJsonType, typename CharType, typename OutputAdapterType = output_adapter_t<CharType>>
 class binary_writer
 {
     using string_t = typename BasicJsonType::string_t;
@@ -15087,11 +17233,39 @@ class binary_writer
 
     @param[in] adapter  output adapter to write to
     */
-    explicit binary_writer(output_adapter_t<CharType> adapter) : oa(std::move(adapter))
+    explicit binary_writer(OutputAdapterType adapter) : oa(std::move(adapter))
     {
         JSON_ASSERT(oa);
     }
 
+    /*!
+    @brief write CBOR floats as half precision (0xF9) when that is close enough
+
+    @param[in] tolerance  largest absolute error allowed for a half float;
+                          negative (the default) disables half floats
+    */
+    void set_cbor_float16_tolerance(const double tolerance) noexcept
+    {
+        cbor_float16_tolerance = tolerance;
+    }
+
+    /*!
+    @brief write CBOR arrays of numbers as RFC 8746 typed arrays
+
+    An array of only floats becomes a little-endian float16/float32/float64
+    array (tag 84/85/86): float16 if every element is within the float16
+    tolerance, float32 if every element is exact as float32. An array of only
+    integers becomes a little-endian integer array (tag 64/69/70/71 unsigned,
+    72/77/78/79 signed) of the smallest element size. binary_reader decodes
+    these tags back into arrays.
+
+    @param[in] typed_arrays  whether to write typed arrays (default: false)
+    */
+    void set_cbor_typed_arrays(const bool typed_arrays) noexcept
+    {
+        cbor_typed_arrays = typed_arrays;
+    }
+
     /*!
     @param[in] j  JSON value to serialize
     @pre       j.type() == value_t::object
@@ -15253,6 +17427,12 @@ class binary_writer
                     oa->write_character(j.m_data.m_value.number_float > 0 ? to_char_type(0x7C) : to_char_type(0xFC));
                     oa->write_character(to_char_type(0x00));
                 }
+                else if (cbor_float16_tolerance >= 0 && is_half_range(j.m_data.m_value.number_float))
+                {
+                    const auto f = static_cast<float>(j.m_data.m_value.number_float);
+                    const auto h = half_float::from_float(f);
+                    write_cbor_float16(j.m_data.m_value.number_float, h, half_float::to_float(h));
+                }
                 else
                 {
                     write_compact_float(j.m_data.m_value.number_float, detail::input_format_t::cbor);
@@ -15300,6 +17480,11 @@ class binary_writer
 
             case value_t::array:
             {
+                if (cbor_typed_arrays && write_cbor_typed_array(*j.m_data.m_value.array))
+                {
+                    break;
+                }
+
                 // step 1: write control byte and the array size
                 const auto N = j.m_data.m_value.array->size();
                 if (N <= 0x17)
@@ -15330,6 +17515,11 @@ class binary_writer
                 // LCOV_EXCL_STOP
 
                 // step 2: write each element
+                if (cbor_float16_tolerance >= 0)
+                {
+                    write_cbor_float16_array(*j.m_data.m_value.array);
+                    break;
+                }
                 for (const auto& el : *j.m_data.m_value.array)
                 {
                     write_cbor(el);
@@ -16748,53 +18938,371 @@ class binary_writer
         }
         else if (dtype == 'd')
         {
-            for (const auto& el : value.at(key))
+            for (const auto& el : value.at(key))
+            {
+                write_number(static_cast<float>(el.m_data.m_value.number_float), true);
+            }
+        }
+        else if (dtype == 'D')
+        {
+            for (const auto& el : value.at(key))
+            {
+                write_number(static_cast<double>(el.m_data.m_value.number_float), true);
+            }
+        }
+        return false;
+    }
+
+    ///////////////////////
+    // Utility functions //
+    ///////////////////////
+
+    /*
+    @brief write a number to output input
+    @param[in] n number of type @a NumberType
+    @param[in] OutputIsLittleEndian Set to true if output data is
+                                 required to be little endian
+    @tparam NumberType the type of the number
+
+    @note This function needs to respect the system's endianness, because bytes
+          in CBOR, MessagePack, and UBJSON are stored in network order (big
+          endian) and therefore need reordering on little endian systems.
+          On the other hand, BSON and BJData use little endian and should reorder
+          on big endian systems.
+    */
+    template<typename NumberType>
+    void write_number(const NumberType n, const bool OutputIsLittleEndian = false)
+    {
+        // step 1: write number to array of length NumberType
+        std::array<CharType, sizeof(NumberType)> vec{};
+        std::memcpy(vec.data(), &n, sizeof(NumberType));
+
+        // step 2: write array to output (with possible reordering)
+        if (is_little_endian != OutputIsLittleEndian)
+        {
+            // reverse byte order prior to conversion if necessary
+            std::reverse(vec.begin(), vec.end());
+        }
+
+        oa->write_characters(vec.data(), sizeof(NumberType));
+    }
+
+    /// whether @a n is finite and does not round to infinity as a half float
+    static bool is_half_range(const number_float_t n) noexcept
+    {
+        return std::abs(static_cast<double>(n)) < 65520.0;
+    }
+
+    /*!
+    @brief write a CBOR float as half float @a h if it is within the tolerance
+
+    @param[in] n  the value
+    @param[in] h  @a n as half float
+    @param[in] back  the value of @a h
+    */
+    void write_cbor_float16(const number_float_t n, const std::uint16_t h, const float back)
+    {
+        if (std::abs(static_cast<double>(back) - static_cast<double>(n)) <= cbor_float16_tolerance)
+        {
+            oa->write_character(to_char_type(0xF9));
+            write_number(h);
+        }
+        else
+        {
+            write_compact_float(n, detail::input_format_t::cbor);
+        }
+    }
+
+    /*!
+    @brief write the elements of an array with half floats enabled
+
+    Runs of floats are converted in blocks, so the conversion can use F16C.
+    */
+    void write_cbor_float16_array(const typename BasicJsonType::array_t& arr)
+    {
+        constexpr std::size_t block_size = 64;
+        std::array<float, block_size> in{};
+        std::array<std::uint16_t, block_size> out{};
+        std::array<float, block_size> back{};
+
+        std::size_t i = 0;
+        while (i < arr.size())
+        {
+            std::size_t n = 0;
+            while (n < block_size && i + n < arr.size() && arr[i + n].is_number_float()
+                    && is_half_range(arr[i + n].m_data.m_value.number_float))
+            {
+                in[n] = static_cast<float>(arr[i + n].m_data.m_value.number_float);
+                ++n;
+            }
+
+            if (n == 0)
+            {
+                write_cbor(arr[i]);
+                ++i;
+                continue;
+            }
+
+            half_float::convert(in.data(), out.data(), back.data(), n);
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                write_cbor_float16(arr[i + k].m_data.m_value.number_float, out[k], back[k]);
+            }
+            i += n;
+        }
+    }
+
+    /*!
+    @brief write @a arr as RFC 8746 typed array if all elements are numbers of one kind
+    @return false if nothing was written
+    */
+    bool write_cbor_typed_array(const typename BasicJsonType::array_t& arr)
+    {
+        // the tag and the byte string header cost more than they save on short arrays
+        if (arr.size() < 8)
+        {
+            return false;
+        }
+
+        if (arr.front().is_number_float())
+        {
+            bool float32 = true;
+            for (const auto& el : arr)
+            {
+                if (!el.is_number_float())
+                {
+                    return false;
+                }
+                float32 = float32 && is_float32_exact(el.m_data.m_value.number_float);
+            }
+
+            std::vector<std::uint16_t> halves;
+            if (cbor_float16_tolerance >= 0 && to_cbor_float16_values(arr, halves))
+            {
+                write_cbor_typed_array_elements<std::uint16_t>(84, arr.size(), [&halves](std::size_t i)
+                {
+                    return halves[i];
+                });
+            }
+            else if (float32)
+            {
+                write_cbor_typed_array_elements<float>(85, arr.size(), [&arr](std::size_t i)
+                {
+                    return static_cast<float>(arr[i].m_data.m_value.number_float);
+                });
+            }
+            else
+            {
+                write_cbor_typed_array_elements<double>(86, arr.size(), [&arr](std::size_t i)
+                {
+                    return static_cast<double>(arr[i].m_data.m_value.number_float);
+                });
+            }
+            return true;
+        }
+
+        // range of the integers
+        bool negative = false;
+        std::int64_t min_value = 0;
+        std::uint64_t max_value = 0;
+        for (const auto& el : arr)
+        {
+            if (el.is_number_unsigned())
+            {
+                max_value = (std::max)(max_value, static_cast<std::uint64_t>(el.m_data.m_value.number_unsigned));
+            }
+            else if (el.is_number_integer())
+            {
+                const auto v = static_cast<std::int64_t>(el.m_data.m_value.number_integer);
+                if (v < 0)
+                {
+                    negative = true;
+                    min_value = (std::min)(min_value, v);
+                }
+                else
+                {
+                    max_value = (std::max)(max_value, static_cast<std::uint64_t>(v));
+                }
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        const auto integer = [&arr](std::size_t i)
+        {
+            return arr[i].is_number_unsigned()
+                   ? static_cast<std::uint64_t>(arr[i].m_data.m_value.number_unsigned)
+                   : static_cast<std::uint64_t>(arr[i].m_data.m_value.number_integer);
+        };
+
+        if (!negative)
+        {
+            if (max_value <= (std::numeric_limits<std::uint8_t>::max)())
+            {
+                write_cbor_typed_array_elements<std::uint8_t>(64, arr.size(), integer);
+            }
+            else if (max_value <= (std::numeric_limits<std::uint16_t>::max)())
+            {
+                write_cbor_typed_array_elements<std::uint16_t>(69, arr.size(), integer);
+            }
+            else if (max_value <= (std::numeric_limits<std::uint32_t>::max)())
+            {
+                write_cbor_typed_array_elements<std::uint32_t>(70, arr.size(), integer);
+            }
+            else
+            {
+                write_cbor_typed_array_elements<std::uint64_t>(71, arr.size(), integer);
+            }
+            return true;
+        }
+
+        if (max_value > static_cast<std::uint64_t>((std::numeric_limits<std::int64_t>::max)()))
+        {
+            return false;
+        }
+        const auto max_signed = static_cast<std::int64_t>(max_value);
+        if (min_value >= (std::numeric_limits<std::int8_t>::min)() && max_signed <= (std::numeric_limits<std::int8_t>::max)())
+        {
+            write_cbor_typed_array_elements<std::int8_t>(72, arr.size(), integer);
+        }
+        else if (min_value >= (std::numeric_limits<std::int16_t>::min)() && max_signed <= (std::numeric_limits<std::int16_t>::max)())
+        {
+            write_cbor_typed_array_elements<std::int16_t>(77, arr.size(), integer);
+        }
+        else if (min_value >= (std::numeric_limits<std::int32_t>::min)() && max_signed <= (std::numeric_limits<std::int32_t>::max)())
+        {
+            write_cbor_typed_array_elements<std::int32_t>(78, arr.size(), integer);
+        }
+        else
+        {
+            write_cbor_typed_array_elements<std::int64_t>(79, arr.size(), integer);
+        }
+        return true;
+    }
+
+    /*!
+    @brief write the tag, the byte string header and @a n little-endian elements
+
+    @param[in] tag  RFC 8746 tag
+    @param[in] n  number of elements
+    @param[in] value  returns the i-th element (converted to NumberType)
+    */
+    template<typename NumberType, typename Getter>
+    void write_cbor_typed_array_elements(const std::uint8_t tag, const std::size_t n, Getter value)
+    {
+        oa->write_character(to_char_type(0xD8));
+        write_number(tag);
+
+        const auto N = n * sizeof(NumberType);
+        if (N <= 0x17)
+        {
+            write_number(static_cast<std::uint8_t>(0x40 + N));
+        }
+        else if (N <= (std::numeric_limits<std::uint8_t>::max)())
+        {
+            oa->write_character(to_char_type(0x58));
+            write_number(static_cast<std::uint8_t>(N));
+        }
+        else if (N <= (std::numeric_limits<std::uint16_t>::max)())
+        {
+            oa->write_character(to_char_type(0x59));
+            write_number(static_cast<std::uint16_t>(N));
+        }
+        else if (N <= (std::numeric_limits<std::uint32_t>::max)())
+        {
+            oa->write_character(to_char_type(0x5A));
+            write_number(static_cast<std::uint32_t>(N));
+        }
+        else
+        {
+            oa->write_character(to_char_type(0x5B));
+            write_number(static_cast<std::uint64_t>(N));
+        }
+
+        // elements are copied in blocks, so the output gets few large writes
+        constexpr std::size_t block_size = 4096;
+        std::vector<CharType> buf((std::min)(n, block_size) * sizeof(NumberType));
+        std::size_t len = 0;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const auto v = static_cast<NumberType>(value(i));
+            std::array<CharType, sizeof(NumberType)> vec{};
+            std::memcpy(vec.data(), &v, sizeof(NumberType));
+            if (!is_little_endian)
             {
-                write_number(static_cast<float>(el.m_data.m_value.number_float), true);
+                std::reverse(vec.begin(), vec.end());
             }
-        }
-        else if (dtype == 'D')
-        {
-            for (const auto& el : value.at(key))
+            std::memcpy(buf.data() + len, vec.data(), sizeof(NumberType));
+            len += sizeof(NumberType);
+
+            if (len == buf.size())
             {
-                write_number(static_cast<double>(el.m_data.m_value.number_float), true);
+                oa->write_characters(buf.data(), len);
+                len = 0;
             }
         }
-        return false;
+        if (len > 0)
+        {
+            oa->write_characters(buf.data(), len);
+        }
     }
 
-    ///////////////////////
-    // Utility functions //
-    ///////////////////////
-
-    /*
-    @brief write a number to output input
-    @param[in] n number of type @a NumberType
-    @param[in] OutputIsLittleEndian Set to true if output data is
-                                 required to be little endian
-    @tparam NumberType the type of the number
-
-    @note This function needs to respect the system's endianness, because bytes
-          in CBOR, MessagePack, and UBJSON are stored in network order (big
-          endian) and therefore need reordering on little endian systems.
-          On the other hand, BSON and BJData use little endian and should reorder
-          on big endian systems.
+    /*!
+    @brief the elements of @a arr (all floats) as half floats
+    @return false if any element is not within the float16 tolerance
     */
-    template<typename NumberType>
-    void write_number(const NumberType n, const bool OutputIsLittleEndian = false)
+    bool to_cbor_float16_values(const typename BasicJsonType::array_t& arr, std::vector<std::uint16_t>& halves) const
     {
-        // step 1: write number to array of length NumberType
-        std::array<CharType, sizeof(NumberType)> vec{};
-        std::memcpy(vec.data(), &n, sizeof(NumberType));
+        constexpr std::size_t block_size = 64;
+        std::array<float, block_size> in{};
+        std::array<float, block_size> back{};
 
-        // step 2: write array to output (with possible reordering)
-        if (is_little_endian != OutputIsLittleEndian)
+        halves.resize(arr.size());
+        for (std::size_t i = 0; i < arr.size(); i += block_size)
         {
-            // reverse byte order prior to conversion if necessary
-            std::reverse(vec.begin(), vec.end());
+            const auto n = (std::min)(block_size, arr.size() - i);
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                const auto v = arr[i + k].m_data.m_value.number_float;
+                if (std::isfinite(v) && !is_half_range(v))
+                {
+                    return false;
+                }
+                // NaN and infinity are exact in float16
+                in[k] = static_cast<float>(v);
+            }
+
+            half_float::convert(in.data(), halves.data() + i, back.data(), n);
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                const auto v = arr[i + k].m_data.m_value.number_float;
+                if (std::isfinite(v) && !(std::abs(static_cast<double>(back[k]) - static_cast<double>(v)) <= cbor_float16_tolerance))
+                {
+                    return false;
+                }
+            }
         }
+        return true;
+    }
 
-        oa->write_characters(vec.data(), sizeof(NumberType));
+    static bool is_float32_exact(const number_float_t n) noexcept
+    {
+        if (std::isnan(n) || std::isinf(n))
+        {
+            return true;
+        }
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+#endif
+        return static_cast<double>(n) >= static_cast<double>(std::numeric_limits<float>::lowest()) &&
+               static_cast<double>(n) <= static_cast<double>((std::numeric_limits<float>::max)()) &&
+               static_cast<double>(static_cast<float>(n)) == static_cast<double>(n);
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif
     }
 
     void write_compact_float(const number_float_t n, detail::input_format_t format)
@@ -16854,2217 +19362,2598 @@ class binary_writer
         return x;
     }
 
-    template < typename InputCharType, typename C = CharType,
-               enable_if_t <
-                   std::is_signed<C>::value &&
-                   std::is_signed<char>::value &&
-                   std::is_same<char, typename std::remove_cv<InputCharType>::type>::value
-                   > * = nullptr >
-    static constexpr CharType to_char_type(InputCharType x) noexcept
+    template < typename InputCharType, typename C = CharType,
+               enable_if_t <
+                   std::is_signed<C>::value &&
+                   std::is_signed<char>::value &&
+                   std::is_same<char, typename std::remove_cv<InputCharType>::type>::value
+                   > * = nullptr >
+    static constexpr CharType to_char_type(InputCharType x) noexcept
+    {
+        return x;
+    }
+
+  private:
+    /// whether we can assume little endianness
+    const bool is_little_endian = little_endianness();
+
+    /// the output
+    OutputAdapterType oa = nullptr;
+
+    /// largest error for CBOR half floats (negative: no half floats)
+    double cbor_float16_tolerance = -1.0;
+
+    /// whether to write CBOR arrays of numbers as RFC 8746 typed arrays
+    bool cbor_typed_arrays = false;
+};
+
+}  // namespace detail
+NLOHMANN_JSON_NAMESPACE_END
+
+// #include <nlohmann/detail/output/output_adapters.hpp>
+
+// #include <nlohmann/detail/output/serializer.hpp>
+//     __ _____ _____ _____
+//  __|  |   __|     |   | |  JSON for Modern C++
+// |  |  |__   |  |  | | | |  version 3.11.3
+// |_____|_____|_____|_|___|  https://github.com/nlohmann/json
+//
+// SPDX-FileCopyrightText: 2008-2009 Björn Hoehrmann <bjoern@hoehrmann.de>
+// SPDX-FileCopyrightText: 2013-2023 Niels Lohmann <https://nlohmann.me>
+// SPDX-License-Identifier: MIT
+
+
+
+#include <algorithm> // reverse, remove, fill, find, none_of
+#include <array> // array
+#include <clocale> // localeconv, lconv
+#include <cmath> // labs, isfinite, isnan, signbit
+#include <cstddef> // size_t, ptrdiff_t
+#include <cstdint> // uint8_t
+#include <cstdio> // snprintf
+#include <limits> // numeric_limits
+#include <string> // string, char_traits
+#include <iomanip> // setfill, setw
+#include <type_traits> // is_same
+#include <utility> // move
+
+// #include <nlohmann/detail/conversions/to_chars.hpp>
+//     __ _____ _____ _____
+//  __|  |   __|     |   | |  JSON for Modern C++
+// |  |  |__   |  |  | | | |  version 3.11.3
+// |_____|_____|_____|_|___|  https://github.com/nlohmann/json
+//
+// SPDX-FileCopyrightText: 2009 Florian Loitsch <https://florian.loitsch.com/>
+// SPDX-FileCopyrightText: 2013-2023 Niels Lohmann <https://nlohmann.me>
+// SPDX-License-Identifier: MIT
+
+
+
+#include <array> // array
+#include <cmath>   // signbit, isfinite
+#include <cstdint> // intN_t, uintN_t
+#include <cstring> // memcpy, memmove
+#include <limits> // numeric_limits
+#include <type_traits> // conditional
+
+// #include <nlohmann/detail/macro_scope.hpp>
+
+
+NLOHMANN_JSON_NAMESPACE_BEGIN
+namespace detail
+{
+
+/*!
+@brief implements the Grisu2 algorithm for binary to decimal floating-point
+conversion.
+
+This implementation is a slightly modified version of the reference
+implementation which may be obtained from
+http://florian.loitsch.com/publications (bench.tar.gz).
+
+The code is distributed under the MIT license, Copyright (c) 2009 Florian Loitsch.
+
+For a detailed description of the algorithm see:
+
+[1] Loitsch, "Printing Floating-Point Numbers Quickly and Accurately with
+    Integers", Proceedings of the ACM SIGPLAN 2010 Conference on Programming
+    Language Design and Implementation, PLDI 2010
+[2] Burger, Dybvig, "Printing Floating-Point Numbers Quickly and Accurately",
+    Proceedings of the ACM SIGPLAN 1996 Conference on Programming Language
+    Design and Implementation, PLDI 1996
+*/
+namespace dtoa_impl
+{
+
+template<typename Target, typename Source>
+Target reinterpret_bits(const Source source)
+{
+    static_assert(sizeof(Target) == sizeof(Source), "size mismatch");
+
+    Target target;
+    std::memcpy(&target, &source, sizeof(Source));
+    return target;
+}
+
+struct diyfp // f * 2^e
+{
+    static constexpr int kPrecision = 64; // = q
+
+    std::uint64_t f = 0;
+    int e = 0;
+
+    constexpr diyfp(std::uint64_t f_, int e_) noexcept : f(f_), e(e_) {}
+
+    /*!
+    @brief returns x - y
+    @pre x.e == y.e and x.f >= y.f
+    */
+    static diyfp sub(const diyfp& x, const diyfp& y) noexcept
+    {
+        JSON_ASSERT(x.e == y.e);
+        JSON_ASSERT(x.f >= y.f);
+
+        return {x.f - y.f, x.e};
+    }
+
+    /*!
+    @brief returns x * y
+    @note The result is rounded. (Only the upper q bits are returned.)
+    */
+    static diyfp mul(const diyfp& x, const diyfp& y) noexcept
+    {
+        static_assert(kPrecision == 64, "internal error");
+
+        // Computes:
+        //  f = round((x.f * y.f) / 2^q)
+        //  e = x.e + y.e + q
+
+        // Emulate the 64-bit * 64-bit multiplication:
+        //
+        // p = u * v
+        //   = (u_lo + 2^32 u_hi) (v_lo + 2^32 v_hi)
+        //   = (u_lo v_lo         ) + 2^32 ((u_lo v_hi         ) + (u_hi v_lo         )) + 2^64 (u_hi v_hi         )
+        //   = (p0                ) + 2^32 ((p1                ) + (p2                )) + 2^64 (p3                )
+        //   = (p0_lo + 2^32 p0_hi) + 2^32 ((p1_lo + 2^32 p1_hi) + (p2_lo + 2^32 p2_hi)) + 2^64 (p3                )
+        //   = (p0_lo             ) + 2^32 (p0_hi + p1_lo + p2_lo                      ) + 2^64 (p1_hi + p2_hi + p3)
+        //   = (p0_lo             ) + 2^32 (Q                                          ) + 2^64 (H                 )
+        //   = (p0_lo             ) + 2^32 (Q_lo + 2^32 Q_hi                           ) + 2^64 (H                 )
+        //
+        // (Since Q might be larger than 2^32 - 1)
+        //
+        //   = (p0_lo + 2^32 Q_lo) + 2^64 (Q_hi + H)
+        //
+        // (Q_hi + H does not overflow a 64-bit int)
+        //
+        //   = p_lo + 2^64 p_hi
+
+        const std::uint64_t u_lo = x.f & 0xFFFFFFFFu;
+        const std::uint64_t u_hi = x.f >> 32u;
+        const std::uint64_t v_lo = y.f & 0xFFFFFFFFu;
+        const std::uint64_t v_hi = y.f >> 32u;
+
+        const std::uint64_t p0 = u_lo * v_lo;
+        const std::uint64_t p1 = u_lo * v_hi;
+        const std::uint64_t p2 = u_hi * v_lo;
+        const std::uint64_t p3 = u_hi * v_hi;
+
+        const std::uint64_t p0_hi = p0 >> 32u;
+        const std::uint64_t p1_lo = p1 & 0xFFFFFFFFu;
+        const std::uint64_t p1_hi = p1 >> 32u;
+        const std::uint64_t p2_lo = p2 & 0xFFFFFFFFu;
+        const std::uint64_t p2_hi = p2 >> 32u;
+
+        std::uint64_t Q = p0_hi + p1_lo + p2_lo;
+
+        // The full product might now be computed as
+        //
+        // p_hi = p3 + p2_hi + p1_hi + (Q >> 32)
+        // p_lo = p0_lo + (Q << 32)
+        //
+        // But in this particular case here, the full p_lo is not required.
+        // Effectively we only need to add the highest bit in p_lo to p_hi (and
+        // Q_hi + 1 does not overflow).
+
+        Q += std::uint64_t{1} << (64u - 32u - 1u); // round, ties up
+
+        const std::uint64_t h = p3 + p2_hi + p1_hi + (Q >> 32u);
+
+        return {h, x.e + y.e + 64};
+    }
+
+    /*!
+    @brief normalize x such that the significand is >= 2^(q-1)
+    @pre x.f != 0
+    */
+    static diyfp normalize(diyfp x) noexcept
     {
+        JSON_ASSERT(x.f != 0);
+
+        while ((x.f >> 63u) == 0)
+        {
+            x.f <<= 1u;
+            x.e--;
+        }
+
         return x;
     }
 
-  private:
-    /// whether we can assume little endianness
-    const bool is_little_endian = little_endianness();
+    /*!
+    @brief normalize x such that the result has the exponent E
+    @pre e >= x.e and the upper e - x.e bits of x.f must be zero.
+    */
+    static diyfp normalize_to(const diyfp& x, const int target_exponent) noexcept
+    {
+        const int delta = x.e - target_exponent;
 
-    /// the output
-    output_adapter_t<CharType> oa = nullptr;
+        JSON_ASSERT(delta >= 0);
+        JSON_ASSERT(((x.f << delta) >> delta) == x.f);
+
+        return {x.f << delta, target_exponent};
+    }
 };
 
-}  // namespace detail
-NLOHMANN_JSON_NAMESPACE_END
+struct boundaries
+{
+    diyfp w;
+    diyfp minus;
+    diyfp plus;
+};
 
-// #include <nlohmann/detail/output/output_adapters.hpp>
+/*!
+Compute the (normalized) diyfp representing the input number 'value' and its
+boundaries.
 
-// #include <nlohmann/detail/output/serializer.hpp>
-//     __ _____ _____ _____
-//  __|  |   __|     |   | |  JSON for Modern C++
-// |  |  |__   |  |  | | | |  version 3.11.3
-// |_____|_____|_____|_|___|  https://github.com/nlohmann/json
-//
-// SPDX-FileCopyrightText: 2008-2009 Björn Hoehrmann <bjoern@hoehrmann.de>
-// SPDX-FileCopyrightText: 2013-2023 Niels Lohmann <https://nlohmann.me>
-// SPDX-License-Identifier: MIT
+@pre value must be finite and positive
+*/
+template<typename FloatType>
+boundaries compute_boundaries(FloatType value)
+{
+    JSON_ASSERT(std::isfinite(value));
+    JSON_ASSERT(value > 0);
 
+    // Convert the IEEE representation into a diyfp.
+    //
+    // If v is denormal:
+    //      value = 0.F * 2^(1 - bias) = (          F) * 2^(1 - bias - (p-1))
+    // If v is normalized:
+    //      value = 1.F * 2^(E - bias) = (2^(p-1) + F) * 2^(E - bias - (p-1))
 
+    static_assert(std::numeric_limits<FloatType>::is_iec559,
+                  "internal error: dtoa_short requires an IEEE-754 floating-point implementation");
 
-#include <algorithm> // reverse, remove, fill, find, none_of
-#include <array> // array
-#include <clocale> // localeconv, lconv
-#include <cmath> // labs, isfinite, isnan, signbit
-#include <cstddef> // size_t, ptrdiff_t
-#include <cstdint> // uint8_t
-#include <cstdio> // snprintf
-#include <limits> // numeric_limits
-#include <string> // string, char_traits
-#include <iomanip> // setfill, setw
-#include <type_traits> // is_same
-#include <utility> // move
+    constexpr int      kPrecision = std::numeric_limits<FloatType>::digits; // = p (includes the hidden bit)
+    constexpr int      kBias      = std::numeric_limits<FloatType>::max_exponent - 1 + (kPrecision - 1);
+    constexpr int      kMinExp    = 1 - kBias;
+    constexpr std::uint64_t kHiddenBit = std::uint64_t{1} << (kPrecision - 1); // = 2^(p-1)
 
-// #include <nlohmann/detail/conversions/to_chars.hpp>
-//     __ _____ _____ _____
-//  __|  |   __|     |   | |  JSON for Modern C++
-// |  |  |__   |  |  | | | |  version 3.11.3
-// |_____|_____|_____|_|___|  https://github.com/nlohmann/json
-//
-// SPDX-FileCopyrightText: 2009 Florian Loitsch <https://florian.loitsch.com/>
-// SPDX-FileCopyrightText: 2013-2023 Niels Lohmann <https://nlohmann.me>
-// SPDX-License-Identifier: MIT
+    using bits_type = typename std::conditional<kPrecision == 24, std::uint32_t, std::uint64_t >::type;
 
+    const auto bits = static_cast<std::uint64_t>(reinterpret_bits<bits_type>(value));
+    const std::uint64_t E = bits >> (kPrecision - 1);
+    const std::uint64_t F = bits & (kHiddenBit - 1);
 
+    const bool is_denormal = E == 0;
+    const diyfp v = is_denormal
+                    ? diyfp(F, kMinExp)
+                    : diyfp(F + kHiddenBit, static_cast<int>(E) - kBias);
 
-#include <array> // array
-#include <cmath>   // signbit, isfinite
-#include <cstdint> // intN_t, uintN_t
-#include <cstring> // memcpy, memmove
-#include <limits> // numeric_limits
-#include <type_traits> // conditional
+    // Compute the boundaries m- and m+ of the floating-point value
+    // v = f * 2^e.
+    //
+    // Determine v- and v+, the floating-point predecessor and successor if v,
+    // respectively.
+    //
+    //      v- = v - 2^e        if f != 2^(p-1) or e == e_min                (A)
+    //         = v - 2^(e-1)    if f == 2^(p-1) and e > e_min                (B)
+    //
+    //      v+ = v + 2^e
+    //
+    // Let m- = (v- + v) / 2 and m+ = (v + v+) / 2. All real numbers _strictly_
+    // between m- and m+ round to v, regardless of how the input rounding
+    // algorithm breaks ties.
+    //
+    //      ---+-------------+-------------+-------------+-------------+---  (A)
+    //         v-            m-            v             m+            v+
+    //
+    //      -----------------+------+------+-------------+-------------+---  (B)
+    //                       v-     m-     v             m+            v+
 
-// #include <nlohmann/detail/macro_scope.hpp>
+    const bool lower_boundary_is_closer = F == 0 && E > 1;
+    const diyfp m_plus = diyfp(2 * v.f + 1, v.e - 1);
+    const diyfp m_minus = lower_boundary_is_closer
+                          ? diyfp(4 * v.f - 1, v.e - 2)  // (B)
+                          : diyfp(2 * v.f - 1, v.e - 1); // (A)
 
+    // Determine the normalized w+ = m+.
+    const diyfp w_plus = diyfp::normalize(m_plus);
 
-NLOHMANN_JSON_NAMESPACE_BEGIN
-namespace detail
+    // Determine w- = m- such that e_(w-) = e_(w+).
+    const diyfp w_minus = diyfp::normalize_to(m_minus, w_plus.e);
+
+    return {diyfp::normalize(v), w_minus, w_plus};
+}
+
+// Given normalized diyfp w, Grisu needs to find a (normalized) cached
+// power-of-ten c, such that the exponent of the product c * w = f * 2^e lies
+// within a certain range [alpha, gamma] (Definition 3.2 from [1])
+//
+//      alpha <= e = e_c + e_w + q <= gamma
+//
+// or
+//
+//      f_c * f_w * 2^alpha <= f_c 2^(e_c) * f_w 2^(e_w) * 2^q
+//                          <= f_c * f_w * 2^gamma
+//
+// Since c and w are normalized, i.e. 2^(q-1) <= f < 2^q, this implies
+//
+//      2^(q-1) * 2^(q-1) * 2^alpha <= c * w * 2^q < 2^q * 2^q * 2^gamma
+//
+// or
+//
+//      2^(q - 2 + alpha) <= c * w < 2^(q + gamma)
+//
+// The choice of (alpha,gamma) determines the size of the table and the form of
+// the digit generation procedure. Using (alpha,gamma)=(-60,-32) works out well
+// in practice:
+//
+// The idea is to cut the number c * w = f * 2^e into two parts, which can be
+// processed independently: An integral part p1, and a fractional part p2:
+//
+//      f * 2^e = ( (f div 2^-e) * 2^-e + (f mod 2^-e) ) * 2^e
+//              = (f div 2^-e) + (f mod 2^-e) * 2^e
+//              = p1 + p2 * 2^e
+//
+// The conversion of p1 into decimal form requires a series of divisions and
+// modulos by (a power of) 10. These operations are faster for 32-bit than for
+// 64-bit integers, so p1 should ideally fit into a 32-bit integer. This can be
+// achieved by choosing
+//
+//      -e >= 32   or   e <= -32 := gamma
+//
+// In order to convert the fractional part
+//
+//      p2 * 2^e = p2 / 2^-e = d[-1] / 10^1 + d[-2] / 10^2 + ...
+//
+// into decimal form, the fraction is repeatedly multiplied by 10 and the digits
+// d[-i] are extracted in order:
+//
+//      (10 * p2) div 2^-e = d[-1]
+//      (10 * p2) mod 2^-e = d[-2] / 10^1 + ...
+//
+// The multiplication by 10 must not overflow. It is sufficient to choose
+//
+//      10 * p2 < 16 * p2 = 2^4 * p2 <= 2^64.
+//
+// Since p2 = f mod 2^-e < 2^-e,
+//
+//      -e <= 60   or   e >= -60 := alpha
+
+constexpr int kAlpha = -60;
+constexpr int kGamma = -32;
+
+struct cached_power // c = f * 2^e ~= 10^k
+{
+    std::uint64_t f;
+    int e;
+    int k;
+};
+
+/*!
+For a normalized diyfp w = f * 2^e, this function returns a (normalized) cached
+power-of-ten c = f_c * 2^e_c, such that the exponent of the product w * c
+satisfies (Definition 3.2 from [1])
+
+     alpha <= e_c + e + q <= gamma.
+*/
+inline cached_power get_cached_power_for_binary_exponent(int e)
 {
+    // Now
+    //
+    //      alpha <= e_c + e + q <= gamma                                    (1)
+    //      ==> f_c * 2^alpha <= c * 2^e * 2^q
+    //
+    // and since the c's are normalized, 2^(q-1) <= f_c,
+    //
+    //      ==> 2^(q - 1 + alpha) <= c * 2^(e + q)
+    //      ==> 2^(alpha - e - 1) <= c
+    //
+    // If c were an exact power of ten, i.e. c = 10^k, one may determine k as
+    //
+    //      k = ceil( log_10( 2^(alpha - e - 1) ) )
+    //        = ceil( (alpha - e - 1) * log_10(2) )
+    //
+    // From the paper:
+    // "In theory the result of the procedure could be wrong since c is rounded,
+    //  and the computation itself is approximated [...]. In practice, however,
+    //  this simple function is sufficient."
+    //
+    // For IEEE double precision floating-point numbers converted into
+    // normalized diyfp's w = f * 2^e, with q = 64,
+    //
+    //      e >= -1022      (min IEEE exponent)
+    //           -52        (p - 1)
+    //           -52        (p - 1, possibly normalize denormal IEEE numbers)
+    //           -11        (normalize the diyfp)
+    //         = -1137
+    //
+    // and
+    //
+    //      e <= +1023      (max IEEE exponent)
+    //           -52        (p - 1)
+    //           -11        (normalize the diyfp)
+    //         = 960
+    //
+    // This binary exponent range [-1137,960] results in a decimal exponent
+    // range [-307,324]. One does not need to store a cached power for each
+    // k in this range. For each such k it suffices to find a cached power
+    // such that the exponent of the product lies in [alpha,gamma].
+    // This implies that the difference of the decimal exponents of adjacent
+    // table entries must be less than or equal to
+    //
+    //      floor( (gamma - alpha) * log_10(2) ) = 8.
+    //
+    // (A smaller distance gamma-alpha would require a larger table.)
 
-/*!
-@brief implements the Grisu2 algorithm for binary to decimal floating-point
-conversion.
+    // NB:
+    // Actually this function returns c, such that -60 <= e_c + e + 64 <= -34.
 
-This implementation is a slightly modified version of the reference
-implementation which may be obtained from
-http://florian.loitsch.com/publications (bench.tar.gz).
+    constexpr int kCachedPowersMinDecExp = -300;
+    constexpr int kCachedPowersDecStep = 8;
 
-The code is distributed under the MIT license, Copyright (c) 2009 Florian Loitsch.
+    static constexpr std::array<cached_power, 79> kCachedPowers =
+    {
+        {
+            { 0xAB70FE17C79AC6CA, -1060, -300 },
+            { 0xFF77B1FCBEBCDC4F, -1034, -292 },
+            { 0xBE5691EF416BD60C, -1007, -284 },
+            { 0x8DD01FAD907FFC3C,  -980, -276 },
+            { 0xD3515C2831559A83,  -954, -268 },
+            { 0x9D71AC8FADA6C9B5,  -927, -260 },
+            { 0xEA9C227723EE8BCB,  -901, -252 },
+            { 0xAECC49914078536D,  -874, -244 },
+            { 0x823C12795DB6CE57,  -847, -236 },
+            { 0xC21094364DFB5637,  -821, -228 },
+            { 0x9096EA6F3848984F,  -794, -220 },
+            { 0xD77485CB25823AC7,  -768, -212 },
+            { 0xA086CFCD97BF97F4,  -741, -204 },
+            { 0xEF340A98172AACE5,  -715, -196 },
+            { 0xB23867FB2A35B28E,  -688, -188 },
+            { 0x84C8D4DFD2C63F3B,  -661, -180 },
+            { 0xC5DD44271AD3CDBA,  -635, -172 },
+            { 0x936B9FCEBB25C996,  -608, -164 },
+            { 0xDBAC6C247D62A584,  -582, -156 },
+            { 0xA3AB66580D5FDAF6,  -555, -148 },
+            { 0xF3E2F893DEC3F126,  -529, -140 },
+            { 0xB5B5ADA8AAFF80B8,  -502, -132 },
+            { 0x87625F056C7C4A8B,  -475, -124 },
+            { 0xC9BCFF6034C13053,  -449, -116 },
+            { 0x964E858C91BA2655,  -422, -108 },
+            { 0xDFF9772470297EBD,  -396, -100 },
+            { 0xA6DFBD9FB8E5B88F,  -369,  -92 },
+            { 0xF8A95FCF88747D94,  -343,  -84 },
+            { 0xB94470938FA89BCF,  -316,  -76 },
+            { 0x8A08F0F8BF0F156B,  -289,  -68 },
+            { 0xCDB02555653131B6,  -263,  -60 },
+            { 0x993FE2C6D07B7FAC,  -236,  -52 },
+            { 0xE45C10C42A2B3B06,  -210,  -44 },
+            { 0xAA242499697392D3,  -183,  -36 },
+            { 0xFD87B5F28300CA0E,  -157,  -28 },
+            { 0xBCE5086492111AEB,  -130,  -20 },
+            { 0x8CBCCC096F5088CC,  -103,  -12 },
+            { 0xD1B71758E219652C,   -77,   -4 },
+            { 0x9C40000000000000,   -50,    4 },
+            { 0xE8D4A51000000000,   -24,   12 },
+            { 0xAD78EBC5AC620000,     3,   20 },
+            { 0x813F3978F8940984,    30,   28 },
+            { 0xC097CE7BC90715B3,    56,   36 },
+            { 0x8F7E32CE7BEA5C70,    83,   44 },
+            { 0xD5D238A4ABE98068,   109,   52 },
+            { 0x9F4F2726179A2245,   136,   60 },
+            { 0xED63A231D4C4FB27,   162,   68 },
+            { 0xB0DE65388CC8ADA8,   189,   76 },
+            { 0x83C7088E1AAB65DB,   216,   84 },
+            { 0xC45D1DF942711D9A,   242,   92 },
+            { 0x924D692CA61BE758,   269,  100 },
+            { 0xDA01EE641A708DEA,   295,  108 },
+            { 0xA26DA3999AEF774A,   322,  116 },
+            { 0xF209787BB47D6B85,   348,  124 },
+            { 0xB454E4A179DD1877,   375,  132 },
+            { 0x865B86925B9BC5C2,   402,  140 },
+            { 0xC83553C5C8965D3D,   428,  148 },
+            { 0x952AB45CFA97A0B3,   455,  156 },
+            { 0xDE469FBD99A05FE3,   481,  164 },
+            { 0xA59BC234DB398C25,   508,  172 },
+            { 0xF6C69A72A3989F5C,   534,  180 },
+            { 0xB7DCBF5354E9BECE,   561,  188 },
+            { 0x88FCF317F22241E2,   588,  196 },
+            { 0xCC20CE9BD35C78A5,   614,  204 },
+            { 0x98165AF37B2153DF,   641,  212 },
+            { 0xE2A0B5DC971F303A,   667,  220 },
+            { 0xA8D9D1535CE3B396,   694,  228 },
+            { 0xFB9B7CD9A4A7443C,   720,  236 },
+            { 0xBB764C4CA7A44410,   747,  244 },
+            { 0x8BAB8EEFB6409C1A,   774,  252 },
+            { 0xD01FEF10A657842C,   800,  260 },
+            { 0x9B10A4E5E9913129,   827,  268 },
+            { 0xE7109BFBA19C0C9D,   853,  276 },
+            { 0xAC2820D9623BF429,   880,  284 },
+            { 0x80444B5E7AA7CF85,   907,  292 },
+            { 0xBF21E44003ACDD2D,   933,  300 },
+            { 0x8E679C2F5E44FF8F,   960,  308 },
+            { 0xD433179D9C8CB841,   986,  316 },
+            { 0x9E19DB92B4E31BA9,  1013,  324 },
+        }
+    };
 
-For a detailed description of the algorithm see:
+    // This computation gives exactly the same results for k as
+    //      k = ceil((kAlpha - e - 1) * 0.30102999566398114)
+    // for |e| <= 1500, but doesn't require floating-point operations.
+    // NB: log_10(2) ~= 78913 / 2^18
+    JSON_ASSERT(e >= -1500);
+    JSON_ASSERT(e <=  1500);
+    const int f = kAlpha - e - 1;
+    const int k = (f * 78913) / (1 << 18) + static_cast<int>(f > 0);
 
-[1] Loitsch, "Printing Floating-Point Numbers Quickly and Accurately with
-    Integers", Proceedings of the ACM SIGPLAN 2010 Conference on Programming
-    Language Design and Implementation, PLDI 2010
-[2] Burger, Dybvig, "Printing Floating-Point Numbers Quickly and Accurately",
-    Proceedings of the ACM SIGPLAN 1996 Conference on Programming Language
-    Design and Implementation, PLDI 1996
-*/
-namespace dtoa_impl
-{
+    const int index = (-kCachedPowersMinDecExp + k + (kCachedPowersDecStep - 1)) / kCachedPowersDecStep;
+    JSON_ASSERT(index >= 0);
+    JSON_ASSERT(static_cast<std::size_t>(index) < kCachedPowers.size());
 
-template<typename Target, typename Source>
-Target reinterpret_bits(const Source source)
-{
-    static_assert(sizeof(Target) == sizeof(Source), "size mismatch");
+    const cached_power cached = kCachedPowers[static_cast<std::size_t>(index)];
+    JSON_ASSERT(kAlpha <= cached.e + e + 64);
+    JSON_ASSERT(kGamma >= cached.e + e + 64);
 
-    Target target;
-    std::memcpy(&target, &source, sizeof(Source));
-    return target;
+    return cached;
 }
 
-struct diyfp // f * 2^e
+/*!
+For n != 0, returns k, such that pow10 := 10^(k-1) <= n < 10^k.
+For n == 0, returns 1 and sets pow10 := 1.
+*/
+inline int find_largest_pow10(const std::uint32_t n, std::uint32_t& pow10)
 {
-    static constexpr int kPrecision = 64; // = q
-
-    std::uint64_t f = 0;
-    int e = 0;
-
-    constexpr diyfp(std::uint64_t f_, int e_) noexcept : f(f_), e(e_) {}
-
-    /*!
-    @brief returns x - y
-    @pre x.e == y.e and x.f >= y.f
-    */
-    static diyfp sub(const diyfp& x, const diyfp& y) noexcept
+    // LCOV_EXCL_START
+    if (n >= 1000000000)
     {
-        JSON_ASSERT(x.e == y.e);
-        JSON_ASSERT(x.f >= y.f);
-
-        return {x.f - y.f, x.e};
+        pow10 = 1000000000;
+        return 10;
     }
-
-    /*!
-    @brief returns x * y
-    @note The result is rounded. (Only the upper q bits are returned.)
-    */
-    static diyfp mul(const diyfp& x, const diyfp& y) noexcept
+    // LCOV_EXCL_STOP
+    if (n >= 100000000)
     {
-        static_assert(kPrecision == 64, "internal error");
-
-        // Computes:
-        //  f = round((x.f * y.f) / 2^q)
-        //  e = x.e + y.e + q
-
-        // Emulate the 64-bit * 64-bit multiplication:
-        //
-        // p = u * v
-        //   = (u_lo + 2^32 u_hi) (v_lo + 2^32 v_hi)
-        //   = (u_lo v_lo         ) + 2^32 ((u_lo v_hi         ) + (u_hi v_lo         )) + 2^64 (u_hi v_hi         )
-        //   = (p0                ) + 2^32 ((p1                ) + (p2                )) + 2^64 (p3                )
-        //   = (p0_lo + 2^32 p0_hi) + 2^32 ((p1_lo + 2^32 p1_hi) + (p2_lo + 2^32 p2_hi)) + 2^64 (p3                )
-        //   = (p0_lo             ) + 2^32 (p0_hi + p1_lo + p2_lo                      ) + 2^64 (p1_hi + p2_hi + p3)
-        //   = (p0_lo             ) + 2^32 (Q                                          ) + 2^64 (H                 )
-        //   = (p0_lo             ) + 2^32 (Q_lo + 2^32 Q_hi                           ) + 2^64 (H                 )
-        //
-        // (Since Q might be larger than 2^32 - 1)
-        //
-        //   = (p0_lo + 2^32 Q_lo) + 2^64 (Q_hi + H)
-        //
-        // (Q_hi + H does not overflow a 64-bit int)
-        //
-        //   = p_lo + 2^64 p_hi
-
-        const std::uint64_t u_lo = x.f & 0xFFFFFFFFu;
-        const std::uint64_t u_hi = x.f >> 32u;
-        const std::uint64_t v_lo = y.f & 0xFFFFFFFFu;
-        const std::uint64_t v_hi = y.f >> 32u;
-
-        const std::uint64_t p0 = u_lo * v_lo;
-        const std::uint64_t p1 = u_lo * v_hi;
-        const std::uint64_t p2 = u_hi * v_lo;
-        const std::uint64_t p3 = u_hi * v_hi;
-
-        const std::uint64_t p0_hi = p0 >> 32u;
-        const std::uint64_t p1_lo = p1 & 0xFFFFFFFFu;
-        const std::uint64_t p1_hi = p1 >> 32u;
-        const std::uint64_t p2_lo = p2 & 0xFFFFFFFFu;
-        const std::uint64_t p2_hi = p2 >> 32u;
-
-        std::uint64_t Q = p0_hi + p1_lo + p2_lo;
-
-        // The full product might now be computed as
-        //
-        // p_hi = p3 + p2_hi + p1_hi + (Q >> 32)
-        // p_lo = p0_lo + (Q << 32)
-        //
-        // But in this particular case here, the full p_lo is not required.
-        // Effectively we only need to add the highest bit in p_lo to p_hi (and
-        // Q_hi + 1 does not overflow).
-
-        Q += std::uint64_t{1} << (64u - 32u - 1u); // round, ties up
-
-        const std::uint64_t h = p3 + p2_hi + p1_hi + (Q >> 32u);
-
-        return {h, x.e + y.e + 64};
+        pow10 = 100000000;
+        return  9;
+    }
+    if (n >= 10000000)
+    {
+        pow10 = 10000000;
+        return  8;
+    }
+    if (n >= 1000000)
+    {
+        pow10 = 1000000;
+        return  7;
+    }
+    if (n >= 100000)
+    {
+        pow10 = 100000;
+        return  6;
+    }
+    if (n >= 10000)
+    {
+        pow10 = 10000;
+        return  5;
+    }
+    if (n >= 1000)
+    {
+        pow10 = 1000;
+        return  4;
     }
-
-    /*!
-    @brief normalize x such that the significand is >= 2^(q-1)
-    @pre x.f != 0
-    */
-    static diyfp normalize(diyfp x) noexcept
+    if (n >= 100)
     {
-        JSON_ASSERT(x.f != 0);
+        pow10 = 100;
+        return  3;
+    }
+    if (n >= 10)
+    {
+        pow10 = 10;
+        return  2;
+    }
 
-        while ((x.f >> 63u) == 0)
-        {
-            x.f <<= 1u;
-            x.e--;
-        }
+    pow10 = 1;
+    return 1;
+}
 
-        return x;
-    }
+inline void grisu2_round(char* buf, int len, std::uint64_t dist, std::uint64_t delta,
+                         std::uint64_t rest, std::uint64_t ten_k)
+{
+    JSON_ASSERT(len >= 1);
+    JSON_ASSERT(dist <= delta);
+    JSON_ASSERT(rest <= delta);
+    JSON_ASSERT(ten_k > 0);
 
-    /*!
-    @brief normalize x such that the result has the exponent E
-    @pre e >= x.e and the upper e - x.e bits of x.f must be zero.
-    */
-    static diyfp normalize_to(const diyfp& x, const int target_exponent) noexcept
-    {
-        const int delta = x.e - target_exponent;
+    //               <--------------------------- delta ---->
+    //                                  <---- dist --------->
+    // --------------[------------------+-------------------]--------------
+    //               M-                 w                   M+
+    //
+    //                                  ten_k
+    //                                <------>
+    //                                       <---- rest ---->
+    // --------------[------------------+----+--------------]--------------
+    //                                  w    V
+    //                                       = buf * 10^k
+    //
+    // ten_k represents a unit-in-the-last-place in the decimal representation
+    // stored in buf.
+    // Decrement buf by ten_k while this takes buf closer to w.
 
-        JSON_ASSERT(delta >= 0);
-        JSON_ASSERT(((x.f << delta) >> delta) == x.f);
+    // The tests are written in this order to avoid overflow in unsigned
+    // integer arithmetic.
 
-        return {x.f << delta, target_exponent};
+    while (rest < dist
+            && delta - rest >= ten_k
+            && (rest + ten_k < dist || dist - rest > rest + ten_k - dist))
+    {
+        JSON_ASSERT(buf[len - 1] != '0');
+        buf[len - 1]--;
+        rest += ten_k;
     }
-};
-
-struct boundaries
-{
-    diyfp w;
-    diyfp minus;
-    diyfp plus;
-};
+}
 
 /*!
-Compute the (normalized) diyfp representing the input number 'value' and its
-boundaries.
-
-@pre value must be finite and positive
+Generates V = buffer * 10^decimal_exponent, such that M- <= V <= M+.
+M- and M+ must be normalized and share the same exponent -60 <= e <= -32.
 */
-template<typename FloatType>
-boundaries compute_boundaries(FloatType value)
+inline void grisu2_digit_gen(char* buffer, int& length, int& decimal_exponent,
+                             diyfp M_minus, diyfp w, diyfp M_plus)
 {
-    JSON_ASSERT(std::isfinite(value));
-    JSON_ASSERT(value > 0);
+    static_assert(kAlpha >= -60, "internal error");
+    static_assert(kGamma <= -32, "internal error");
 
-    // Convert the IEEE representation into a diyfp.
+    // Generates the digits (and the exponent) of a decimal floating-point
+    // number V = buffer * 10^decimal_exponent in the range [M-, M+]. The diyfp's
+    // w, M- and M+ share the same exponent e, which satisfies alpha <= e <= gamma.
     //
-    // If v is denormal:
-    //      value = 0.F * 2^(1 - bias) = (          F) * 2^(1 - bias - (p-1))
-    // If v is normalized:
-    //      value = 1.F * 2^(E - bias) = (2^(p-1) + F) * 2^(E - bias - (p-1))
+    //               <--------------------------- delta ---->
+    //                                  <---- dist --------->
+    // --------------[------------------+-------------------]--------------
+    //               M-                 w                   M+
+    //
+    // Grisu2 generates the digits of M+ from left to right and stops as soon as
+    // V is in [M-,M+].
 
-    static_assert(std::numeric_limits<FloatType>::is_iec559,
-                  "internal error: dtoa_short requires an IEEE-754 floating-point implementation");
+    JSON_ASSERT(M_plus.e >= kAlpha);
+    JSON_ASSERT(M_plus.e <= kGamma);
 
-    constexpr int      kPrecision = std::numeric_limits<FloatType>::digits; // = p (includes the hidden bit)
-    constexpr int      kBias      = std::numeric_limits<FloatType>::max_exponent - 1 + (kPrecision - 1);
-    constexpr int      kMinExp    = 1 - kBias;
-    constexpr std::uint64_t kHiddenBit = std::uint64_t{1} << (kPrecision - 1); // = 2^(p-1)
+    std::uint64_t delta = diyfp::sub(M_plus, M_minus).f; // (significand of (M+ - M-), implicit exponent is e)
+    std::uint64_t dist  = diyfp::sub(M_plus, w      ).f; // (significand of (M+ - w ), implicit exponent is e)
 
-    using bits_type = typename std::conditional<kPrecision == 24, std::uint32_t, std::uint64_t >::type;
+    // Split M+ = f * 2^e into two parts p1 and p2 (note: e < 0):
+    //
+    //      M+ = f * 2^e
+    //         = ((f div 2^-e) * 2^-e + (f mod 2^-e)) * 2^e
+    //         = ((p1        ) * 2^-e + (p2        )) * 2^e
+    //         = p1 + p2 * 2^e
 
-    const auto bits = static_cast<std::uint64_t>(reinterpret_bits<bits_type>(value));
-    const std::uint64_t E = bits >> (kPrecision - 1);
-    const std::uint64_t F = bits & (kHiddenBit - 1);
+    const diyfp one(std::uint64_t{1} << -M_plus.e, M_plus.e);
 
-    const bool is_denormal = E == 0;
-    const diyfp v = is_denormal
-                    ? diyfp(F, kMinExp)
-                    : diyfp(F + kHiddenBit, static_cast<int>(E) - kBias);
+    auto p1 = static_cast<std::uint32_t>(M_plus.f >> -one.e); // p1 = f div 2^-e (Since -e >= 32, p1 fits into a 32-bit int.)
+    std::uint64_t p2 = M_plus.f & (one.f - 1);                    // p2 = f mod 2^-e
 
-    // Compute the boundaries m- and m+ of the floating-point value
-    // v = f * 2^e.
+    // 1)
     //
-    // Determine v- and v+, the floating-point predecessor and successor if v,
-    // respectively.
+    // Generate the digits of the integral part p1 = d[n-1]...d[1]d[0]
+
+    JSON_ASSERT(p1 > 0);
+
+    std::uint32_t pow10{};
+    const int k = find_largest_pow10(p1, pow10);
+
+    //      10^(k-1) <= p1 < 10^k, pow10 = 10^(k-1)
     //
-    //      v- = v - 2^e        if f != 2^(p-1) or e == e_min                (A)
-    //         = v - 2^(e-1)    if f == 2^(p-1) and e > e_min                (B)
+    //      p1 = (p1 div 10^(k-1)) * 10^(k-1) + (p1 mod 10^(k-1))
+    //         = (d[k-1]         ) * 10^(k-1) + (p1 mod 10^(k-1))
     //
-    //      v+ = v + 2^e
+    //      M+ = p1                                             + p2 * 2^e
+    //         = d[k-1] * 10^(k-1) + (p1 mod 10^(k-1))          + p2 * 2^e
+    //         = d[k-1] * 10^(k-1) + ((p1 mod 10^(k-1)) * 2^-e + p2) * 2^e
+    //         = d[k-1] * 10^(k-1) + (                         rest) * 2^e
     //
-    // Let m- = (v- + v) / 2 and m+ = (v + v+) / 2. All real numbers _strictly_
-    // between m- and m+ round to v, regardless of how the input rounding
-    // algorithm breaks ties.
+    // Now generate the digits d[n] of p1 from left to right (n = k-1,...,0)
     //
-    //      ---+-------------+-------------+-------------+-------------+---  (A)
-    //         v-            m-            v             m+            v+
+    //      p1 = d[k-1]...d[n] * 10^n + d[n-1]...d[0]
     //
-    //      -----------------+------+------+-------------+-------------+---  (B)
-    //                       v-     m-     v             m+            v+
-
-    const bool lower_boundary_is_closer = F == 0 && E > 1;
-    const diyfp m_plus = diyfp(2 * v.f + 1, v.e - 1);
-    const diyfp m_minus = lower_boundary_is_closer
-                          ? diyfp(4 * v.f - 1, v.e - 2)  // (B)
-                          : diyfp(2 * v.f - 1, v.e - 1); // (A)
-
-    // Determine the normalized w+ = m+.
-    const diyfp w_plus = diyfp::normalize(m_plus);
-
-    // Determine w- = m- such that e_(w-) = e_(w+).
-    const diyfp w_minus = diyfp::normalize_to(m_minus, w_plus.e);
-
-    return {diyfp::normalize(v), w_minus, w_plus};
-}
+    // but stop as soon as
+    //
+    //      rest * 2^e = (d[n-1]...d[0] * 2^-e + p2) * 2^e <= delta * 2^e
 
-// Given normalized diyfp w, Grisu needs to find a (normalized) cached
-// power-of-ten c, such that the exponent of the product c * w = f * 2^e lies
-// within a certain range [alpha, gamma] (Definition 3.2 from [1])
-//
-//      alpha <= e = e_c + e_w + q <= gamma
-//
-// or
-//
-//      f_c * f_w * 2^alpha <= f_c 2^(e_c) * f_w 2^(e_w) * 2^q
-//                          <= f_c * f_w * 2^gamma
-//
-// Since c and w are normalized, i.e. 2^(q-1) <= f < 2^q, this implies
-//
-//      2^(q-1) * 2^(q-1) * 2^alpha <= c * w * 2^q < 2^q * 2^q * 2^gamma
-//
-// or
-//
-//      2^(q - 2 + alpha) <= c * w < 2^(q + gamma)
-//
-// The choice of (alpha,gamma) determines the size of the table and the form of
-// the digit generation procedure. Using (alpha,gamma)=(-60,-32) works out well
-// in practice:
-//
-// The idea is to cut the number c * w = f * 2^e into two parts, which can be
-// processed independently: An integral part p1, and a fractional part p2:
-//
-//      f * 2^e = ( (f div 2^-e) * 2^-e + (f mod 2^-e) ) * 2^e
-//              = (f div 2^-e) + (f mod 2^-e) * 2^e
-//              = p1 + p2 * 2^e
-//
-// The conversion of p1 into decimal form requires a series of divisions and
-// modulos by (a power of) 10. These operations are faster for 32-bit than for
-// 64-bit integers, so p1 should ideally fit into a 32-bit integer. This can be
-// achieved by choosing
-//
-//      -e >= 32   or   e <= -32 := gamma
-//
-// In order to convert the fractional part
-//
-//      p2 * 2^e = p2 / 2^-e = d[-1] / 10^1 + d[-2] / 10^2 + ...
-//
-// into decimal form, the fraction is repeatedly multiplied by 10 and the digits
-// d[-i] are extracted in order:
-//
-//      (10 * p2) div 2^-e = d[-1]
-//      (10 * p2) mod 2^-e = d[-2] / 10^1 + ...
-//
-// The multiplication by 10 must not overflow. It is sufficient to choose
-//
-//      10 * p2 < 16 * p2 = 2^4 * p2 <= 2^64.
-//
-// Since p2 = f mod 2^-e < 2^-e,
-//
-//      -e <= 60   or   e >= -60 := alpha
+    int n = k;
+    while (n > 0)
+    {
+        // Invariants:
+        //      M+ = buffer * 10^n + (p1 + p2 * 2^e)    (buffer = 0 for n = k)
+        //      pow10 = 10^(n-1) <= p1 < 10^n
+        //
+        const std::uint32_t d = p1 / pow10;  // d = p1 div 10^(n-1)
+        const std::uint32_t r = p1 % pow10;  // r = p1 mod 10^(n-1)
+        //
+        //      M+ = buffer * 10^n + (d * 10^(n-1) + r) + p2 * 2^e
+        //         = (buffer * 10 + d) * 10^(n-1) + (r + p2 * 2^e)
+        //
+        JSON_ASSERT(d <= 9);
+        buffer[length++] = static_cast<char>('0' + d); // buffer := buffer * 10 + d
+        //
+        //      M+ = buffer * 10^(n-1) + (r + p2 * 2^e)
+        //
+        p1 = r;
+        n--;
+        //
+        //      M+ = buffer * 10^n + (p1 + p2 * 2^e)
+        //      pow10 = 10^n
+        //
 
-constexpr int kAlpha = -60;
-constexpr int kGamma = -32;
+        // Now check if enough digits have been generated.
+        // Compute
+        //
+        //      p1 + p2 * 2^e = (p1 * 2^-e + p2) * 2^e = rest * 2^e
+        //
+        // Note:
+        // Since rest and delta share the same exponent e, it suffices to
+        // compare the significands.
+        const std::uint64_t rest = (std::uint64_t{p1} << -one.e) + p2;
+        if (rest <= delta)
+        {
+            // V = buffer * 10^n, with M- <= V <= M+.
 
-struct cached_power // c = f * 2^e ~= 10^k
-{
-    std::uint64_t f;
-    int e;
-    int k;
-};
+            decimal_exponent += n;
 
-/*!
-For a normalized diyfp w = f * 2^e, this function returns a (normalized) cached
-power-of-ten c = f_c * 2^e_c, such that the exponent of the product w * c
-satisfies (Definition 3.2 from [1])
+            // We may now just stop. But instead look if the buffer could be
+            // decremented to bring V closer to w.
+            //
+            // pow10 = 10^n is now 1 ulp in the decimal representation V.
+            // The rounding procedure works with diyfp's with an implicit
+            // exponent of e.
+            //
+            //      10^n = (10^n * 2^-e) * 2^e = ulp * 2^e
+            //
+            const std::uint64_t ten_n = std::uint64_t{pow10} << -one.e;
+            grisu2_round(buffer, length, dist, delta, rest, ten_n);
 
-     alpha <= e_c + e + q <= gamma.
-*/
-inline cached_power get_cached_power_for_binary_exponent(int e)
-{
-    // Now
+            return;
+        }
+
+        pow10 /= 10;
+        //
+        //      pow10 = 10^(n-1) <= p1 < 10^n
+        // Invariants restored.
+    }
+
+    // 2)
     //
-    //      alpha <= e_c + e + q <= gamma                                    (1)
-    //      ==> f_c * 2^alpha <= c * 2^e * 2^q
+    // The digits of the integral part have been generated:
     //
-    // and since the c's are normalized, 2^(q-1) <= f_c,
+    //      M+ = d[k-1]...d[1]d[0] + p2 * 2^e
+    //         = buffer            + p2 * 2^e
     //
-    //      ==> 2^(q - 1 + alpha) <= c * 2^(e + q)
-    //      ==> 2^(alpha - e - 1) <= c
+    // Now generate the digits of the fractional part p2 * 2^e.
     //
-    // If c were an exact power of ten, i.e. c = 10^k, one may determine k as
+    // Note:
+    // No decimal point is generated: the exponent is adjusted instead.
     //
-    //      k = ceil( log_10( 2^(alpha - e - 1) ) )
-    //        = ceil( (alpha - e - 1) * log_10(2) )
+    // p2 actually represents the fraction
     //
-    // From the paper:
-    // "In theory the result of the procedure could be wrong since c is rounded,
-    //  and the computation itself is approximated [...]. In practice, however,
-    //  this simple function is sufficient."
+    //      p2 * 2^e
+    //          = p2 / 2^-e
+    //          = d[-1] / 10^1 + d[-2] / 10^2 + ...
     //
-    // For IEEE double precision floating-point numbers converted into
-    // normalized diyfp's w = f * 2^e, with q = 64,
+    // Now generate the digits d[-m] of p1 from left to right (m = 1,2,...)
     //
-    //      e >= -1022      (min IEEE exponent)
-    //           -52        (p - 1)
-    //           -52        (p - 1, possibly normalize denormal IEEE numbers)
-    //           -11        (normalize the diyfp)
-    //         = -1137
+    //      p2 * 2^e = d[-1]d[-2]...d[-m] * 10^-m
+    //                      + 10^-m * (d[-m-1] / 10^1 + d[-m-2] / 10^2 + ...)
     //
-    // and
+    // using
     //
-    //      e <= +1023      (max IEEE exponent)
-    //           -52        (p - 1)
-    //           -11        (normalize the diyfp)
-    //         = 960
+    //      10^m * p2 = ((10^m * p2) div 2^-e) * 2^-e + ((10^m * p2) mod 2^-e)
+    //                = (                   d) * 2^-e + (                   r)
     //
-    // This binary exponent range [-1137,960] results in a decimal exponent
-    // range [-307,324]. One does not need to store a cached power for each
-    // k in this range. For each such k it suffices to find a cached power
-    // such that the exponent of the product lies in [alpha,gamma].
-    // This implies that the difference of the decimal exponents of adjacent
-    // table entries must be less than or equal to
+    // or
+    //      10^m * p2 * 2^e = d + r * 2^e
     //
-    //      floor( (gamma - alpha) * log_10(2) ) = 8.
+    // i.e.
     //
-    // (A smaller distance gamma-alpha would require a larger table.)
-
-    // NB:
-    // Actually this function returns c, such that -60 <= e_c + e + 64 <= -34.
+    //      M+ = buffer + p2 * 2^e
+    //         = buffer + 10^-m * (d + r * 2^e)
+    //         = (buffer * 10^m + d) * 10^-m + 10^-m * r * 2^e
+    //
+    // and stop as soon as 10^-m * r * 2^e <= delta * 2^e
 
-    constexpr int kCachedPowersMinDecExp = -300;
-    constexpr int kCachedPowersDecStep = 8;
+    JSON_ASSERT(p2 > delta);
 
-    static constexpr std::array<cached_power, 79> kCachedPowers =
+    int m = 0;
+    for (;;)
     {
+        // Invariant:
+        //      M+ = buffer * 10^-m + 10^-m * (d[-m-1] / 10 + d[-m-2] / 10^2 + ...) * 2^e
+        //         = buffer * 10^-m + 10^-m * (p2                                 ) * 2^e
+        //         = buffer * 10^-m + 10^-m * (1/10 * (10 * p2)                   ) * 2^e
+        //         = buffer * 10^-m + 10^-m * (1/10 * ((10*p2 div 2^-e) * 2^-e + (10*p2 mod 2^-e)) * 2^e
+        //
+        JSON_ASSERT(p2 <= (std::numeric_limits<std::uint64_t>::max)() / 10);
+        p2 *= 10;
+        const std::uint64_t d = p2 >> -one.e;     // d = (10 * p2) div 2^-e
+        const std::uint64_t r = p2 & (one.f - 1); // r = (10 * p2) mod 2^-e
+        //
+        //      M+ = buffer * 10^-m + 10^-m * (1/10 * (d * 2^-e + r) * 2^e
+        //         = buffer * 10^-m + 10^-m * (1/10 * (d + r * 2^e))
+        //         = (buffer * 10 + d) * 10^(-m-1) + 10^(-m-1) * r * 2^e
+        //
+        JSON_ASSERT(d <= 9);
+        buffer[length++] = static_cast<char>('0' + d); // buffer := buffer * 10 + d
+        //
+        //      M+ = buffer * 10^(-m-1) + 10^(-m-1) * r * 2^e
+        //
+        p2 = r;
+        m++;
+        //
+        //      M+ = buffer * 10^-m + 10^-m * p2 * 2^e
+        // Invariant restored.
+
+        // Check if enough digits have been generated.
+        //
+        //      10^-m * p2 * 2^e <= delta * 2^e
+        //              p2 * 2^e <= 10^m * delta * 2^e
+        //                    p2 <= 10^m * delta
+        delta *= 10;
+        dist  *= 10;
+        if (p2 <= delta)
         {
-            { 0xAB70FE17C79AC6CA, -1060, -300 },
-            { 0xFF77B1FCBEBCDC4F, -1034, -292 },
-            { 0xBE5691EF416BD60C, -1007, -284 },
-            { 0x8DD01FAD907FFC3C,  -980, -276 },
-            { 0xD3515C2831559A83,  -954, -268 },
-            { 0x9D71AC8FADA6C9B5,  -927, -260 },
-            { 0xEA9C227723EE8BCB,  -901, -252 },
-            { 0xAECC49914078536D,  -874, -244 },
-            { 0x823C12795DB6CE57,  -847, -236 },
-            { 0xC21094364DFB5637,  -821, -228 },
-            { 0x9096EA6F3848984F,  -794, -220 },
-            { 0xD77485CB25823AC7,  -768, -212 },
-            { 0xA086CFCD97BF97F4,  -741, -204 },
-            { 0xEF340A98172AACE5,  -715, -196 },
-            { 0xB23867FB2A35B28E,  -688, -188 },
-            { 0x84C8D4DFD2C63F3B,  -661, -180 },
-            { 0xC5DD44271AD3CDBA,  -635, -172 },
-            { 0x936B9FCEBB25C996,  -608, -164 },
-            { 0xDBAC6C247D62A584,  -582, -156 },
-            { 0xA3AB66580D5FDAF6,  -555, -148 },
-            { 0xF3E2F893DEC3F126,  -529, -140 },
-            { 0xB5B5ADA8AAFF80B8,  -502, -132 },
-            { 0x87625F056C7C4A8B,  -475, -124 },
-            { 0xC9BCFF6034C13053,  -449, -116 },
-            { 0x964E858C91BA2655,  -422, -108 },
-            { 0xDFF9772470297EBD,  -396, -100 },
-            { 0xA6DFBD9FB8E5B88F,  -369,  -92 },
-            { 0xF8A95FCF88747D94,  -343,  -84 },
-            { 0xB94470938FA89BCF,  -316,  -76 },
-            { 0x8A08F0F8BF0F156B,  -289,  -68 },
-            { 0xCDB02555653131B6,  -263,  -60 },
-            { 0x993FE2C6D07B7FAC,  -236,  -52 },
-            { 0xE45C10C42A2B3B06,  -210,  -44 },
-            { 0xAA242499697392D3,  -183,  -36 },
-            { 0xFD87B5F28300CA0E,  -157,  -28 },
-            { 0xBCE5086492111AEB,  -130,  -20 },
-            { 0x8CBCCC096F5088CC,  -103,  -12 },
-            { 0xD1B71758E219652C,   -77,   -4 },
-            { 0x9C40000000000000,   -50,    4 },
-            { 0xE8D4A51000000000,   -24,   12 },
-            { 0xAD78EBC5AC620000,     3,   20 },
-            { 0x813F3978F8940984,    30,   28 },
-            { 0xC097CE7BC90715B3,    56,   36 },
-            { 0x8F7E32CE7BEA5C70,    83,   44 },
-            { 0xD5D238A4ABE98068,   109,   52 },
-            { 0x9F4F2726179A2245,   136,   60 },
-            { 0xED63A231D4C4FB27,   162,   68 },
-            { 0xB0DE65388CC8ADA8,   189,   76 },
-            { 0x83C7088E1AAB65DB,   216,   84 },
-            { 0xC45D1DF942711D9A,   242,   92 },
-            { 0x924D692CA61BE758,   269,  100 },
-            { 0xDA01EE641A708DEA,   295,  108 },
-            { 0xA26DA3999AEF774A,   322,  116 },
-            { 0xF209787BB47D6B85,   348,  124 },
-            { 0xB454E4A179DD1877,   375,  132 },
-            { 0x865B86925B9BC5C2,   402,  140 },
-            { 0xC83553C5C8965D3D,   428,  148 },
-            { 0x952AB45CFA97A0B3,   455,  156 },
-            { 0xDE469FBD99A05FE3,   481,  164 },
-            { 0xA59BC234DB398C25,   508,  172 },
-            { 0xF6C69A72A3989F5C,   534,  180 },
-            { 0xB7DCBF5354E9BECE,   561,  188 },
-            { 0x88FCF317F22241E2,   588,  196 },
-            { 0xCC20CE9BD35C78A5,   614,  204 },
-            { 0x98165AF37B2153DF,   641,  212 },
-            { 0xE2A0B5DC971F303A,   667,  220 },
-            { 0xA8D9D1535CE3B396,   694,  228 },
-            { 0xFB9B7CD9A4A7443C,   720,  236 },
-            { 0xBB764C4CA7A44410,   747,  244 },
-            { 0x8BAB8EEFB6409C1A,   774,  252 },
-            { 0xD01FEF10A657842C,   800,  260 },
-            { 0x9B10A4E5E9913129,   827,  268 },
-            { 0xE7109BFBA19C0C9D,   853,  276 },
-            { 0xAC2820D9623BF429,   880,  284 },
-            { 0x80444B5E7AA7CF85,   907,  292 },
-            { 0xBF21E44003ACDD2D,   933,  300 },
-            { 0x8E679C2F5E44FF8F,   960,  308 },
-            { 0xD433179D9C8CB841,   986,  316 },
-            { 0x9E19DB92B4E31BA9,  1013,  324 },
+            break;
         }
-    };
+    }
+
+    // V = buffer * 10^-m, with M- <= V <= M+.
+
+    decimal_exponent -= m;
+
+    // 1 ulp in the decimal representation is now 10^-m.
+    // Since delta and dist are now scaled by 10^m, we need to do the
+    // same with ulp in order to keep the units in sync.
+    //
+    //      10^m * 10^-m = 1 = 2^-e * 2^e = ten_m * 2^e
+    //
+    const std::uint64_t ten_m = one.f;
+    grisu2_round(buffer, length, dist, delta, p2, ten_m);
+
+    // By construction this algorithm generates the shortest possible decimal
+    // number (Loitsch, Theorem 6.2) which rounds back to w.
+    // For an input number of precision p, at least
+    //
+    //      N = 1 + ceil(p * log_10(2))
+    //
+    // decimal digits are sufficient to identify all binary floating-point
+    // numbers (Matula, "In-and-Out conversions").
+    // This implies that the algorithm does not produce more than N decimal
+    // digits.
+    //
+    //      N = 17 for p = 53 (IEEE double precision)
+    //      N = 9  for p = 24 (IEEE single precision)
+}
 
-    // This computation gives exactly the same results for k as
-    //      k = ceil((kAlpha - e - 1) * 0.30102999566398114)
-    // for |e| <= 1500, but doesn't require floating-point operations.
-    // NB: log_10(2) ~= 78913 / 2^18
-    JSON_ASSERT(e >= -1500);
-    JSON_ASSERT(e <=  1500);
-    const int f = kAlpha - e - 1;
-    const int k = (f * 78913) / (1 << 18) + static_cast<int>(f > 0);
+/*!
+v = buf * 10^decimal_exponent
+len is the length of the buffer (number of decimal digits)
+The buffer must be large enough, i.e. >= max_digits10.
+*/
+JSON_HEDLEY_NON_NULL(1)
+inline void grisu2(char* buf, int& len, int& decimal_exponent,
+                   diyfp m_minus, diyfp v, diyfp m_plus)
+{
+    JSON_ASSERT(m_plus.e == m_minus.e);
+    JSON_ASSERT(m_plus.e == v.e);
 
-    const int index = (-kCachedPowersMinDecExp + k + (kCachedPowersDecStep - 1)) / kCachedPowersDecStep;
-    JSON_ASSERT(index >= 0);
-    JSON_ASSERT(static_cast<std::size_t>(index) < kCachedPowers.size());
+    //  --------(-----------------------+-----------------------)--------    (A)
+    //          m-                      v                       m+
+    //
+    //  --------------------(-----------+-----------------------)--------    (B)
+    //                      m-          v                       m+
+    //
+    // First scale v (and m- and m+) such that the exponent is in the range
+    // [alpha, gamma].
 
-    const cached_power cached = kCachedPowers[static_cast<std::size_t>(index)];
-    JSON_ASSERT(kAlpha <= cached.e + e + 64);
-    JSON_ASSERT(kGamma >= cached.e + e + 64);
+    const cached_power cached = get_cached_power_for_binary_exponent(m_plus.e);
 
-    return cached;
+    const diyfp c_minus_k(cached.f, cached.e); // = c ~= 10^-k
+
+    // The exponent of the products is = v.e + c_minus_k.e + q and is in the range [alpha,gamma]
+    const diyfp w       = diyfp::mul(v,       c_minus_k);
+    const diyfp w_minus = diyfp::mul(m_minus, c_minus_k);
+    const diyfp w_plus  = diyfp::mul(m_plus,  c_minus_k);
+
+    //  ----(---+---)---------------(---+---)---------------(---+---)----
+    //          w-                      w                       w+
+    //          = c*m-                  = c*v                   = c*m+
+    //
+    // diyfp::mul rounds its result and c_minus_k is approximated too. w, w- and
+    // w+ are now off by a small amount.
+    // In fact:
+    //
+    //      w - v * 10^k < 1 ulp
+    //
+    // To account for this inaccuracy, add resp. subtract 1 ulp.
+    //
+    //  --------+---[---------------(---+---)---------------]---+--------
+    //          w-  M-                  w                   M+  w+
+    //
+    // Now any number in [M-, M+] (bounds included) will round to w when input,
+    // regardless of how the input rounding algorithm breaks ties.
+    //
+    // And digit_gen generates the shortest possible such number in [M-, M+].
+    // Note that this does not mean that Grisu2 always generates the shortest
+    // possible number in the interval (m-, m+).
+    const diyfp M_minus(w_minus.f + 1, w_minus.e);
+    const diyfp M_plus (w_plus.f  - 1, w_plus.e );
+
+    decimal_exponent = -cached.k; // = -(-k) = k
+
+    grisu2_digit_gen(buf, len, decimal_exponent, M_minus, w, M_plus);
 }
 
 /*!
-For n != 0, returns k, such that pow10 := 10^(k-1) <= n < 10^k.
-For n == 0, returns 1 and sets pow10 := 1.
+v = buf * 10^decimal_exponent
+len is the length of the buffer (number of decimal digits)
+The buffer must be large enough, i.e. >= max_digits10.
 */
-inline int find_largest_pow10(const std::uint32_t n, std::uint32_t& pow10)
+template<typename FloatType>
+JSON_HEDLEY_NON_NULL(1)
+void grisu2(char* buf, int& len, int& decimal_exponent, FloatType value)
 {
-    // LCOV_EXCL_START
-    if (n >= 1000000000)
-    {
-        pow10 = 1000000000;
-        return 10;
-    }
-    // LCOV_EXCL_STOP
-    if (n >= 100000000)
-    {
-        pow10 = 100000000;
-        return  9;
-    }
-    if (n >= 10000000)
+    static_assert(diyfp::kPrecision >= std::numeric_limits<FloatType>::digits + 3,
+                  "internal error: not enough precision");
+
+    JSON_ASSERT(std::isfinite(value));
+    JSON_ASSERT(value > 0);
+
+    // If the neighbors (and boundaries) of 'value' are always computed for double-precision
+    // numbers, all float's can be recovered using strtod (and strtof). However, the resulting
+    // decimal representations are not exactly "short".
+    //
+    // The documentation for 'std::to_chars' (https://en.cppreference.com/w/cpp/utility/to_chars)
+    // says "value is converted to a string as if by std::sprintf in the default ("C") locale"
+    // and since sprintf promotes floats to doubles, I think this is exactly what 'std::to_chars'
+    // does.
+    // On the other hand, the documentation for 'std::to_chars' requires that "parsing the
+    // representation using the corresponding std::from_chars function recovers value exactly". That
+    // indicates that single precision floating-point numbers should be recovered using
+    // 'std::strtof'.
+    //
+    // NB: If the neighbors are computed for single-precision numbers, there is a single float
+    //     (7.0385307e-26f) which can't be recovered using strtod. The resulting double precision
+    //     value is off by 1 ulp.
+#if 0 // NOLINT(readability-avoid-unconditional-preprocessor-if)
+    const boundaries w = compute_boundaries(static_cast<double>(value));
+#else
+    const boundaries w = compute_boundaries(value);
+#endif
+
+    grisu2(buf, len, decimal_exponent, w.minus, w.w, w.plus);
+}
+
+/*!
+@brief appends a decimal representation of e to buf
+@return a pointer to the element following the exponent.
+@pre -1000 < e < 1000
+*/
+JSON_HEDLEY_NON_NULL(1)
+JSON_HEDLEY_RETURNS_NON_NULL
+inline char* append_exponent(char* buf, int e)
+{
+    JSON_ASSERT(e > -1000);
+    JSON_ASSERT(e <  1000);
+
+    if (e < 0)
     {
-        pow10 = 10000000;
-        return  8;
+        e = -e;
+        *buf++ = '-';
     }
-    if (n >= 1000000)
+    else
     {
-        pow10 = 1000000;
-        return  7;
+        *buf++ = '+';
     }
-    if (n >= 100000)
+
+    auto k = static_cast<std::uint32_t>(e);
+    if (k < 10)
     {
-        pow10 = 100000;
-        return  6;
+        // Always print at least two digits in the exponent.
+        // This is for compatibility with printf("%g").
+        *buf++ = '0';
+        *buf++ = static_cast<char>('0' + k);
     }
-    if (n >= 10000)
+    else if (k < 100)
     {
-        pow10 = 10000;
-        return  5;
+        *buf++ = static_cast<char>('0' + k / 10);
+        k %= 10;
+        *buf++ = static_cast<char>('0' + k);
     }
-    if (n >= 1000)
+    else
     {
-        pow10 = 1000;
-        return  4;
+        *buf++ = static_cast<char>('0' + k / 100);
+        k %= 100;
+        *buf++ = static_cast<char>('0' + k / 10);
+        k %= 10;
+        *buf++ = static_cast<char>('0' + k);
     }
-    if (n >= 100)
+
+    return buf;
+}
+
+/*!
+@brief prettify v = buf * 10^decimal_exponent
+
+If v is in the range [10^min_exp, 10^max_exp) it will be printed in fixed-point
+notation. Otherwise it will be printed in exponential notation.
+
+@pre min_exp < 0
+@pre max_exp > 0
+*/
+JSON_HEDLEY_NON_NULL(1)
+JSON_HEDLEY_RETURNS_NON_NULL
+inline char* format_buffer(char* buf, int len, int decimal_exponent,
+                           int min_exp, int max_exp)
+{
+    JSON_ASSERT(min_exp < 0);
+    JSON_ASSERT(max_exp > 0);
+
+    const int k = len;
+    const int n = len + decimal_exponent;
+
+    // v = buf * 10^(n-k)
+    // k is the length of the buffer (number of decimal digits)
+    // n is the position of the decimal point relative to the start of the buffer.
+
+    if (k <= n && n <= max_exp)
     {
-        pow10 = 100;
-        return  3;
+        // digits[000]
+        // len <= max_exp + 2
+
+        std::memset(buf + k, '0', static_cast<size_t>(n) - static_cast<size_t>(k));
+        // Make it look like a floating-point number (#362, #378)
+        buf[n + 0] = '.';
+        buf[n + 1] = '0';
+        return buf + (static_cast<size_t>(n) + 2);
     }
-    if (n >= 10)
+
+    if (0 < n && n <= max_exp)
     {
-        pow10 = 10;
-        return  2;
-    }
+        // dig.its
+        // len <= max_digits10 + 1
 
-    pow10 = 1;
-    return 1;
-}
+        JSON_ASSERT(k > n);
 
-inline void grisu2_round(char* buf, int len, std::uint64_t dist, std::uint64_t delta,
-                         std::uint64_t rest, std::uint64_t ten_k)
-{
-    JSON_ASSERT(len >= 1);
-    JSON_ASSERT(dist <= delta);
-    JSON_ASSERT(rest <= delta);
-    JSON_ASSERT(ten_k > 0);
+        std::memmove(buf + (static_cast<size_t>(n) + 1), buf + n, static_cast<size_t>(k) - static_cast<size_t>(n));
+        buf[n] = '.';
+        return buf + (static_cast<size_t>(k) + 1U);
+    }
 
-    //               <--------------------------- delta ---->
-    //                                  <---- dist --------->
-    // --------------[------------------+-------------------]--------------
-    //               M-                 w                   M+
-    //
-    //                                  ten_k
-    //                                <------>
-    //                                       <---- rest ---->
-    // --------------[------------------+----+--------------]--------------
-    //                                  w    V
-    //                                       = buf * 10^k
-    //
-    // ten_k represents a unit-in-the-last-place in the decimal representation
-    // stored in buf.
-    // Decrement buf by ten_k while this takes buf closer to w.
+    if (min_exp < n && n <= 0)
+    {
+        // 0.[000]digits
+        // len <= 2 + (-min_exp - 1) + max_digits10
 
-    // The tests are written in this order to avoid overflow in unsigned
-    // integer arithmetic.
+        std::memmove(buf + (2 + static_cast<size_t>(-n)), buf, static_cast<size_t>(k));
+        buf[0] = '0';
+        buf[1] = '.';
+        std::memset(buf + 2, '0', static_cast<size_t>(-n));
+        return buf + (2U + static_cast<size_t>(-n) + static_cast<size_t>(k));
+    }
 
-    while (rest < dist
-            && delta - rest >= ten_k
-            && (rest + ten_k < dist || dist - rest > rest + ten_k - dist))
+    if (k == 1)
     {
-        JSON_ASSERT(buf[len - 1] != '0');
-        buf[len - 1]--;
-        rest += ten_k;
+        // dE+123
+        // len <= 1 + 5
+
+        buf += 1;
+    }
+    else
+    {
+        // d.igitsE+123
+        // len <= max_digits10 + 1 + 5
+
+        std::memmove(buf + 2, buf + 1, static_cast<size_t>(k) - 1);
+        buf[1] = '.';
+        buf += 1 + static_cast<size_t>(k);
     }
+
+    *buf++ = 'e';
+    return append_exponent(buf, n - 1);
 }
 
+}  // namespace dtoa_impl
+
 /*!
-Generates V = buffer * 10^decimal_exponent, such that M- <= V <= M+.
-M- and M+ must be normalized and share the same exponent -60 <= e <= -32.
+@brief generates a decimal representation of the floating-point number value in [first, last).
+
+The format of the resulting decimal representation is similar to printf's %g
+format. Returns an iterator pointing past-the-end of the decimal representation.
+
+@note The input number must be finite, i.e. NaN's and Inf's are not supported.
+@note The buffer must be large enough.
+@note The result is NOT null-terminated.
+
+@tparam LayoutType  type whose digits10 decides between fixed and exponential
+                    notation (a float printed like a double: 1e7f -> 10000000.0)
 */
-inline void grisu2_digit_gen(char* buffer, int& length, int& decimal_exponent,
-                             diyfp M_minus, diyfp w, diyfp M_plus)
+template<typename FloatType, typename LayoutType = FloatType>
+JSON_HEDLEY_NON_NULL(1, 2)
+JSON_HEDLEY_RETURNS_NON_NULL
+char* to_chars(char* first, const char* last, FloatType value)
 {
-    static_assert(kAlpha >= -60, "internal error");
-    static_assert(kGamma <= -32, "internal error");
+    static_cast<void>(last); // maybe unused - fix warning
+    JSON_ASSERT(std::isfinite(value));
 
-    // Generates the digits (and the exponent) of a decimal floating-point
-    // number V = buffer * 10^decimal_exponent in the range [M-, M+]. The diyfp's
-    // w, M- and M+ share the same exponent e, which satisfies alpha <= e <= gamma.
-    //
-    //               <--------------------------- delta ---->
-    //                                  <---- dist --------->
-    // --------------[------------------+-------------------]--------------
-    //               M-                 w                   M+
-    //
-    // Grisu2 generates the digits of M+ from left to right and stops as soon as
-    // V is in [M-,M+].
+    // Use signbit(value) instead of (value < 0) since signbit works for -0.
+    if (std::signbit(value))
+    {
+        value = -value;
+        *first++ = '-';
+    }
 
-    JSON_ASSERT(M_plus.e >= kAlpha);
-    JSON_ASSERT(M_plus.e <= kGamma);
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+#endif
+    if (value == 0) // +-0
+    {
+        *first++ = '0';
+        // Make it look like a floating-point number (#362, #378)
+        *first++ = '.';
+        *first++ = '0';
+        return first;
+    }
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif
 
-    std::uint64_t delta = diyfp::sub(M_plus, M_minus).f; // (significand of (M+ - M-), implicit exponent is e)
-    std::uint64_t dist  = diyfp::sub(M_plus, w      ).f; // (significand of (M+ - w ), implicit exponent is e)
+    JSON_ASSERT(last - first >= std::numeric_limits<FloatType>::max_digits10);
 
-    // Split M+ = f * 2^e into two parts p1 and p2 (note: e < 0):
-    //
-    //      M+ = f * 2^e
-    //         = ((f div 2^-e) * 2^-e + (f mod 2^-e)) * 2^e
-    //         = ((p1        ) * 2^-e + (p2        )) * 2^e
-    //         = p1 + p2 * 2^e
+    // Compute v = buffer * 10^decimal_exponent.
+    // The decimal digits are stored in the buffer, which needs to be interpreted
+    // as an unsigned decimal integer.
+    // len is the length of the buffer, i.e. the number of decimal digits.
+    int len = 0;
+    int decimal_exponent = 0;
+    dtoa_impl::grisu2(first, len, decimal_exponent, value);
 
-    const diyfp one(std::uint64_t{1} << -M_plus.e, M_plus.e);
+    JSON_ASSERT(len <= std::numeric_limits<FloatType>::max_digits10);
 
-    auto p1 = static_cast<std::uint32_t>(M_plus.f >> -one.e); // p1 = f div 2^-e (Since -e >= 32, p1 fits into a 32-bit int.)
-    std::uint64_t p2 = M_plus.f & (one.f - 1);                    // p2 = f mod 2^-e
+    // Format the buffer like printf("%.*g", prec, value)
+    constexpr int kMinExp = -4;
+    // Use digits10 here to increase compatibility with version 2.
+    constexpr int kMaxExp = std::numeric_limits<LayoutType>::digits10;
 
-    // 1)
-    //
-    // Generate the digits of the integral part p1 = d[n-1]...d[1]d[0]
+    JSON_ASSERT(last - first >= kMaxExp + 2);
+    JSON_ASSERT(last - first >= 2 + (-kMinExp - 1) + std::numeric_limits<FloatType>::max_digits10);
+    JSON_ASSERT(last - first >= std::numeric_limits<FloatType>::max_digits10 + 6);
 
-    JSON_ASSERT(p1 > 0);
+    return dtoa_impl::format_buffer(first, len, decimal_exponent, kMinExp, kMaxExp);
+}
 
-    std::uint32_t pow10{};
-    const int k = find_largest_pow10(p1, pow10);
+}  // namespace detail
+NLOHMANN_JSON_NAMESPACE_END
 
-    //      10^(k-1) <= p1 < 10^k, pow10 = 10^(k-1)
-    //
-    //      p1 = (p1 div 10^(k-1)) * 10^(k-1) + (p1 mod 10^(k-1))
-    //         = (d[k-1]         ) * 10^(k-1) + (p1 mod 10^(k-1))
-    //
-    //      M+ = p1                                             + p2 * 2^e
-    //         = d[k-1] * 10^(k-1) + (p1 mod 10^(k-1))          + p2 * 2^e
-    //         = d[k-1] * 10^(k-1) + ((p1 mod 10^(k-1)) * 2^-e + p2) * 2^e
-    //         = d[k-1] * 10^(k-1) + (                         rest) * 2^e
-    //
-    // Now generate the digits d[n] of p1 from left to right (n = k-1,...,0)
-    //
-    //      p1 = d[k-1]...d[n] * 10^n + d[n-1]...d[0]
-    //
-    // but stop as soon as
-    //
-    //      rest * 2^e = (d[n-1]...d[0] * 2^-e + p2) * 2^e <= delta * 2^e
+// #include <nlohmann/detail/exceptions.hpp>
 
-    int n = k;
-    while (n > 0)
-    {
-        // Invariants:
-        //      M+ = buffer * 10^n + (p1 + p2 * 2^e)    (buffer = 0 for n = k)
-        //      pow10 = 10^(n-1) <= p1 < 10^n
-        //
-        const std::uint32_t d = p1 / pow10;  // d = p1 div 10^(n-1)
-        const std::uint32_t r = p1 % pow10;  // r = p1 mod 10^(n-1)
-        //
-        //      M+ = buffer * 10^n + (d * 10^(n-1) + r) + p2 * 2^e
-        //         = (buffer * 10 + d) * 10^(n-1) + (r + p2 * 2^e)
-        //
-        JSON_ASSERT(d <= 9);
-        buffer[length++] = static_cast<char>('0' + d); // buffer := buffer * 10 + d
-        //
-        //      M+ = buffer * 10^(n-1) + (r + p2 * 2^e)
-        //
-        p1 = r;
-        n--;
-        //
-        //      M+ = buffer * 10^n + (p1 + p2 * 2^e)
-        //      pow10 = 10^n
-        //
+// #include <nlohmann/detail/macro_scope.hpp>
 
-        // Now check if enough digits have been generated.
-        // Compute
-        //
-        //      p1 + p2 * 2^e = (p1 * 2^-e + p2) * 2^e = rest * 2^e
-        //
-        // Note:
-        // Since rest and delta share the same exponent e, it suffices to
-        // compare the significands.
-        const std::uint64_t rest = (std::uint64_t{p1} << -one.e) + p2;
-        if (rest <= delta)
-        {
-            // V = buffer * 10^n, with M- <= V <= M+.
+// #include <nlohmann/detail/meta/cpp_future.hpp>
 
-            decimal_exponent += n;
+// #include <nlohmann/detail/output/binary_writer.hpp>
 
-            // We may now just stop. But instead look if the buffer could be
-            // decremented to bring V closer to w.
-            //
-            // pow10 = 10^n is now 1 ulp in the decimal representation V.
-            // The rounding procedure works with diyfp's with an implicit
-            // exponent of e.
-            //
-            //      10^n = (10^n * 2^-e) * 2^e = ulp * 2^e
-            //
-            const std::uint64_t ten_n = std::uint64_t{pow10} << -one.e;
-            grisu2_round(buffer, length, dist, delta, rest, ten_n);
+// #include <nlohmann/detail/output/output_adapters.hpp>
 
-            return;
-        }
+// #include <nlohmann/detail/string_concat.hpp>
 
-        pow10 /= 10;
-        //
-        //      pow10 = 10^(n-1) <= p1 < 10^n
-        // Invariants restored.
-    }
+// #include <nlohmann/detail/value_t.hpp>
 
-    // 2)
-    //
-    // The digits of the integral part have been generated:
-    //
-    //      M+ = d[k-1]...d[1]d[0] + p2 * 2^e
-    //         = buffer            + p2 * 2^e
-    //
-    // Now generate the digits of the fractional part p2 * 2^e.
-    //
-    // Note:
-    // No decimal point is generated: the exponent is adjusted instead.
-    //
-    // p2 actually represents the fraction
-    //
-    //      p2 * 2^e
-    //          = p2 / 2^-e
-    //          = d[-1] / 10^1 + d[-2] / 10^2 + ...
-    //
-    // Now generate the digits d[-m] of p1 from left to right (m = 1,2,...)
-    //
-    //      p2 * 2^e = d[-1]d[-2]...d[-m] * 10^-m
-    //                      + 10^-m * (d[-m-1] / 10^1 + d[-m-2] / 10^2 + ...)
-    //
-    // using
-    //
-    //      10^m * p2 = ((10^m * p2) div 2^-e) * 2^-e + ((10^m * p2) mod 2^-e)
-    //                = (                   d) * 2^-e + (                   r)
-    //
-    // or
-    //      10^m * p2 * 2^e = d + r * 2^e
-    //
-    // i.e.
-    //
-    //      M+ = buffer + p2 * 2^e
-    //         = buffer + 10^-m * (d + r * 2^e)
-    //         = (buffer * 10^m + d) * 10^-m + 10^-m * r * 2^e
-    //
-    // and stop as soon as 10^-m * r * 2^e <= delta * 2^e
 
-    JSON_ASSERT(p2 > delta);
+NLOHMANN_JSON_NAMESPACE_BEGIN
+namespace detail
+{
+
+///////////////////
+// serialization //
+///////////////////
+
+/// how to treat decoding errors
+enum class error_handler_t
+{
+    strict,  ///< throw a type_error exception in case of invalid UTF-8
+    replace, ///< replace invalid UTF-8 sequences with U+FFFD
+    ignore   ///< ignore invalid UTF-8 sequences
+};
+
+template<typename BasicJsonType>
+class serializer
+{
+    using string_t = typename BasicJsonType::string_t;
+    using number_float_t = typename BasicJsonType::number_float_t;
+    using number_integer_t = typename BasicJsonType::number_integer_t;
+    using number_unsigned_t = typename BasicJsonType::number_unsigned_t;
+    using binary_char_t = typename BasicJsonType::binary_t::value_type;
+    static constexpr std::uint8_t UTF8_ACCEPT = 0;
+    static constexpr std::uint8_t UTF8_REJECT = 1;
 
-    int m = 0;
-    for (;;)
-    {
-        // Invariant:
-        //      M+ = buffer * 10^-m + 10^-m * (d[-m-1] / 10 + d[-m-2] / 10^2 + ...) * 2^e
-        //         = buffer * 10^-m + 10^-m * (p2                                 ) * 2^e
-        //         = buffer * 10^-m + 10^-m * (1/10 * (10 * p2)                   ) * 2^e
-        //         = buffer * 10^-m + 10^-m * (1/10 * ((10*p2 div 2^-e) * 2^-e + (10*p2 mod 2^-e)) * 2^e
-        //
-        JSON_ASSERT(p2 <= (std::numeric_limits<std::uint64_t>::max)() / 10);
-        p2 *= 10;
-        const std::uint64_t d = p2 >> -one.e;     // d = (10 * p2) div 2^-e
-        const std::uint64_t r = p2 & (one.f - 1); // r = (10 * p2) mod 2^-e
-        //
-        //      M+ = buffer * 10^-m + 10^-m * (1/10 * (d * 2^-e + r) * 2^e
-        //         = buffer * 10^-m + 10^-m * (1/10 * (d + r * 2^e))
-        //         = (buffer * 10 + d) * 10^(-m-1) + 10^(-m-1) * r * 2^e
-        //
-        JSON_ASSERT(d <= 9);
-        buffer[length++] = static_cast<char>('0' + d); // buffer := buffer * 10 + d
-        //
-        //      M+ = buffer * 10^(-m-1) + 10^(-m-1) * r * 2^e
-        //
-        p2 = r;
-        m++;
-        //
-        //      M+ = buffer * 10^-m + 10^-m * p2 * 2^e
-        // Invariant restored.
+  public:
+    /*!
+    @param[in] s  output stream to serialize to
+    @param[in] ichar  indentation character to use
+    @param[in] error_handler_  how to react on decoding errors
+    */
+    serializer(output_adapter_t<char> s, const char ichar,
+               error_handler_t error_handler_ = error_handler_t::strict)
+        : o(std::move(s))
+        , loc(std::localeconv())
+        , thousands_sep(loc->thousands_sep == nullptr ? '\0' : std::char_traits<char>::to_char_type(* (loc->thousands_sep)))
+        , decimal_point(loc->decimal_point == nullptr ? '\0' : std::char_traits<char>::to_char_type(* (loc->decimal_point)))
+        , indent_char(ichar)
+        , indent_string(512, indent_char)
+        , error_handler(error_handler_)
+    {}
 
-        // Check if enough digits have been generated.
-        //
-        //      10^-m * p2 * 2^e <= delta * 2^e
-        //              p2 * 2^e <= 10^m * delta * 2^e
-        //                    p2 <= 10^m * delta
-        delta *= 10;
-        dist  *= 10;
-        if (p2 <= delta)
-        {
-            break;
-        }
-    }
+    // delete because of pointer members
+    serializer(const serializer&) = delete;
+    serializer& operator=(const serializer&) = delete;
+    serializer(serializer&&) = delete;
+    serializer& operator=(serializer&&) = delete;
+    ~serializer() = default;
 
-    // V = buffer * 10^-m, with M- <= V <= M+.
+    /*!
+    @brief print floats exact in single precision with the shortest digits for float
 
-    decimal_exponent -= m;
+    With this, a double which holds a float value (e.g. a float32 from CBOR,
+    0.1f = 0.100000001490116...) is printed as "0.1". The text reads back to
+    the same float, but not to the same double, so it is meant for data which
+    is single precision anyway.
+    */
+    void set_float32_output(const bool enable) noexcept
+    {
+        float32_output = enable;
+    }
 
-    // 1 ulp in the decimal representation is now 10^-m.
-    // Since delta and dist are now scaled by 10^m, we need to do the
-    // same with ulp in order to keep the units in sync.
-    //
-    //      10^m * 10^-m = 1 = 2^-e * 2^e = ten_m * 2^e
-    //
-    const std::uint64_t ten_m = one.f;
-    grisu2_round(buffer, length, dist, delta, p2, ten_m);
+    /*!
+    @brief internal implementation of the serialization function
 
-    // By construction this algorithm generates the shortest possible decimal
-    // number (Loitsch, Theorem 6.2) which rounds back to w.
-    // For an input number of precision p, at least
-    //
-    //      N = 1 + ceil(p * log_10(2))
-    //
-    // decimal digits are sufficient to identify all binary floating-point
-    // numbers (Matula, "In-and-Out conversions").
-    // This implies that the algorithm does not produce more than N decimal
-    // digits.
-    //
-    //      N = 17 for p = 53 (IEEE double precision)
-    //      N = 9  for p = 24 (IEEE single precision)
-}
+    This function is called by the public member function dump and organizes
+    the serialization internally. The indentation level is propagated as
+    additional parameter. In case of arrays and objects, the function is
+    called recursively.
 
-/*!
-v = buf * 10^decimal_exponent
-len is the length of the buffer (number of decimal digits)
-The buffer must be large enough, i.e. >= max_digits10.
-*/
-JSON_HEDLEY_NON_NULL(1)
-inline void grisu2(char* buf, int& len, int& decimal_exponent,
-                   diyfp m_minus, diyfp v, diyfp m_plus)
-{
-    JSON_ASSERT(m_plus.e == m_minus.e);
-    JSON_ASSERT(m_plus.e == v.e);
+    - strings and object keys are escaped using `escape_string()`
+    - integer numbers are converted implicitly via `operator<<`
+    - floating-point numbers are converted to a string using `"%g"` format
+    - binary values are serialized as objects containing the subtype and the
+      byte array
 
-    //  --------(-----------------------+-----------------------)--------    (A)
-    //          m-                      v                       m+
-    //
-    //  --------------------(-----------+-----------------------)--------    (B)
-    //                      m-          v                       m+
-    //
-    // First scale v (and m- and m+) such that the exponent is in the range
-    // [alpha, gamma].
+    @param[in] val               value to serialize
+    @param[in] pretty_print      whether the output shall be pretty-printed
+    @param[in] ensure_ascii If @a ensure_ascii is true, all non-ASCII characters
+    in the output are escaped with `\uXXXX` sequences, and the result consists
+    of ASCII characters only.
+    @param[in] indent_step       the indent level
+    @param[in] current_indent    the current indent level (only used internally)
+    */
+    void dump(const BasicJsonType& val,
+              const bool pretty_print,
+              const bool ensure_ascii,
+              const unsigned int indent_step,
+              const unsigned int current_indent = 0)
+    {
+        switch (val.m_data.m_type)
+        {
+            case value_t::object:
+            {
+                if (val.m_data.m_value.object->empty())
+                {
+                    o->write_characters("{}", 2);
+                    return;
+                }
 
-    const cached_power cached = get_cached_power_for_binary_exponent(m_plus.e);
+                if (pretty_print)
+                {
+                    o->write_characters("{\n", 2);
 
-    const diyfp c_minus_k(cached.f, cached.e); // = c ~= 10^-k
+                    // variable to hold indentation for recursive calls
+                    const auto new_indent = current_indent + indent_step;
+                    if (JSON_HEDLEY_UNLIKELY(indent_string.size() < new_indent))
+                    {
+                        indent_string.resize(indent_string.size() * 2, ' ');
+                    }
 
-    // The exponent of the products is = v.e + c_minus_k.e + q and is in the range [alpha,gamma]
-    const diyfp w       = diyfp::mul(v,       c_minus_k);
-    const diyfp w_minus = diyfp::mul(m_minus, c_minus_k);
-    const diyfp w_plus  = diyfp::mul(m_plus,  c_minus_k);
+                    // first n-1 elements
+                    auto i = val.m_data.m_value.object->cbegin();
+                    for (std::size_t cnt = 0; cnt < val.m_data.m_value.object->size() - 1; ++cnt, ++i)
+                    {
+                        o->write_characters(indent_string.c_str(), new_indent);
+                        o->write_character('\"');
+                        dump_escaped(i->first, ensure_ascii);
+                        o->write_characters("\": ", 3);
+                        dump(i->second, true, ensure_ascii, indent_step, new_indent);
+                        o->write_characters(",\n", 2);
+                    }
 
-    //  ----(---+---)---------------(---+---)---------------(---+---)----
-    //          w-                      w                       w+
-    //          = c*m-                  = c*v                   = c*m+
-    //
-    // diyfp::mul rounds its result and c_minus_k is approximated too. w, w- and
-    // w+ are now off by a small amount.
-    // In fact:
-    //
-    //      w - v * 10^k < 1 ulp
-    //
-    // To account for this inaccuracy, add resp. subtract 1 ulp.
-    //
-    //  --------+---[---------------(---+---)---------------]---+--------
-    //          w-  M-                  w                   M+  w+
-    //
-    // Now any number in [M-, M+] (bounds included) will round to w when input,
-    // regardless of how the input rounding algorithm breaks ties.
-    //
-    // And digit_gen generates the shortest possible such number in [M-, M+].
-    // Note that this does not mean that Grisu2 always generates the shortest
-    // possible number in the interval (m-, m+).
-    const diyfp M_minus(w_minus.f + 1, w_minus.e);
-    const diyfp M_plus (w_plus.f  - 1, w_plus.e );
+                    // last element
+                    JSON_ASSERT(i != val.m_data.m_value.object->cend());
+                    JSON_ASSERT(std::next(i) == val.m_data.m_value.object->cend());
+                    o->write_characters(indent_string.c_str(), new_indent);
+                    o->write_character('\"');
+                    dump_escaped(i->first, ensure_ascii);
+                    o->write_characters("\": ", 3);
+                    dump(i->second, true, ensure_ascii, indent_step, new_indent);
 
-    decimal_exponent = -cached.k; // = -(-k) = k
+                    o->write_character('\n');
+                    o->write_characters(indent_string.c_str(), current_indent);
+                    o->write_character('}');
+                }
+                else
+                {
+                    o->write_character('{');
 
-    grisu2_digit_gen(buf, len, decimal_exponent, M_minus, w, M_plus);
-}
+                    // first n-1 elements
+                    auto i = val.m_data.m_value.object->cbegin();
+                    for (std::size_t cnt = 0; cnt < val.m_data.m_value.object->size() - 1; ++cnt, ++i)
+                    {
+                        o->write_character('\"');
+                        dump_escaped(i->first, ensure_ascii);
+                        o->write_characters("\":", 2);
+                        dump(i->second, false, ensure_ascii, indent_step, current_indent);
+                        o->write_character(',');
+                    }
 
-/*!
-v = buf * 10^decimal_exponent
-len is the length of the buffer (number of decimal digits)
-The buffer must be large enough, i.e. >= max_digits10.
-*/
-template<typename FloatType>
-JSON_HEDLEY_NON_NULL(1)
-void grisu2(char* buf, int& len, int& decimal_exponent, FloatType value)
-{
-    static_assert(diyfp::kPrecision >= std::numeric_limits<FloatType>::digits + 3,
-                  "internal error: not enough precision");
+                    // last element
+                    JSON_ASSERT(i != val.m_data.m_value.object->cend());
+                    JSON_ASSERT(std::next(i) == val.m_data.m_value.object->cend());
+                    o->write_character('\"');
+                    dump_escaped(i->first, ensure_ascii);
+                    o->write_characters("\":", 2);
+                    dump(i->second, false, ensure_ascii, indent_step, current_indent);
 
-    JSON_ASSERT(std::isfinite(value));
-    JSON_ASSERT(value > 0);
+                    o->write_character('}');
+                }
 
-    // If the neighbors (and boundaries) of 'value' are always computed for double-precision
-    // numbers, all float's can be recovered using strtod (and strtof). However, the resulting
-    // decimal representations are not exactly "short".
-    //
-    // The documentation for 'std::to_chars' (https://en.cppreference.com/w/cpp/utility/to_chars)
-    // says "value is converted to a string as if by std::sprintf in the default ("C") locale"
-    // and since sprintf promotes floats to doubles, I think this is exactly what 'std::to_chars'
-    // does.
-    // On the other hand, the documentation for 'std::to_chars' requires that "parsing the
-    // representation using the corresponding std::from_chars function recovers value exactly". That
-    // indicates that single precision floating-point numbers should be recovered using
-    // 'std::strtof'.
-    //
-    // NB: If the neighbors are computed for single-precision numbers, there is a single float
-    //     (7.0385307e-26f) which can't be recovered using strtod. The resulting double precision
-    //     value is off by 1 ulp.
-#if 0 // NOLINT(readability-avoid-unconditional-preprocessor-if)
-    const boundaries w = compute_boundaries(static_cast<double>(value));
-#else
-    const boundaries w = compute_boundaries(value);
-#endif
+                return;
+            }
 
-    grisu2(buf, len, decimal_exponent, w.minus, w.w, w.plus);
-}
+            case value_t::array:
+            {
+                if (val.m_data.m_value.array->empty())
+                {
+                    o->write_characters("[]", 2);
+                    return;
+                }
 
-/*!
-@brief appends a decimal representation of e to buf
-@return a pointer to the element following the exponent.
-@pre -1000 < e < 1000
-*/
-JSON_HEDLEY_NON_NULL(1)
-JSON_HEDLEY_RETURNS_NON_NULL
-inline char* append_exponent(char* buf, int e)
-{
-    JSON_ASSERT(e > -1000);
-    JSON_ASSERT(e <  1000);
+                if (pretty_print)
+                {
+                    o->write_characters("[\n", 2);
 
-    if (e < 0)
-    {
-        e = -e;
-        *buf++ = '-';
-    }
-    else
-    {
-        *buf++ = '+';
-    }
+                    // variable to hold indentation for recursive calls
+                    const auto new_indent = current_indent + indent_step;
+                    if (JSON_HEDLEY_UNLIKELY(indent_string.size() < new_indent))
+                    {
+                        indent_string.resize(indent_string.size() * 2, ' ');
+                    }
 
-    auto k = static_cast<std::uint32_t>(e);
-    if (k < 10)
-    {
-        // Always print at least two digits in the exponent.
-        // This is for compatibility with printf("%g").
-        *buf++ = '0';
-        *buf++ = static_cast<char>('0' + k);
-    }
-    else if (k < 100)
-    {
-        *buf++ = static_cast<char>('0' + k / 10);
-        k %= 10;
-        *buf++ = static_cast<char>('0' + k);
-    }
-    else
-    {
-        *buf++ = static_cast<char>('0' + k / 100);
-        k %= 100;
-        *buf++ = static_cast<char>('0' + k / 10);
-        k %= 10;
-        *buf++ = static_cast<char>('0' + k);
-    }
+                    // first n-1 elements
+                    for (auto i = val.m_data.m_value.array->cbegin();
+                            i != val.m_data.m_value.array->cend() - 1; ++i)
+                    {
+                        o->write_characters(indent_string.c_str(), new_indent);
+                        dump(*i, true, ensure_ascii, indent_step, new_indent);
+                        o->write_characters(",\n", 2);
+                    }
 
-    return buf;
-}
+                    // last element
+                    JSON_ASSERT(!val.m_data.m_value.array->empty());
+                    o->write_characters(indent_string.c_str(), new_indent);
+                    dump(val.m_data.m_value.array->back(), true, ensure_ascii, indent_step, new_indent);
 
-/*!
-@brief prettify v = buf * 10^decimal_exponent
+                    o->write_character('\n');
+                    o->write_characters(indent_string.c_str(), current_indent);
+                    o->write_character(']');
+                }
+                else
+                {
+                    o->write_character('[');
 
-If v is in the range [10^min_exp, 10^max_exp) it will be printed in fixed-point
-notation. Otherwise it will be printed in exponential notation.
+                    // first n-1 elements
+                    for (auto i = val.m_data.m_value.array->cbegin();
+                            i != val.m_data.m_value.array->cend() - 1; ++i)
+                    {
+                        dump(*i, false, ensure_ascii, indent_step, current_indent);
+                        o->write_character(',');
+                    }
 
-@pre min_exp < 0
-@pre max_exp > 0
-*/
-JSON_HEDLEY_NON_NULL(1)
-JSON_HEDLEY_RETURNS_NON_NULL
-inline char* format_buffer(char* buf, int len, int decimal_exponent,
-                           int min_exp, int max_exp)
-{
-    JSON_ASSERT(min_exp < 0);
-    JSON_ASSERT(max_exp > 0);
+                    // last element
+                    JSON_ASSERT(!val.m_data.m_value.array->empty());
+                    dump(val.m_data.m_value.array->back(), false, ensure_ascii, indent_step, current_indent);
 
-    const int k = len;
-    const int n = len + decimal_exponent;
+                    o->write_character(']');
+                }
 
-    // v = buf * 10^(n-k)
-    // k is the length of the buffer (number of decimal digits)
-    // n is the position of the decimal point relative to the start of the buffer.
+                return;
+            }
 
-    if (k <= n && n <= max_exp)
-    {
-        // digits[000]
-        // len <= max_exp + 2
+            case value_t::string:
+            {
+                o->write_character('\"');
+                dump_escaped(*val.m_data.m_value.string, ensure_ascii);
+                o->write_character('\"');
+                return;
+            }
 
-        std::memset(buf + k, '0', static_cast<size_t>(n) - static_cast<size_t>(k));
-        // Make it look like a floating-point number (#362, #378)
-        buf[n + 0] = '.';
-        buf[n + 1] = '0';
-        return buf + (static_cast<size_t>(n) + 2);
-    }
+            case value_t::binary:
+            {
+                if (pretty_print)
+                {
+                    o->write_characters("{\n", 2);
 
-    if (0 < n && n <= max_exp)
-    {
-        // dig.its
-        // len <= max_digits10 + 1
+                    // variable to hold indentation for recursive calls
+                    const auto new_indent = current_indent + indent_step;
+                    if (JSON_HEDLEY_UNLIKELY(indent_string.size() < new_indent))
+                    {
+                        indent_string.resize(indent_string.size() * 2, ' ');
+                    }
 
-        JSON_ASSERT(k > n);
+                    o->write_characters(indent_string.c_str(), new_indent);
 
-        std::memmove(buf + (static_cast<size_t>(n) + 1), buf + n, static_cast<size_t>(k) - static_cast<size_t>(n));
-        buf[n] = '.';
-        return buf + (static_cast<size_t>(k) + 1U);
-    }
+                    o->write_characters("\"bytes\": [", 10);
 
-    if (min_exp < n && n <= 0)
-    {
-        // 0.[000]digits
-        // len <= 2 + (-min_exp - 1) + max_digits10
+                    if (!val.m_data.m_value.binary->empty())
+                    {
+                        for (auto i = val.m_data.m_value.binary->cbegin();
+                                i != val.m_data.m_value.binary->cend() - 1; ++i)
+                        {
+                            dump_integer(*i);
+                            o->write_characters(", ", 2);
+                        }
+                        dump_integer(val.m_data.m_value.binary->back());
+                    }
 
-        std::memmove(buf + (2 + static_cast<size_t>(-n)), buf, static_cast<size_t>(k));
-        buf[0] = '0';
-        buf[1] = '.';
-        std::memset(buf + 2, '0', static_cast<size_t>(-n));
-        return buf + (2U + static_cast<size_t>(-n) + static_cast<size_t>(k));
-    }
+                    o->write_characters("],\n", 3);
+                    o->write_characters(indent_string.c_str(), new_indent);
 
-    if (k == 1)
-    {
-        // dE+123
-        // len <= 1 + 5
+                    o->write_characters("\"subtype\": ", 11);
+                    if (val.m_data.m_value.binary->has_subtype())
+                    {
+                        dump_integer(val.m_data.m_value.binary->subtype());
+                    }
+                    else
+                    {
+                        o->write_characters("null", 4);
+                    }
+                    o->write_character('\n');
+                    o->write_characters(indent_string.c_str(), current_indent);
+                    o->write_character('}');
+                }
+                else
+                {
+                    o->write_characters("{\"bytes\":[", 10);
 
-        buf += 1;
-    }
-    else
-    {
-        // d.igitsE+123
-        // len <= max_digits10 + 1 + 5
+                    if (!val.m_data.m_value.binary->empty())
+                    {
+                        for (auto i = val.m_data.m_value.binary->cbegin();
+                                i != val.m_data.m_value.binary->cend() - 1; ++i)
+                        {
+                            dump_integer(*i);
+                            o->write_character(',');
+                        }
+                        dump_integer(val.m_data.m_value.binary->back());
+                    }
 
-        std::memmove(buf + 2, buf + 1, static_cast<size_t>(k) - 1);
-        buf[1] = '.';
-        buf += 1 + static_cast<size_t>(k);
-    }
+                    o->write_characters("],\"subtype\":", 12);
+                    if (val.m_data.m_value.binary->has_subtype())
+                    {
+                        dump_integer(val.m_data.m_value.binary->subtype());
+                        o->write_character('}');
+                    }
+                    else
+                    {
+                        o->write_characters("null}", 5);
+                    }
+                }
+                return;
+            }
+
+            case value_t::boolean:
+            {
+                if (val.m_data.m_value.boolean)
+                {
+                    o->write_characters("true", 4);
+                }
+                else
+                {
+                    o->write_characters("false", 5);
+                }
+                return;
+            }
 
-    *buf++ = 'e';
-    return append_exponent(buf, n - 1);
-}
+            case value_t::number_integer:
+            {
+                dump_integer(val.m_data.m_value.number_integer);
+                return;
+            }
 
-}  // namespace dtoa_impl
+            case value_t::number_unsigned:
+            {
+                dump_integer(val.m_data.m_value.number_unsigned);
+                return;
+            }
 
-/*!
-@brief generates a decimal representation of the floating-point number value in [first, last).
+            case value_t::number_float:
+            {
+                dump_float(val.m_data.m_value.number_float);
+                return;
+            }
 
-The format of the resulting decimal representation is similar to printf's %g
-format. Returns an iterator pointing past-the-end of the decimal representation.
+            case value_t::discarded:
+            {
+                o->write_characters("<discarded>", 11);
+                return;
+            }
 
-@note The input number must be finite, i.e. NaN's and Inf's are not supported.
-@note The buffer must be large enough.
-@note The result is NOT null-terminated.
-*/
-template<typename FloatType>
-JSON_HEDLEY_NON_NULL(1, 2)
-JSON_HEDLEY_RETURNS_NON_NULL
-char* to_chars(char* first, const char* last, FloatType value)
-{
-    static_cast<void>(last); // maybe unused - fix warning
-    JSON_ASSERT(std::isfinite(value));
+            case value_t::null:
+            {
+                o->write_characters("null", 4);
+                return;
+            }
 
-    // Use signbit(value) instead of (value < 0) since signbit works for -0.
-    if (std::signbit(value))
-    {
-        value = -value;
-        *first++ = '-';
+            default:            // LCOV_EXCL_LINE
+                JSON_ASSERT(false); // NOLINT(cert-dcl03-c,hicpp-static-assert,misc-static-assert) LCOV_EXCL_LINE
+        }
     }
 
-#ifdef __GNUC__
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wfloat-equal"
-#endif
-    if (value == 0) // +-0
-    {
-        *first++ = '0';
-        // Make it look like a floating-point number (#362, #378)
-        *first++ = '.';
-        *first++ = '0';
-        return first;
-    }
-#ifdef __GNUC__
-#pragma GCC diagnostic pop
-#endif
+  JSON_PRIVATE_UNLESS_TESTED:
+    /*!
+    @brief dump escaped string
 
-    JSON_ASSERT(last - first >= std::numeric_limits<FloatType>::max_digits10);
+    Escape a string by replacing certain special characters by a sequence of an
+    escape character (backslash) and another character and other control
+    characters by a sequence of "\u" followed by a four-digit hex
+    representation. The escaped string is written to output stream @a o.
 
-    // Compute v = buffer * 10^decimal_exponent.
-    // The decimal digits are stored in the buffer, which needs to be interpreted
-    // as an unsigned decimal integer.
-    // len is the length of the buffer, i.e. the number of decimal digits.
-    int len = 0;
-    int decimal_exponent = 0;
-    dtoa_impl::grisu2(first, len, decimal_exponent, value);
+    @param[in] s  the string to escape
+    @param[in] ensure_ascii  whether to escape non-ASCII characters with
+                             \uXXXX sequences
 
-    JSON_ASSERT(len <= std::numeric_limits<FloatType>::max_digits10);
+    @complexity Linear in the length of string @a s.
+    */
+    void dump_escaped(const string_t& s, const bool ensure_ascii)
+    {
+        std::uint32_t codepoint{};
+        std::uint8_t state = UTF8_ACCEPT;
+        std::size_t bytes = 0;  // number of bytes written to string_buffer
 
-    // Format the buffer like printf("%.*g", prec, value)
-    constexpr int kMinExp = -4;
-    // Use digits10 here to increase compatibility with version 2.
-    constexpr int kMaxExp = std::numeric_limits<FloatType>::digits10;
+        // number of bytes written at the point of the last valid byte
+        std::size_t bytes_after_last_accept = 0;
+        std::size_t undumped_chars = 0;
 
-    JSON_ASSERT(last - first >= kMaxExp + 2);
-    JSON_ASSERT(last - first >= 2 + (-kMinExp - 1) + std::numeric_limits<FloatType>::max_digits10);
-    JSON_ASSERT(last - first >= std::numeric_limits<FloatType>::max_digits10 + 6);
+        for (std::size_t i = 0; i < s.size(); ++i)
+        {
+            const auto byte = static_cast<std::uint8_t>(s[i]);
 
-    return dtoa_impl::format_buffer(first, len, decimal_exponent, kMinExp, kMaxExp);
-}
+            switch (decode(state, codepoint, byte))
+            {
+                case UTF8_ACCEPT:  // decode found a new code point
+                {
+                    switch (codepoint)
+                    {
+                        case 0x08: // backspace
+                        {
+                            string_buffer[bytes++] = '\\';
+                            string_buffer[bytes++] = 'b';
+                            break;
+                        }
 
-}  // namespace detail
-NLOHMANN_JSON_NAMESPACE_END
+                        case 0x09: // horizontal tab
+                        {
+                            string_buffer[bytes++] = '\\';
+                            string_buffer[bytes++] = 't';
+                            break;
+                        }
 
-// #include <nlohmann/detail/exceptions.hpp>
+                        case 0x0A: // newline
+                        {
+                            string_buffer[bytes++] = '\\';
+                            string_buffer[bytes++] = 'n';
+                            break;
+                        }
 
-// #include <nlohmann/detail/macro_scope.hpp>
+                        case 0x0C: // formfeed
+                        {
+                            string_buffer[bytes++] = '\\';
+                            string_buffer[bytes++] = 'f';
+                            break;
+                        }
 
-// #include <nlohmann/detail/meta/cpp_future.hpp>
+                        case 0x0D: // carriage return
+                        {
+                            string_buffer[bytes++] = '\\';
+                            string_buffer[bytes++] = 'r';
+                            break;
+                        }
 
-// #include <nlohmann/detail/output/binary_writer.hpp>
+                        case 0x22: // quotation mark
+                        {
+                            string_buffer[bytes++] = '\\';
+                            string_buffer[bytes++] = '\"';
+                            break;
+                        }
 
-// #include <nlohmann/detail/output/output_adapters.hpp>
+                        case 0x5C: // reverse solidus
+                        {
+                            string_buffer[bytes++] = '\\';
+                            string_buffer[bytes++] = '\\';
+                            break;
+                        }
 
-// #include <nlohmann/detail/string_concat.hpp>
+                        default:
+                        {
+                            // escape control characters (0x00..0x1F) or, if
+                            // ensure_ascii parameter is used, non-ASCII characters
+                            if ((codepoint <= 0x1F) || (ensure_ascii && (codepoint >= 0x7F)))
+                            {
+                                if (codepoint <= 0xFFFF)
+                                {
+                                    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg,hicpp-vararg)
+                                    static_cast<void>((std::snprintf)(string_buffer.data() + bytes, 7, "\\u%04x",
+                                                                      static_cast<std::uint16_t>(codepoint)));
+                                    bytes += 6;
+                                }
+                                else
+                                {
+                                    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg,hicpp-vararg)
+                                    static_cast<void>((std::snprintf)(string_buffer.data() + bytes, 13, "\\u%04x\\u%04x",
+                                                                      static_cast<std::uint16_t>(0xD7C0u + (codepoint >> 10u)),
+                                                                      static_cast<std::uint16_t>(0xDC00u + (codepoint & 0x3FFu))));
+                                    bytes += 12;
+                                }
+                            }
+                            else
+                            {
+                                // copy byte to buffer (all previous bytes
+                                // been copied have in default case above)
+                                string_buffer[bytes++] = s[i];
+                            }
+                            break;
+                        }
+                    }
 
-// #include <nlohmann/detail/value_t.hpp>
+                    // write buffer and reset index; there must be 13 bytes
+                    // left, as this is the maximal number of bytes to be
+                    // written ("\uxxxx\uxxxx\0") for one code point
+                    if (string_buffer.size() - bytes < 13)
+                    {
+                        o->write_characters(string_buffer.data(), bytes);
+                        bytes = 0;
+                    }
 
+                    // remember the byte position of this accept
+                    bytes_after_last_accept = bytes;
+                    undumped_chars = 0;
+                    break;
+                }
 
-NLOHMANN_JSON_NAMESPACE_BEGIN
-namespace detail
-{
+                case UTF8_REJECT:  // decode found invalid UTF-8 byte
+                {
+                    switch (error_handler)
+                    {
+                        case error_handler_t::strict:
+                        {
+                            JSON_THROW(type_error::create(316, concat("invalid UTF-8 byte at index ", std::to_string(i), ": 0x", hex_bytes(byte | 0)), nullptr));
+                        }
 
-///////////////////
-// serialization //
-///////////////////
+                        case error_handler_t::ignore:
+                        case error_handler_t::replace:
+                        {
+                            // in case we saw this character the first time, we
+                            // would like to read it again, because the byte
+                            // may be OK for itself, but just not OK for the
+                            // previous sequence
+                            if (undumped_chars > 0)
+                            {
+                                --i;
+                            }
 
-/// how to treat decoding errors
-enum class error_handler_t
-{
-    strict,  ///< throw a type_error exception in case of invalid UTF-8
-    replace, ///< replace invalid UTF-8 sequences with U+FFFD
-    ignore   ///< ignore invalid UTF-8 sequences
-};
+                            // reset length buffer to the last accepted index;
+                            // thus removing/ignoring the invalid characters
+                            bytes = bytes_after_last_accept;
+
+                            if (error_handler == error_handler_t::replace)
+                            {
+                                // add a replacement character
+                                if (ensure_ascii)
+                                {
+                                    string_buffer[bytes++] = '\\';
+                                    string_buffer[bytes++] = 'u';
+                                    string_buffer[bytes++] = 'f';
+                                    string_buffer[bytes++] = 'f';
+                                    string_buffer[bytes++] = 'f';
+                                    string_buffer[bytes++] = 'd';
+                                }
+                                else
+                                {
+                                    string_buffer[bytes++] = detail::binary_writer<BasicJsonType, char>::to_char_type('\xEF');
+                                    string_buffer[bytes++] = detail::binary_writer<BasicJsonType, char>::to_char_type('\xBF');
+                                    string_buffer[bytes++] = detail::binary_writer<BasicJsonType, char>::to_char_type('\xBD');
+                                }
 
-template<typename BasicJsonType>
-class serializer
-{
-    using string_t = typename BasicJsonType::string_t;
-    using number_float_t = typename BasicJsonType::number_float_t;
-    using number_integer_t = typename BasicJsonType::number_integer_t;
-    using number_unsigned_t = typename BasicJsonType::number_unsigned_t;
-    using binary_char_t = typename BasicJsonType::binary_t::value_type;
-    static constexpr std::uint8_t UTF8_ACCEPT = 0;
-    static constexpr std::uint8_t UTF8_REJECT = 1;
+                                // write buffer and reset index; there must be 13 bytes
+                                // left, as this is the maximal number of bytes to be
+                                // written ("\uxxxx\uxxxx\0") for one code point
+                                if (string_buffer.size() - bytes < 13)
+                                {
+                                    o->write_characters(string_buffer.data(), bytes);
+                                    bytes = 0;
+                                }
 
-  public:
-    /*!
-    @param[in] s  output stream to serialize to
-    @param[in] ichar  indentation character to use
-    @param[in] error_handler_  how to react on decoding errors
-    */
-    serializer(output_adapter_t<char> s, const char ichar,
-               error_handler_t error_handler_ = error_handler_t::strict)
-        : o(std::move(s))
-        , loc(std::localeconv())
-        , thousands_sep(loc->thousands_sep == nullptr ? '\0' : std::char_traits<char>::to_char_type(* (loc->thousands_sep)))
-        , decimal_point(loc->decimal_point == nullptr ? '\0' : std::char_traits<char>::to_char_type(* (loc->decimal_point)))
-        , indent_char(ichar)
-        , indent_string(512, indent_char)
-        , error_handler(error_handler_)
-    {}
+                                bytes_after_last_accept = bytes;
+                            }
 
-    // delete because of pointer members
-    serializer(const serializer&) = delete;
-    serializer& operator=(const serializer&) = delete;
-    serializer(serializer&&) = delete;
-    serializer& operator=(serializer&&) = delete;
-    ~serializer() = default;
+                            undumped_chars = 0;
 
-    /*!
-    @brief internal implementation of the serialization function
+                            // continue processing the string
+                            state = UTF8_ACCEPT;
+                            break;
+                        }
 
-    This function is called by the public member function dump and organizes
-    the serialization internally. The indentation level is propagated as
-    additional parameter. In case of arrays and objects, the function is
-    called recursively.
+                        default:            // LCOV_EXCL_LINE
+                            JSON_ASSERT(false); // NOLINT(cert-dcl03-c,hicpp-static-assert,misc-static-assert) LCOV_EXCL_LINE
+                    }
+                    break;
+                }
 
-    - strings and object keys are escaped using `escape_string()`
-    - integer numbers are converted implicitly via `operator<<`
-    - floating-point numbers are converted to a string using `"%g"` format
-    - binary values are serialized as objects containing the subtype and the
-      byte array
+                default:  // decode found yet incomplete multi-byte code point
+                {
+                    if (!ensure_ascii)
+                    {
+                        // code point will not be escaped - copy byte to buffer
+                        string_buffer[bytes++] = s[i];
+                    }
+                    ++undumped_chars;
+                    break;
+                }
+            }
+        }
 
-    @param[in] val               value to serialize
-    @param[in] pretty_print      whether the output shall be pretty-printed
-    @param[in] ensure_ascii If @a ensure_ascii is true, all non-ASCII characters
-    in the output are escaped with `\uXXXX` sequences, and the result consists
-    of ASCII characters only.
-    @param[in] indent_step       the indent level
-    @param[in] current_indent    the current indent level (only used internally)
-    */
-    void dump(const BasicJsonType& val,
-              const bool pretty_print,
-              const bool ensure_ascii,
-              const unsigned int indent_step,
-              const unsigned int current_indent = 0)
-    {
-        switch (val.m_data.m_type)
+        // we finished processing the string
+        if (JSON_HEDLEY_LIKELY(state == UTF8_ACCEPT))
         {
-            case value_t::object:
+            // write buffer
+            if (bytes > 0)
             {
-                if (val.m_data.m_value.object->empty())
+                o->write_characters(string_buffer.data(), bytes);
+            }
+        }
+        else
+        {
+            // we finish reading, but do not accept: string was incomplete
+            switch (error_handler)
+            {
+                case error_handler_t::strict:
                 {
-                    o->write_characters("{}", 2);
-                    return;
+                    JSON_THROW(type_error::create(316, concat("incomplete UTF-8 string; last byte: 0x", hex_bytes(static_cast<std::uint8_t>(s.back() | 0))), nullptr));
                 }
 
-                if (pretty_print)
+                case error_handler_t::ignore:
                 {
-                    o->write_characters("{\n", 2);
+                    // write all accepted bytes
+                    o->write_characters(string_buffer.data(), bytes_after_last_accept);
+                    break;
+                }
 
-                    // variable to hold indentation for recursive calls
-                    const auto new_indent = current_indent + indent_step;
-                    if (JSON_HEDLEY_UNLIKELY(indent_string.size() < new_indent))
+                case error_handler_t::replace:
+                {
+                    // write all accepted bytes
+                    o->write_characters(string_buffer.data(), bytes_after_last_accept);
+                    // add a replacement character
+                    if (ensure_ascii)
                     {
-                        indent_string.resize(indent_string.size() * 2, ' ');
+                        o->write_characters("\\ufffd", 6);
                     }
-
-                    // first n-1 elements
-                    auto i = val.m_data.m_value.object->cbegin();
-                    for (std::size_t cnt = 0; cnt < val.m_data.m_value.object->size() - 1; ++cnt, ++i)
+                    else
                     {
-                        o->write_characters(indent_string.c_str(), new_indent);
-                        o->write_character('\"');
-                        dump_escaped(i->first, ensure_ascii);
-                        o->write_characters("\": ", 3);
-                        dump(i->second, true, ensure_ascii, indent_step, new_indent);
-                        o->write_characters(",\n", 2);
+                        o->write_characters("\xEF\xBF\xBD", 3);
                     }
-
-                    // last element
-                    JSON_ASSERT(i != val.m_data.m_value.object->cend());
-                    JSON_ASSERT(std::next(i) == val.m_data.m_value.object->cend());
-                    o->write_characters(indent_string.c_str(), new_indent);
-                    o->write_character('\"');
-                    dump_escaped(i->first, ensure_ascii);
-                    o->write_characters("\": ", 3);
-                    dump(i->second, true, ensure_ascii, indent_step, new_indent);
-
-                    o->write_character('\n');
-                    o->write_characters(indent_string.c_str(), current_indent);
-                    o->write_character('}');
+                    break;
                 }
-                else
-                {
-                    o->write_character('{');
 
-                    // first n-1 elements
-                    auto i = val.m_data.m_value.object->cbegin();
-                    for (std::size_t cnt = 0; cnt < val.m_data.m_value.object->size() - 1; ++cnt, ++i)
-                    {
-                        o->write_character('\"');
-                        dump_escaped(i->first, ensure_ascii);
-                        o->write_characters("\":", 2);
-                        dump(i->second, false, ensure_ascii, indent_step, current_indent);
-                        o->write_character(',');
-                    }
+                default:            // LCOV_EXCL_LINE
+                    JSON_ASSERT(false); // NOLINT(cert-dcl03-c,hicpp-static-assert,misc-static-assert) LCOV_EXCL_LINE
+            }
+        }
+    }
 
-                    // last element
-                    JSON_ASSERT(i != val.m_data.m_value.object->cend());
-                    JSON_ASSERT(std::next(i) == val.m_data.m_value.object->cend());
-                    o->write_character('\"');
-                    dump_escaped(i->first, ensure_ascii);
-                    o->write_characters("\":", 2);
-                    dump(i->second, false, ensure_ascii, indent_step, current_indent);
+  private:
+    /*!
+    @brief count digits
 
-                    o->write_character('}');
-                }
+    Count the number of decimal (base 10) digits for an input unsigned integer.
 
-                return;
+    @param[in] x  unsigned integer number to count its digits
+    @return    number of decimal digits
+    */
+    inline unsigned int count_digits(number_unsigned_t x) noexcept
+    {
+        unsigned int n_digits = 1;
+        for (;;)
+        {
+            if (x < 10)
+            {
+                return n_digits;
+            }
+            if (x < 100)
+            {
+                return n_digits + 1;
+            }
+            if (x < 1000)
+            {
+                return n_digits + 2;
+            }
+            if (x < 10000)
+            {
+                return n_digits + 3;
             }
+            x = x / 10000u;
+            n_digits += 4;
+        }
+    }
+
+    /*!
+     * @brief convert a byte to a uppercase hex representation
+     * @param[in] byte byte to represent
+     * @return representation ("00".."FF")
+     */
+    static std::string hex_bytes(std::uint8_t byte)
+    {
+        std::string result = "FF";
+        constexpr const char* nibble_to_hex = "0123456789ABCDEF";
+        result[0] = nibble_to_hex[byte / 16];
+        result[1] = nibble_to_hex[byte % 16];
+        return result;
+    }
+
+    // templates to avoid warnings about useless casts
+    template <typename NumberType, enable_if_t<std::is_signed<NumberType>::value, int> = 0>
+    bool is_negative_number(NumberType x)
+    {
+        return x < 0;
+    }
+
+    template < typename NumberType, enable_if_t <std::is_unsigned<NumberType>::value, int > = 0 >
+    bool is_negative_number(NumberType /*unused*/)
+    {
+        return false;
+    }
+
+    /*!
+    @brief dump an integer
+
+    Dump a given integer to output stream @a o. Works internally with
+    @a number_buffer.
 
-            case value_t::array:
+    @param[in] x  integer number (signed or unsigned) to dump
+    @tparam NumberType either @a number_integer_t or @a number_unsigned_t
+    */
+    template < typename NumberType, detail::enable_if_t <
+                   std::is_integral<NumberType>::value ||
+                   std::is_same<NumberType, number_unsigned_t>::value ||
+                   std::is_same<NumberType, number_integer_t>::value ||
+                   std::is_same<NumberType, binary_char_t>::value,
+                   int > = 0 >
+    void dump_integer(NumberType x)
+    {
+        static constexpr std::array<std::array<char, 2>, 100> digits_to_99
+        {
             {
-                if (val.m_data.m_value.array->empty())
-                {
-                    o->write_characters("[]", 2);
-                    return;
-                }
+                {{'0', '0'}}, {{'0', '1'}}, {{'0', '2'}}, {{'0', '3'}}, {{'0', '4'}}, {{'0', '5'}}, {{'0', '6'}}, {{'0', '7'}}, {{'0', '8'}}, {{'0', '9'}},
+                {{'1', '0'}}, {{'1', '1'}}, {{'1', '2'}}, {{'1', '3'}}, {{'1', '4'}}, {{'1', '5'}}, {{'1', '6'}}, {{'1', '7'}}, {{'1', '8'}}, {{'1', '9'}},
+                {{'2', '0'}}, {{'2', '1'}}, {{'2', '2'}}, {{'2', '3'}}, {{'2', '4'}}, {{'2', '5'}}, {{'2', '6'}}, {{'2', '7'}}, {{'2', '8'}}, {{'2', '9'}},
+                {{'3', '0'}}, {{'3', '1'}}, {{'3', '2'}}, {{'3', '3'}}, {{'3', '4'}}, {{'3', '5'}}, {{'3', '6'}}, {{'3', '7'}}, {{'3', '8'}}, {{'3', '9'}},
+                {{'4', '0'}}, {{'4', '1'}}, {{'4', '2'}}, {{'4', '3'}}, {{'4', '4'}}, {{'4', '5'}}, {{'4', '6'}}, {{'4', '7'}}, {{'4', '8'}}, {{'4', '9'}},
+                {{'5', '0'}}, {{'5', '1'}}, {{'5', '2'}}, {{'5', '3'}}, {{'5', '4'}}, {{'5', '5'}}, {{'5', '6'}}, {{'5', '7'}}, {{'5', '8'}}, {{'5', '9'}},
+                {{'6', '0'}}, {{'6', '1'}}, {{'6', '2'}}, {{'6', '3'}}, {{'6', '4'}}, {{'6', '5'}}, {{'6', '6'}}, {{'6', '7'}}, {{'6', '8'}}, {{'6', '9'}},
+                {{'7', '0'}}, {{'7', '1'}}, {{'7', '2'}}, {{'7', '3'}}, {{'7', '4'}}, {{'7', '5'}}, {{'7', '6'}}, {{'7', '7'}}, {{'7', '8'}}, {{'7', '9'}},
+                {{'8', '0'}}, {{'8', '1'}}, {{'8', '2'}}, {{'8', '3'}}, {{'8', '4'}}, {{'8', '5'}}, {{'8', '6'}}, {{'8', '7'}}, {{'8', '8'}}, {{'8', '9'}},
+                {{'9', '0'}}, {{'9', '1'}}, {{'9', '2'}}, {{'9', '3'}}, {{'9', '4'}}, {{'9', '5'}}, {{'9', '6'}}, {{'9', '7'}}, {{'9', '8'}}, {{'9', '9'}},
+            }
+        };
 
-                if (pretty_print)
-                {
-                    o->write_characters("[\n", 2);
+        // special case for "0"
+        if (x == 0)
+        {
+            o->write_character('0');
+            return;
+        }
 
-                    // variable to hold indentation for recursive calls
-                    const auto new_indent = current_indent + indent_step;
-                    if (JSON_HEDLEY_UNLIKELY(indent_string.size() < new_indent))
-                    {
-                        indent_string.resize(indent_string.size() * 2, ' ');
-                    }
+        // use a pointer to fill the buffer
+        auto buffer_ptr = number_buffer.begin(); // NOLINT(llvm-qualified-auto,readability-qualified-auto,cppcoreguidelines-pro-type-vararg,hicpp-vararg)
 
-                    // first n-1 elements
-                    for (auto i = val.m_data.m_value.array->cbegin();
-                            i != val.m_data.m_value.array->cend() - 1; ++i)
-                    {
-                        o->write_characters(indent_string.c_str(), new_indent);
-                        dump(*i, true, ensure_ascii, indent_step, new_indent);
-                        o->write_characters(",\n", 2);
-                    }
+        number_unsigned_t abs_value;
 
-                    // last element
-                    JSON_ASSERT(!val.m_data.m_value.array->empty());
-                    o->write_characters(indent_string.c_str(), new_indent);
-                    dump(val.m_data.m_value.array->back(), true, ensure_ascii, indent_step, new_indent);
+        unsigned int n_chars{};
 
-                    o->write_character('\n');
-                    o->write_characters(indent_string.c_str(), current_indent);
-                    o->write_character(']');
-                }
-                else
-                {
-                    o->write_character('[');
+        if (is_negative_number(x))
+        {
+            *buffer_ptr = '-';
+            abs_value = remove_sign(static_cast<number_integer_t>(x));
 
-                    // first n-1 elements
-                    for (auto i = val.m_data.m_value.array->cbegin();
-                            i != val.m_data.m_value.array->cend() - 1; ++i)
-                    {
-                        dump(*i, false, ensure_ascii, indent_step, current_indent);
-                        o->write_character(',');
-                    }
+            // account one more byte for the minus sign
+            n_chars = 1 + count_digits(abs_value);
+        }
+        else
+        {
+            abs_value = static_cast<number_unsigned_t>(x);
+            n_chars = count_digits(abs_value);
+        }
 
-                    // last element
-                    JSON_ASSERT(!val.m_data.m_value.array->empty());
-                    dump(val.m_data.m_value.array->back(), false, ensure_ascii, indent_step, current_indent);
+        // spare 1 byte for '\0'
+        JSON_ASSERT(n_chars < number_buffer.size() - 1);
 
-                    o->write_character(']');
-                }
+        // jump to the end to generate the string from backward,
+        // so we later avoid reversing the result
+        buffer_ptr += n_chars;
 
-                return;
-            }
+        // Fast int2ascii implementation inspired by "Fastware" talk by Andrei Alexandrescu
+        // See: https://www.youtube.com/watch?v=o4-CwDo2zpg
+        while (abs_value >= 100)
+        {
+            const auto digits_index = static_cast<unsigned>((abs_value % 100));
+            abs_value /= 100;
+            *(--buffer_ptr) = digits_to_99[digits_index][1];
+            *(--buffer_ptr) = digits_to_99[digits_index][0];
+        }
 
-            case value_t::string:
-            {
-                o->write_character('\"');
-                dump_escaped(*val.m_data.m_value.string, ensure_ascii);
-                o->write_character('\"');
-                return;
-            }
+        if (abs_value >= 10)
+        {
+            const auto digits_index = static_cast<unsigned>(abs_value);
+            *(--buffer_ptr) = digits_to_99[digits_index][1];
+            *(--buffer_ptr) = digits_to_99[digits_index][0];
+        }
+        else
+        {
+            *(--buffer_ptr) = static_cast<char>('0' + abs_value);
+        }
 
-            case value_t::binary:
-            {
-                if (pretty_print)
-                {
-                    o->write_characters("{\n", 2);
+        o->write_characters(number_buffer.data(), n_chars);
+    }
 
-                    // variable to hold indentation for recursive calls
-                    const auto new_indent = current_indent + indent_step;
-                    if (JSON_HEDLEY_UNLIKELY(indent_string.size() < new_indent))
-                    {
-                        indent_string.resize(indent_string.size() * 2, ' ');
-                    }
+    /*!
+    @brief dump a floating-point number
 
-                    o->write_characters(indent_string.c_str(), new_indent);
+    Dump a given floating-point number to output stream @a o. Works internally
+    with @a number_buffer.
 
-                    o->write_characters("\"bytes\": [", 10);
+    @param[in] x  floating-point number to dump
+    */
+    void dump_float(number_float_t x)
+    {
+        // NaN / inf
+        if (!std::isfinite(x))
+        {
+            o->write_characters("null", 4);
+            return;
+        }
 
-                    if (!val.m_data.m_value.binary->empty())
-                    {
-                        for (auto i = val.m_data.m_value.binary->cbegin();
-                                i != val.m_data.m_value.binary->cend() - 1; ++i)
-                        {
-                            dump_integer(*i);
-                            o->write_characters(", ", 2);
-                        }
-                        dump_integer(val.m_data.m_value.binary->back());
-                    }
+        // If number_float_t is an IEEE-754 single or double precision number,
+        // use the Grisu2 algorithm to produce short numbers which are
+        // guaranteed to round-trip, using strtof and strtod, resp.
+        //
+        // NB: The test below works if <long double> == <double>.
+        static constexpr bool is_ieee_single_or_double
+            = (std::numeric_limits<number_float_t>::is_iec559 && std::numeric_limits<number_float_t>::digits == 24 && std::numeric_limits<number_float_t>::max_exponent == 128) ||
+              (std::numeric_limits<number_float_t>::is_iec559 && std::numeric_limits<number_float_t>::digits == 53 && std::numeric_limits<number_float_t>::max_exponent == 1024);
 
-                    o->write_characters("],\n", 3);
-                    o->write_characters(indent_string.c_str(), new_indent);
+        dump_float(x, std::integral_constant<bool, is_ieee_single_or_double>());
+    }
 
-                    o->write_characters("\"subtype\": ", 11);
-                    if (val.m_data.m_value.binary->has_subtype())
-                    {
-                        dump_integer(val.m_data.m_value.binary->subtype());
-                    }
-                    else
-                    {
-                        o->write_characters("null", 4);
-                    }
-                    o->write_character('\n');
-                    o->write_characters(indent_string.c_str(), current_indent);
-                    o->write_character('}');
-                }
-                else
-                {
-                    o->write_characters("{\"bytes\":[", 10);
+    void dump_float(number_float_t x, std::true_type /*is_ieee_single_or_double*/)
+    {
+        auto* begin = number_buffer.data();
+        auto* end = is_float32_value(x)
+                    ? ::nlohmann::detail::to_chars<float, number_float_t>(begin, begin + number_buffer.size(), static_cast<float>(x))
+                    : ::nlohmann::detail::to_chars(begin, begin + number_buffer.size(), x);
 
-                    if (!val.m_data.m_value.binary->empty())
-                    {
-                        for (auto i = val.m_data.m_value.binary->cbegin();
-                                i != val.m_data.m_value.binary->cend() - 1; ++i)
-                        {
-                            dump_integer(*i);
-                            o->write_character(',');
-                        }
-                        dump_integer(val.m_data.m_value.binary->back());
-                    }
+        o->write_characters(begin, static_cast<size_t>(end - begin));
+    }
 
-                    o->write_characters("],\"subtype\":", 12);
-                    if (val.m_data.m_value.binary->has_subtype())
-                    {
-                        dump_integer(val.m_data.m_value.binary->subtype());
-                        o->write_character('}');
-                    }
-                    else
-                    {
-                        o->write_characters("null}", 5);
-                    }
-                }
-                return;
-            }
+    /// whether x is printed as a float (see set_float32_output)
+    bool is_float32_value(number_float_t x) const noexcept
+    {
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+#endif
+        return float32_output && std::numeric_limits<number_float_t>::digits > std::numeric_limits<float>::digits
+               && std::abs(x) <= static_cast<number_float_t>((std::numeric_limits<float>::max)())
+               && static_cast<number_float_t>(static_cast<float>(x)) == x;
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif
+    }
 
-            case value_t::boolean:
-            {
-                if (val.m_data.m_value.boolean)
-                {
-                    o->write_characters("true", 4);
-                }
-                else
-                {
-                    o->write_characters("false", 5);
-                }
-                return;
-            }
+    void dump_float(number_float_t x, std::false_type /*is_ieee_single_or_double*/)
+    {
+        // get number of digits for a float -> text -> float round-trip
+        static constexpr auto d = std::numeric_limits<number_float_t>::max_digits10;
 
-            case value_t::number_integer:
-            {
-                dump_integer(val.m_data.m_value.number_integer);
-                return;
-            }
+        // the actual conversion
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg,hicpp-vararg)
+        std::ptrdiff_t len = (std::snprintf)(number_buffer.data(), number_buffer.size(), "%.*g", d, x);
 
-            case value_t::number_unsigned:
-            {
-                dump_integer(val.m_data.m_value.number_unsigned);
-                return;
-            }
+        // negative value indicates an error
+        JSON_ASSERT(len > 0);
+        // check if buffer was large enough
+        JSON_ASSERT(static_cast<std::size_t>(len) < number_buffer.size());
 
-            case value_t::number_float:
-            {
-                dump_float(val.m_data.m_value.number_float);
-                return;
-            }
+        // erase thousands separator
+        if (thousands_sep != '\0')
+        {
+            // NOLINTNEXTLINE(readability-qualified-auto,llvm-qualified-auto): std::remove returns an iterator, see https://github.com/nlohmann/json/issues/3081
+            const auto end = std::remove(number_buffer.begin(), number_buffer.begin() + len, thousands_sep);
+            std::fill(end, number_buffer.end(), '\0');
+            JSON_ASSERT((end - number_buffer.begin()) <= len);
+            len = (end - number_buffer.begin());
+        }
 
-            case value_t::discarded:
+        // convert decimal point to '.'
+        if (decimal_point != '\0' && decimal_point != '.')
+        {
+            // NOLINTNEXTLINE(readability-qualified-auto,llvm-qualified-auto): std::find returns an iterator, see https://github.com/nlohmann/json/issues/3081
+            const auto dec_pos = std::find(number_buffer.begin(), number_buffer.end(), decimal_point);
+            if (dec_pos != number_buffer.end())
             {
-                o->write_characters("<discarded>", 11);
-                return;
+                *dec_pos = '.';
             }
+        }
 
-            case value_t::null:
-            {
-                o->write_characters("null", 4);
-                return;
-            }
+        o->write_characters(number_buffer.data(), static_cast<std::size_t>(len));
 
-            default:            // LCOV_EXCL_LINE
-                JSON_ASSERT(false); // NOLINT(cert-dcl03-c,hicpp-static-assert,misc-static-assert) LCOV_EXCL_LINE
+        // determine if we need to append ".0"
+        const bool value_is_int_like =
+            std::none_of(number_buffer.begin(), number_buffer.begin() + len + 1,
+                         [](char c)
+        {
+            return c == '.' || c == 'e';
+        });
+
+        if (value_is_int_like)
+        {
+            o->write_characters(".0", 2);
         }
     }
 
-  JSON_PRIVATE_UNLESS_TESTED:
     /*!
-    @brief dump escaped string
+    @brief check whether a string is UTF-8 encoded
 
-    Escape a string by replacing certain special characters by a sequence of an
-    escape character (backslash) and another character and other control
-    characters by a sequence of "\u" followed by a four-digit hex
-    representation. The escaped string is written to output stream @a o.
+    The function checks each byte of a string whether it is UTF-8 encoded. The
+    result of the check is stored in the @a state parameter. The function must
+    be called initially with state 0 (accept). State 1 means the string must
+    be rejected, because the current byte is not allowed. If the string is
+    completely processed, but the state is non-zero, the string ended
+    prematurely; that is, the last byte indicated more bytes should have
+    followed.
 
-    @param[in] s  the string to escape
-    @param[in] ensure_ascii  whether to escape non-ASCII characters with
-                             \uXXXX sequences
+    @param[in,out] state  the state of the decoding
+    @param[in,out] codep  codepoint (valid only if resulting state is UTF8_ACCEPT)
+    @param[in] byte       next byte to decode
+    @return               new state
 
-    @complexity Linear in the length of string @a s.
+    @note The function has been edited: a std::array is used.
+
+    @copyright Copyright (c) 2008-2009 Bjoern Hoehrmann <bjoern@hoehrmann.de>
+    @sa http://bjoern.hoehrmann.de/utf-8/decoder/dfa/
     */
-    void dump_escaped(const string_t& s, const bool ensure_ascii)
+    static std::uint8_t decode(std::uint8_t& state, std::uint32_t& codep, const std::uint8_t byte) noexcept
     {
-        std::uint32_t codepoint{};
-        std::uint8_t state = UTF8_ACCEPT;
-        std::size_t bytes = 0;  // number of bytes written to string_buffer
-
-        // number of bytes written at the point of the last valid byte
-        std::size_t bytes_after_last_accept = 0;
-        std::size_t undumped_chars = 0;
-
-        for (std::size_t i = 0; i < s.size(); ++i)
+        static const std::array<std::uint8_t, 400> utf8d =
         {
-            const auto byte = static_cast<std::uint8_t>(s[i]);
-
-            switch (decode(state, codepoint, byte))
             {
-                case UTF8_ACCEPT:  // decode found a new code point
-                {
-                    switch (codepoint)
-                    {
-                        case 0x08: // backspace
-                        {
-                            string_buffer[bytes++] = '\\';
-                            string_buffer[bytes++] = 'b';
-                            break;
-                        }
+                0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, // 00..1F
+                0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, // 20..3F
+                0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, // 40..5F
+                0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, // 60..7F
+                1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, // 80..9F
+                7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, // A0..BF
+                8, 8, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, // C0..DF
+                0xA, 0x3, 0x3, 0x3, 0x3, 0x3, 0x3, 0x3, 0x3, 0x3, 0x3, 0x3, 0x3, 0x4, 0x3, 0x3, // E0..EF
+                0xB, 0x6, 0x6, 0x6, 0x5, 0x8, 0x8, 0x8, 0x8, 0x8, 0x8, 0x8, 0x8, 0x8, 0x8, 0x8, // F0..FF
+                0x0, 0x1, 0x2, 0x3, 0x5, 0x8, 0x7, 0x1, 0x1, 0x1, 0x4, 0x6, 0x1, 0x1, 0x1, 0x1, // s0..s0
+                1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 1, 1, 1, 1, 1, 0, 1, 0, 1, 1, 1, 1, 1, 1, // s1..s2
+                1, 2, 1, 1, 1, 1, 1, 2, 1, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 1, // s3..s4
+                1, 2, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 3, 1, 3, 1, 1, 1, 1, 1, 1, // s5..s6
+                1, 3, 1, 1, 1, 1, 1, 3, 1, 3, 1, 1, 1, 1, 1, 1, 1, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 // s7..s8
+            }
+        };
 
-                        case 0x09: // horizontal tab
-                        {
-                            string_buffer[bytes++] = '\\';
-                            string_buffer[bytes++] = 't';
-                            break;
-                        }
+        JSON_ASSERT(byte < utf8d.size());
+        const std::uint8_t type = utf8d[byte];
 
-                        case 0x0A: // newline
-                        {
-                            string_buffer[bytes++] = '\\';
-                            string_buffer[bytes++] = 'n';
-                            break;
-                        }
+        codep = (state != UTF8_ACCEPT)
+                ? (byte & 0x3fu) | (codep << 6u)
+                : (0xFFu >> type) & (byte);
 
-                        case 0x0C: // formfeed
-                        {
-                            string_buffer[bytes++] = '\\';
-                            string_buffer[bytes++] = 'f';
-                            break;
-                        }
+        const std::size_t index = 256u + static_cast<size_t>(state) * 16u + static_cast<size_t>(type);
+        JSON_ASSERT(index < utf8d.size());
+        state = utf8d[index];
+        return state;
+    }
 
-                        case 0x0D: // carriage return
-                        {
-                            string_buffer[bytes++] = '\\';
-                            string_buffer[bytes++] = 'r';
-                            break;
-                        }
+    /*
+     * Overload to make the compiler happy while it is instantiating
+     * dump_integer for number_unsigned_t.
+     * Must never be called.
+     */
+    number_unsigned_t remove_sign(number_unsigned_t x)
+    {
+        JSON_ASSERT(false); // NOLINT(cert-dcl03-c,hicpp-static-assert,misc-static-assert) LCOV_EXCL_LINE
+        return x; // LCOV_EXCL_LINE
+    }
 
-                        case 0x22: // quotation mark
-                        {
-                            string_buffer[bytes++] = '\\';
-                            string_buffer[bytes++] = '\"';
-                            break;
-                        }
+    /*
+     * Helper function for dump_integer
+     *
+     * This function takes a negative signed integer and returns its absolute
+     * value as unsigned integer. The plus/minus shuffling is necessary as we can
+     * not directly remove the sign of an arbitrary signed integer as the
+     * absolute values of INT_MIN and INT_MAX are usually not the same. See
+     * #1708 for details.
+     */
+    inline number_unsigned_t remove_sign(number_integer_t x) noexcept
+    {
+        JSON_ASSERT(x < 0 && x < (std::numeric_limits<number_integer_t>::max)()); // NOLINT(misc-redundant-expression)
+        return static_cast<number_unsigned_t>(-(x + 1)) + 1;
+    }
 
-                        case 0x5C: // reverse solidus
-                        {
-                            string_buffer[bytes++] = '\\';
-                            string_buffer[bytes++] = '\\';
-                            break;
-                        }
+  private:
+    /// the output of the serializer
+    output_adapter_t<char> o = nullptr;
 
-                        default:
-                        {
-                            // escape control characters (0x00..0x1F) or, if
-                            // ensure_ascii parameter is used, non-ASCII characters
-                            if ((codepoint <= 0x1F) || (ensure_ascii && (codepoint >= 0x7F)))
-                            {
-                                if (codepoint <= 0xFFFF)
-                                {
-                                    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg,hicpp-vararg)
-                                    static_cast<void>((std::snprintf)(string_buffer.data() + bytes, 7, "\\u%04x",
-                                                                      static_cast<std::uint16_t>(codepoint)));
-                                    bytes += 6;
-                                }
-                                else
-                                {
-                                    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg,hicpp-vararg)
-                                    static_cast<void>((std::snprintf)(string_buffer.data() + bytes, 13, "\\u%04x\\u%04x",
-                                                                      static_cast<std::uint16_t>(0xD7C0u + (codepoint >> 10u)),
-                                                                      static_cast<std::uint16_t>(0xDC00u + (codepoint & 0x3FFu))));
-                                    bytes += 12;
-                                }
-                            }
-                            else
-                            {
-                                // copy byte to buffer (all previous bytes
-                                // been copied have in default case above)
-                                string_buffer[bytes++] = s[i];
-                            }
-                            break;
-                        }
-                    }
+    /// a (hopefully) large enough character buffer
+    std::array<char, 64> number_buffer{{}};
 
-                    // write buffer and reset index; there must be 13 bytes
-                    // left, as this is the maximal number of bytes to be
-                    // written ("\uxxxx\uxxxx\0") for one code point
-                    if (string_buffer.size() - bytes < 13)
-                    {
-                        o->write_characters(string_buffer.data(), bytes);
-                        bytes = 0;
-                    }
+    /// the locale
+    const std::lconv* loc = nullptr;
+    /// the locale's thousand separator character
+    const char thousands_sep = '\0';
+    /// the locale's decimal point character
+    const char decimal_point = '\0';
 
-                    // remember the byte position of this accept
-                    bytes_after_last_accept = bytes;
-                    undumped_chars = 0;
-                    break;
-                }
+    /// string buffer
+    std::array<char, 512> string_buffer{{}};
 
-                case UTF8_REJECT:  // decode found invalid UTF-8 byte
-                {
-                    switch (error_handler)
-                    {
-                        case error_handler_t::strict:
-                        {
-                            JSON_THROW(type_error::create(316, concat("invalid UTF-8 byte at index ", std::to_string(i), ": 0x", hex_bytes(byte | 0)), nullptr));
-                        }
+    /// the indentation character
+    const char indent_char;
+    /// the indentation string
+    string_t indent_string;
 
-                        case error_handler_t::ignore:
-                        case error_handler_t::replace:
-                        {
-                            // in case we saw this character the first time, we
-                            // would like to read it again, because the byte
-                            // may be OK for itself, but just not OK for the
-                            // previous sequence
-                            if (undumped_chars > 0)
-                            {
-                                --i;
-                            }
+    /// error_handler how to react on decoding errors
+    const error_handler_t error_handler;
 
-                            // reset length buffer to the last accepted index;
-                            // thus removing/ignoring the invalid characters
-                            bytes = bytes_after_last_accept;
+    /// whether floats which are exact in single precision are printed as such
+    bool float32_output = false;
+};
 
-                            if (error_handler == error_handler_t::replace)
-                            {
-                                // add a replacement character
-                                if (ensure_ascii)
-                                {
-                                    string_buffer[bytes++] = '\\';
-                                    string_buffer[bytes++] = 'u';
-                                    string_buffer[bytes++] = 'f';
-                                    string_buffer[bytes++] = 'f';
-                                    string_buffer[bytes++] = 'f';
-                                    string_buffer[bytes++] = 'd';
-                                }
-                                else
-                                {
-                                    string_buffer[bytes++] = detail::binary_writer<BasicJsonType, char>::to_char_type('\xEF');
-                                    string_buffer[bytes++] = detail::binary_writer<BasicJsonType, char>::to_char_type('\xBF');
-                                    string_buffer[bytes++] = detail::binary_writer<BasicJsonType, char>::to_char_type('\xBD');
-                                }
+}  // namespace detail
+NLOHMANN_JSON_NAMESPACE_END
 
-                                // write buffer and reset index; there must be 13 bytes
-                                // left, as this is the maximal number of bytes to be
-                                // written ("\uxxxx\uxxxx\0") for one code point
-                                if (string_buffer.size() - bytes < 13)
-                                {
-                                    o->write_characters(string_buffer.data(), bytes);
-                                    bytes = 0;
-                                }
+// #include <nlohmann/detail/value_t.hpp>
 
-                                bytes_after_last_accept = bytes;
-                            }
+// #include <nlohmann/json_fwd.hpp>
 
-                            undumped_chars = 0;
+// #include <nlohmann/ordered_map.hpp>
+//     __ _____ _____ _____
+//  __|  |   __|     |   | |  JSON for Modern C++
+// |  |  |__   |  |  | | | |  version 3.11.3
+// |_____|_____|_____|_|___|  https://github.com/nlohmann/json
+//
+// SPDX-FileCopyrightText: 2013-2023 Niels Lohmann <https://nlohmann.me>
+// SPDX-License-Identifier: MIT
 
-                            // continue processing the string
-                            state = UTF8_ACCEPT;
-                            break;
-                        }
 
-                        default:            // LCOV_EXCL_LINE
-                            JSON_ASSERT(false); // NOLINT(cert-dcl03-c,hicpp-static-assert,misc-static-assert) LCOV_EXCL_LINE
-                    }
-                    break;
-                }
 
-                default:  // decode found yet incomplete multi-byte code point
-                {
-                    if (!ensure_ascii)
-                    {
-                        // code point will not be escaped - copy byte to buffer
-                        string_buffer[bytes++] = s[i];
-                    }
-                    ++undumped_chars;
-                    break;
-                }
-            }
-        }
+#include <functional> // equal_to, less
+#include <initializer_list> // initializer_list
+#include <iterator> // input_iterator_tag, iterator_traits
+#include <memory> // allocator
+#include <stdexcept> // for out_of_range
+#include <type_traits> // enable_if, is_convertible
+#include <utility> // pair
+#include <vector> // vector
 
-        // we finished processing the string
-        if (JSON_HEDLEY_LIKELY(state == UTF8_ACCEPT))
-        {
-            // write buffer
-            if (bytes > 0)
-            {
-                o->write_characters(string_buffer.data(), bytes);
-            }
-        }
-        else
-        {
-            // we finish reading, but do not accept: string was incomplete
-            switch (error_handler)
-            {
-                case error_handler_t::strict:
-                {
-                    JSON_THROW(type_error::create(316, concat("incomplete UTF-8 string; last byte: 0x", hex_bytes(static_cast<std::uint8_t>(s.back() | 0))), nullptr));
-                }
+// #include <nlohmann/detail/macro_scope.hpp>
 
-                case error_handler_t::ignore:
-                {
-                    // write all accepted bytes
-                    o->write_characters(string_buffer.data(), bytes_after_last_accept);
-                    break;
-                }
+// #include <nlohmann/detail/meta/type_traits.hpp>
 
-                case error_handler_t::replace:
-                {
-                    // write all accepted bytes
-                    o->write_characters(string_buffer.data(), bytes_after_last_accept);
-                    // add a replacement character
-                    if (ensure_ascii)
-                    {
-                        o->write_characters("\\ufffd", 6);
-                    }
-                    else
-                    {
-                        o->write_characters("\xEF\xBF\xBD", 3);
-                    }
-                    break;
-                }
 
-                default:            // LCOV_EXCL_LINE
-                    JSON_ASSERT(false); // NOLINT(cert-dcl03-c,hicpp-static-assert,misc-static-assert) LCOV_EXCL_LINE
-            }
-        }
-    }
+NLOHMANN_JSON_NAMESPACE_BEGIN
 
-  private:
-    /*!
-    @brief count digits
+/// ordered_map: a minimal map-like container that preserves insertion order
+/// for use within nlohmann::basic_json<ordered_map>
+template <class Key, class T, class IgnoredLess = std::less<Key>,
+          class Allocator = std::allocator<std::pair<const Key, T>>>
+                  struct ordered_map : std::vector<std::pair<const Key, T>, Allocator>
+{
+    using key_type = Key;
+    using mapped_type = T;
+    using Container = std::vector<std::pair<const Key, T>, Allocator>;
+    using iterator = typename Container::iterator;
+    using const_iterator = typename Container::const_iterator;
+    using size_type = typename Container::size_type;
+    using value_type = typename Container::value_type;
+#ifdef JSON_HAS_CPP_14
+    using key_compare = std::equal_to<>;
+#else
+    using key_compare = std::equal_to<Key>;
+#endif
 
-    Count the number of decimal (base 10) digits for an input unsigned integer.
+    // Explicit constructors instead of `using Container::Container`
+    // otherwise older compilers choke on it (GCC <= 5.5, xcode <= 9.4)
+    ordered_map() noexcept(noexcept(Container())) : Container{} {}
+    explicit ordered_map(const Allocator& alloc) noexcept(noexcept(Container(alloc))) : Container{alloc} {}
+    template <class It>
+    ordered_map(It first, It last, const Allocator& alloc = Allocator())
+        : Container{first, last, alloc} {}
+    ordered_map(std::initializer_list<value_type> init, const Allocator& alloc = Allocator() )
+        : Container{init, alloc} {}
 
-    @param[in] x  unsigned integer number to count its digits
-    @return    number of decimal digits
-    */
-    inline unsigned int count_digits(number_unsigned_t x) noexcept
+    std::pair<iterator, bool> emplace(const key_type& key, T&& t)
     {
-        unsigned int n_digits = 1;
-        for (;;)
+        for (auto it = this->begin(); it != this->end(); ++it)
         {
-            if (x < 10)
-            {
-                return n_digits;
-            }
-            if (x < 100)
-            {
-                return n_digits + 1;
-            }
-            if (x < 1000)
+            if (m_compare(it->first, key))
             {
-                return n_digits + 2;
+                return {it, false};
             }
-            if (x < 10000)
+        }
+        Container::emplace_back(key, std::forward<T>(t));
+        return {std::prev(this->end()), true};
+    }
+
+    template<class KeyType, detail::enable_if_t<
+                 detail::is_usable_as_key_type<key_compare, key_type, KeyType>::value, int> = 0>
+    std::pair<iterator, bool> emplace(KeyType && key, T && t)
+    {
+        for (auto it = this->begin(); it != this->end(); ++it)
+        {
+            if (m_compare(it->first, key))
             {
-                return n_digits + 3;
+                return {it, false};
             }
-            x = x / 10000u;
-            n_digits += 4;
         }
+        Container::emplace_back(std::forward<KeyType>(key), std::forward<T>(t));
+        return {std::prev(this->end()), true};
     }
 
-    /*!
-     * @brief convert a byte to a uppercase hex representation
-     * @param[in] byte byte to represent
-     * @return representation ("00".."FF")
-     */
-    static std::string hex_bytes(std::uint8_t byte)
+    T& operator[](const key_type& key)
     {
-        std::string result = "FF";
-        constexpr const char* nibble_to_hex = "0123456789ABCDEF";
-        result[0] = nibble_to_hex[byte / 16];
-        result[1] = nibble_to_hex[byte % 16];
-        return result;
+        return emplace(key, T{}).first->second;
     }
 
-    // templates to avoid warnings about useless casts
-    template <typename NumberType, enable_if_t<std::is_signed<NumberType>::value, int> = 0>
-    bool is_negative_number(NumberType x)
+    template<class KeyType, detail::enable_if_t<
+                 detail::is_usable_as_key_type<key_compare, key_type, KeyType>::value, int> = 0>
+    T & operator[](KeyType && key)
     {
-        return x < 0;
+        return emplace(std::forward<KeyType>(key), T{}).first->second;
     }
 
-    template < typename NumberType, enable_if_t <std::is_unsigned<NumberType>::value, int > = 0 >
-    bool is_negative_number(NumberType /*unused*/)
+    const T& operator[](const key_type& key) const
     {
-        return false;
+        return at(key);
     }
 
-    /*!
-    @brief dump an integer
-
-    Dump a given integer to output stream @a o. Works internally with
-    @a number_buffer.
+    template<class KeyType, detail::enable_if_t<
+                 detail::is_usable_as_key_type<key_compare, key_type, KeyType>::value, int> = 0>
+    const T & operator[](KeyType && key) const
+    {
+        return at(std::forward<KeyType>(key));
+    }
 
-    @param[in] x  integer number (signed or unsigned) to dump
-    @tparam NumberType either @a number_integer_t or @a number_unsigned_t
-    */
-    template < typename NumberType, detail::enable_if_t <
-                   std::is_integral<NumberType>::value ||
-                   std::is_same<NumberType, number_unsigned_t>::value ||
-                   std::is_same<NumberType, number_integer_t>::value ||
-                   std::is_same<NumberType, binary_char_t>::value,
-                   int > = 0 >
-    void dump_integer(NumberType x)
+    T& at(const key_type& key)
     {
-        static constexpr std::array<std::array<char, 2>, 100> digits_to_99
+        for (auto it = this->begin(); it != this->end(); ++it)
         {
+            if (m_compare(it->first, key))
             {
-                {{'0', '0'}}, {{'0', '1'}}, {{'0', '2'}}, {{'0', '3'}}, {{'0', '4'}}, {{'0', '5'}}, {{'0', '6'}}, {{'0', '7'}}, {{'0', '8'}}, {{'0', '9'}},
-                {{'1', '0'}}, {{'1', '1'}}, {{'1', '2'}}, {{'1', '3'}}, {{'1', '4'}}, {{'1', '5'}}, {{'1', '6'}}, {{'1', '7'}}, {{'1', '8'}}, {{'1', '9'}},
-                {{'2', '0'}}, {{'2', '1'}}, {{'2', '2'}}, {{'2', '3'}}, {{'2', '4'}}, {{'2', '5'}}, {{'2', '6'}}, {{'2', '7'}}, {{'2', '8'}}, {{'2', '9'}},
-                {{'3', '0'}}, {{'3', '1'}}, {{'3', '2'}}, {{'3', '3'}}, {{'3', '4'}}, {{'3', '5'}}, {{'3', '6'}}, {{'3', '7'}}, {{'3', '8'}}, {{'3', '9'}},
-                {{'4', '0'}}, {{'4', '1'}}, {{'4', '2'}}, {{'4', '3'}}, {{'4', '4'}}, {{'4', '5'}}, {{'4', '6'}}, {{'4', '7'}}, {{'4', '8'}}, {{'4', '9'}},
-                {{'5', '0'}}, {{'5', '1'}}, {{'5', '2'}}, {{'5', '3'}}, {{'5', '4'}}, {{'5', '5'}}, {{'5', '6'}}, {{'5', '7'}}, {{'5', '8'}}, {{'5', '9'}},
-                {{'6', '0'}}, {{'6', '1'}}, {{'6', '2'}}, {{'6', '3'}}, {{'6', '4'}}, {{'6', '5'}}, {{'6', '6'}}, {{'6', '7'}}, {{'6', '8'}}, {{'6', '9'}},
-                {{'7', '0'}}, {{'7', '1'}}, {{'7', '2'}}, {{'7', '3'}}, {{'7', '4'}}, {{'7', '5'}}, {{'7', '6'}}, {{'7', '7'}}, {{'7', '8'}}, {{'7', '9'}},
-                {{'8', '0'}}, {{'8', '1'}}, {{'8', '2'}}, {{'8', '3'}}, {{'8', '4'}}, {{'8', '5'}}, {{'8', '6'}}, {{'8', '7'}}, {{'8', '8'}}, {{'8', '9'}},
-                {{'9', '0'}}, {{'9', '1'}}, {{'9', '2'}}, {{'9', '3'}}, {{'9', '4'}}, {{'9', '5'}}, {{'9', '6'}}, {{'9', '7'}}, {{'9', '8'}}, {{'9', '9'}},
+                return it->second;
             }
-        };
-
-        // special case for "0"
-        if (x == 0)
-        {
-            o->write_character('0');
-            return;
         }
 
-        // use a pointer to fill the buffer
-        auto buffer_ptr = number_buffer.begin(); // NOLINT(llvm-qualified-auto,readability-qualified-auto,cppcoreguidelines-pro-type-vararg,hicpp-vararg)
+        JSON_THROW(std::out_of_range("key not found"));
+    }
 
-        number_unsigned_t abs_value;
+    template<class KeyType, detail::enable_if_t<
+                 detail::is_usable_as_key_type<key_compare, key_type, KeyType>::value, int> = 0>
+    T & at(KeyType && key) // NOLINT(cppcoreguidelines-missing-std-forward)
+    {
+        for (auto it = this->begin(); it != this->end(); ++it)
+        {
+            if (m_compare(it->first, key))
+            {
+                return it->second;
+            }
+        }
 
-        unsigned int n_chars{};
+        JSON_THROW(std::out_of_range("key not found"));
+    }
 
-        if (is_negative_number(x))
+    const T& at(const key_type& key) const
+    {
+        for (auto it = this->begin(); it != this->end(); ++it)
         {
-            *buffer_ptr = '-';
-            abs_value = remove_sign(static_cast<number_integer_t>(x));
-
-            // account one more byte for the minus sign
-            n_chars = 1 + count_digits(abs_value);
+            if (m_compare(it->first, key))
+            {
+                return it->second;
+            }
         }
-        else
+
+        JSON_THROW(std::out_of_range("key not found"));
+    }
+
+    template<class KeyType, detail::enable_if_t<
+                 detail::is_usable_as_key_type<key_compare, key_type, KeyType>::value, int> = 0>
+    const T & at(KeyType && key) const // NOLINT(cppcoreguidelines-missing-std-forward)
+    {
+        for (auto it = this->begin(); it != this->end(); ++it)
         {
-            abs_value = static_cast<number_unsigned_t>(x);
-            n_chars = count_digits(abs_value);
+            if (m_compare(it->first, key))
+            {
+                return it->second;
+            }
         }
 
-        // spare 1 byte for '\0'
-        JSON_ASSERT(n_chars < number_buffer.size() - 1);
-
-        // jump to the end to generate the string from backward,
-        // so we later avoid reversing the result
-        buffer_ptr += n_chars;
+        JSON_THROW(std::out_of_range("key not found"));
+    }
 
-        // Fast int2ascii implementation inspired by "Fastware" talk by Andrei Alexandrescu
-        // See: https://www.youtube.com/watch?v=o4-CwDo2zpg
-        while (abs_value >= 100)
+    size_type erase(const key_type& key)
+    {
+        for (auto it = this->begin(); it != this->end(); ++it)
         {
-            const auto digits_index = static_cast<unsigned>((abs_value % 100));
-            abs_value /= 100;
-            *(--buffer_ptr) = digits_to_99[digits_index][1];
-            *(--buffer_ptr) = digits_to_99[digits_index][0];
+            if (m_compare(it->first, key))
+            {
+                // Since we cannot move const Keys, re-construct them in place
+                for (auto next = it; ++next != this->end(); ++it)
+                {
+                    it->~value_type(); // Destroy but keep allocation
+                    new (&*it) value_type{std::move(*next)};
+                }
+                Container::pop_back();
+                return 1;
+            }
         }
+        return 0;
+    }
 
-        if (abs_value >= 10)
+    template<class KeyType, detail::enable_if_t<
+                 detail::is_usable_as_key_type<key_compare, key_type, KeyType>::value, int> = 0>
+    size_type erase(KeyType && key) // NOLINT(cppcoreguidelines-missing-std-forward)
+    {
+        for (auto it = this->begin(); it != this->end(); ++it)
         {
-            const auto digits_index = static_cast<unsigned>(abs_value);
-            *(--buffer_ptr) = digits_to_99[digits_index][1];
-            *(--buffer_ptr) = digits_to_99[digits_index][0];
+            if (m_compare(it->first, key))
+            {
+                // Since we cannot move const Keys, re-construct them in place
+                for (auto next = it; ++next != this->end(); ++it)
+                {
+                    it->~value_type(); // Destroy but keep allocation
+                    new (&*it) value_type{std::move(*next)};
+                }
+                Container::pop_back();
+                return 1;
+            }
         }
-        else
+        return 0;
+    }
+
+    iterator erase(iterator pos)
+    {
+        return erase(pos, std::next(pos));
+    }
+
+    iterator erase(iterator first, iterator last)
+    {
+        if (first == last)
         {
-            *(--buffer_ptr) = static_cast<char>('0' + abs_value);
+            return first;
         }
 
-        o->write_characters(number_buffer.data(), n_chars);
-    }
+        const auto elements_affected = std::distance(first, last);
+        const auto offset = std::distance(Container::begin(), first);
 
-    /*!
-    @brief dump a floating-point number
+        // This is the start situation. We need to delete elements_affected
+        // elements (3 in this example: e, f, g), and need to return an
+        // iterator past the last deleted element (h in this example).
+        // Note that offset is the distance from the start of the vector
+        // to first. We will need this later.
 
-    Dump a given floating-point number to output stream @a o. Works internally
-    with @a number_buffer.
+        // [ a, b, c, d, e, f, g, h, i, j ]
+        //               ^        ^
+        //             first    last
 
-    @param[in] x  floating-point number to dump
-    */
-    void dump_float(number_float_t x)
-    {
-        // NaN / inf
-        if (!std::isfinite(x))
+        // Since we cannot move const Keys, we re-construct them in place.
+        // We start at first and re-construct (viz. copy) the elements from
+        // the back of the vector. Example for first iteration:
+
+        //               ,--------.
+        //               v        |   destroy e and re-construct with h
+        // [ a, b, c, d, e, f, g, h, i, j ]
+        //               ^        ^
+        //               it       it + elements_affected
+
+        for (auto it = first; std::next(it, elements_affected) != Container::end(); ++it)
         {
-            o->write_characters("null", 4);
-            return;
+            it->~value_type(); // destroy but keep allocation
+            new (&*it) value_type{std::move(*std::next(it, elements_affected))}; // "move" next element to it
         }
 
-        // If number_float_t is an IEEE-754 single or double precision number,
-        // use the Grisu2 algorithm to produce short numbers which are
-        // guaranteed to round-trip, using strtof and strtod, resp.
-        //
-        // NB: The test below works if <long double> == <double>.
-        static constexpr bool is_ieee_single_or_double
-            = (std::numeric_limits<number_float_t>::is_iec559 && std::numeric_limits<number_float_t>::digits == 24 && std::numeric_limits<number_float_t>::max_exponent == 128) ||
-              (std::numeric_limits<number_float_t>::is_iec559 && std::numeric_limits<number_float_t>::digits == 53 && std::numeric_limits<number_float_t>::max_exponent == 1024);
+        // [ a, b, c, d, h, i, j, h, i, j ]
+        //               ^        ^
+        //             first    last
 
-        dump_float(x, std::integral_constant<bool, is_ieee_single_or_double>());
-    }
+        // remove the unneeded elements at the end of the vector
+        Container::resize(this->size() - static_cast<size_type>(elements_affected));
 
-    void dump_float(number_float_t x, std::true_type /*is_ieee_single_or_double*/)
-    {
-        auto* begin = number_buffer.data();
-        auto* end = ::nlohmann::detail::to_chars(begin, begin + number_buffer.size(), x);
+        // [ a, b, c, d, h, i, j ]
+        //               ^        ^
+        //             first    last
 
-        o->write_characters(begin, static_cast<size_t>(end - begin));
+        // first is now pointing past the last deleted element, but we cannot
+        // use this iterator, because it may have been invalidated by the
+        // resize call. Instead, we can return begin() + offset.
+        return Container::begin() + offset;
     }
 
-    void dump_float(number_float_t x, std::false_type /*is_ieee_single_or_double*/)
+    size_type count(const key_type& key) const
     {
-        // get number of digits for a float -> text -> float round-trip
-        static constexpr auto d = std::numeric_limits<number_float_t>::max_digits10;
-
-        // the actual conversion
-        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg,hicpp-vararg)
-        std::ptrdiff_t len = (std::snprintf)(number_buffer.data(), number_buffer.size(), "%.*g", d, x);
-
-        // negative value indicates an error
-        JSON_ASSERT(len > 0);
-        // check if buffer was large enough
-        JSON_ASSERT(static_cast<std::size_t>(len) < number_buffer.size());
-
-        // erase thousands separator
-        if (thousands_sep != '\0')
+        for (auto it = this->begin(); it != this->end(); ++it)
         {
-            // NOLINTNEXTLINE(readability-qualified-auto,llvm-qualified-auto): std::remove returns an iterator, see https://github.com/nlohmann/json/issues/3081
-            const auto end = std::remove(number_buffer.begin(), number_buffer.begin() + len, thousands_sep);
-            std::fill(end, number_buffer.end(), '\0');
-            JSON_ASSERT((end - number_buffer.begin()) <= len);
-            len = (end - number_buffer.begin());
+            if (m_compare(it->first, key))
+            {
+                return 1;
+            }
         }
+        return 0;
+    }
 
-        // convert decimal point to '.'
-        if (decimal_point != '\0' && decimal_point != '.')
+    template<class KeyType, detail::enable_if_t<
+                 detail::is_usable_as_key_type<key_compare, key_type, KeyType>::value, int> = 0>
+    size_type count(KeyType && key) const // NOLINT(cppcoreguidelines-missing-std-forward)
+    {
+        for (auto it = this->begin(); it != this->end(); ++it)
         {
-            // NOLINTNEXTLINE(readability-qualified-auto,llvm-qualified-auto): std::find returns an iterator, see https://github.com/nlohmann/json/issues/3081
-            const auto dec_pos = std::find(number_buffer.begin(), number_buffer.end(), decimal_point);
-            if (dec_pos != number_buffer.end())
+            if (m_compare(it->first, key))
             {
-                *dec_pos = '.';
+                return 1;
             }
         }
+        return 0;
+    }
 
-        o->write_characters(number_buffer.data(), static_cast<std::size_t>(len));
-
-        // determine if we need to append ".0"
-        const bool value_is_int_like =
-            std::none_of(number_buffer.begin(), number_buffer.begin() + len + 1,
-                         [](char c)
+    iterator find(const key_type& key)
+    {
+        for (auto it = this->begin(); it != this->end(); ++it)
         {
-            return c == '.' || c == 'e';
-        });
+            if (m_compare(it->first, key))
+            {
+                return it;
+            }
+        }
+        return Container::end();
+    }
 
-        if (value_is_int_like)
+    template<class KeyType, detail::enable_if_t<
+                 detail::is_usable_as_key_type<key_compare, key_type, KeyType>::value, int> = 0>
+    iterator find(KeyType && key) // NOLINT(cppcoreguidelines-missing-std-forward)
+    {
+        for (auto it = this->begin(); it != this->end(); ++it)
         {
-            o->write_characters(".0", 2);
+            if (m_compare(it->first, key))
+            {
+                return it;
+            }
         }
+        return Container::end();
     }
 
-    /*!
-    @brief check whether a string is UTF-8 encoded
-
-    The function checks each byte of a string whether it is UTF-8 encoded. The
-    result of the check is stored in the @a state parameter. The function must
-    be called initially with state 0 (accept). State 1 means the string must
-    be rejected, because the current byte is not allowed. If the string is
-    completely processed, but the state is non-zero, the string ended
-    prematurely; that is, the last byte indicated more bytes should have
-    followed.
-
-    @param[in,out] state  the state of the decoding
-    @param[in,out] codep  codepoint (valid only if resulting state is UTF8_ACCEPT)
-    @param[in] byte       next byte to decode
-    @return               new state
-
-    @note The function has been edited: a std::array is used.
-
-    @copyright Copyright (c) 2008-2009 Bjoern Hoehrmann <bjoern@hoehrmann.de>
-    @sa http://bjoern.hoehrmann.de/utf-8/decoder/dfa/
-    */
-    static std::uint8_t decode(std::uint8_t& state, std::uint32_t& codep, const std::uint8_t byte) noexcept
+    const_iterator find(const key_type& key) const
     {
-        static const std::array<std::uint8_t, 400> utf8d =
+        for (auto it = this->begin(); it != this->end(); ++it)
         {
+            if (m_compare(it->first, key))
             {
-                0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, // 00..1F
-                0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, // 20..3F
-                0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, // 40..5F
-                0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, // 60..7F
-                1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, // 80..9F
-                7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, // A0..BF
-                8, 8, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, // C0..DF
-                0xA, 0x3, 0x3, 0x3, 0x3, 0x3, 0x3, 0x3, 0x3, 0x3, 0x3, 0x3, 0x3, 0x4, 0x3, 0x3, // E0..EF
-                0xB, 0x6, 0x6, 0x6, 0x5, 0x8, 0x8, 0x8, 0x8, 0x8, 0x8, 0x8, 0x8, 0x8, 0x8, 0x8, // F0..FF
-                0x0, 0x1, 0x2, 0x3, 0x5, 0x8, 0x7, 0x1, 0x1, 0x1, 0x4, 0x6, 0x1, 0x1, 0x1, 0x1, // s0..s0
-                1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 1, 1, 1, 1, 1, 0, 1, 0, 1, 1, 1, 1, 1, 1, // s1..s2
-                1, 2, 1, 1, 1, 1, 1, 2, 1, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 1, // s3..s4
-                1, 2, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 3, 1, 3, 1, 1, 1, 1, 1, 1, // s5..s6
-                1, 3, 1, 1, 1, 1, 1, 3, 1, 3, 1, 1, 1, 1, 1, 1, 1, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 // s7..s8
+                return it;
             }
-        };
-
-        JSON_ASSERT(byte < utf8d.size());
-        const std::uint8_t type = utf8d[byte];
-
-        codep = (state != UTF8_ACCEPT)
-                ? (byte & 0x3fu) | (codep << 6u)
-                : (0xFFu >> type) & (byte);
-
-        const std::size_t index = 256u + static_cast<size_t>(state) * 16u + static_cast<size_t>(type);
-        JSON_ASSERT(index < utf8d.size());
-        state = utf8d[index];
-        return state;
+        }
+        return Container::end();
     }
 
-    /*
-     * Overload to make the compiler happy while it is instantiating
-     * dump_integer for number_unsigned_t.
-     * Must never be called.
-     */
-    number_unsigned_t remove_sign(number_unsigned_t x)
+    std::pair<iterator, bool> insert( value_type&& value )
     {
-        JSON_ASSERT(false); // NOLINT(cert-dcl03-c,hicpp-static-assert,misc-static-assert) LCOV_EXCL_LINE
-        return x; // LCOV_EXCL_LINE
+        return emplace(value.first, std::move(value.second));
     }
 
-    /*
-     * Helper function for dump_integer
-     *
-     * This function takes a negative signed integer and returns its absolute
-     * value as unsigned integer. The plus/minus shuffling is necessary as we can
-     * not directly remove the sign of an arbitrary signed integer as the
-     * absolute values of INT_MIN and INT_MAX are usually not the same. See
-     * #1708 for details.
-     */
-    inline number_unsigned_t remove_sign(number_integer_t x) noexcept
+    std::pair<iterator, bool> insert( const value_type& value )
     {
-        JSON_ASSERT(x < 0 && x < (std::numeric_limits<number_integer_t>::max)()); // NOLINT(misc-redundant-expression)
-        return static_cast<number_unsigned_t>(-(x + 1)) + 1;
+        for (auto it = this->begin(); it != this->end(); ++it)
+        {
+            if (m_compare(it->first, value.first))
+            {
+                return {it, false};
+            }
+        }
+        Container::push_back(value);
+        return {--this->end(), true};
     }
 
-  private:
-    /// the output of the serializer
-    output_adapter_t<char> o = nullptr;
-
-    /// a (hopefully) large enough character buffer
-    std::array<char, 64> number_buffer{{}};
-
-    /// the locale
-    const std::lconv* loc = nullptr;
-    /// the locale's thousand separator character
-    const char thousands_sep = '\0';
-    /// the locale's decimal point character
-    const char decimal_point = '\0';
-
-    /// string buffer
-    std::array<char, 512> string_buffer{{}};
+    template<typename InputIt>
+    using require_input_iter = typename std::enable_if<std::is_convertible<typename std::iterator_traits<InputIt>::iterator_category,
+            std::input_iterator_tag>::value>::type;
 
-    /// the indentation character
-    const char indent_char;
-    /// the indentation string
-    string_t indent_string;
+    template<typename InputIt, typename = require_input_iter<InputIt>>
+    void insert(InputIt first, InputIt last)
+    {
+        for (auto it = first; it != last; ++it)
+        {
+            insert(*it);
+        }
+    }
 
-    /// error_handler how to react on decoding errors
-    const error_handler_t error_handler;
+private:
+    JSON_NO_UNIQUE_ADDRESS key_compare m_compare = key_compare();
 };
 
-}  // namespace detail
-NLOHMANN_JSON_NAMESPACE_END
-
-// #include <nlohmann/detail/value_t.hpp>
-
-// #include <nlohmann/json_fwd.hpp>
-
-// #include <nlohmann/ordered_map.hpp>
-//     __ _____ _____ _____
-//  __|  |   __|     |   | |  JSON for Modern C++
-// |  |  |__   |  |  | | | |  version 3.11.3
-// |_____|_____|_____|_|___|  https://github.com/nlohmann/json
-//
-// SPDX-FileCopyrightText: 2013-2023 Niels Lohmann <https://nlohmann.me>
-// SPDX-License-Identifier: MIT
-
-
-
-#include <functional> // equal_to, less
-#include <initializer_list> // initializer_list
-#include <iterator> // input_iterator_tag, iterator_traits
-#include <memory> // allocator
-#include <stdexcept> // for out_of_range
-#include <type_traits> // enable_if, is_convertible
-#include <utility> // pair
-#include <vector> // vector
-
-// #include <nlohmann/detail/macro_scope.hpp>
-
-// #include <nlohmann/detail/meta/type_traits.hpp>
-
-
-NLOHMANN_JSON_NAMESPACE_BEGIN
-
-/// ordered_map: a minimal map-like container that preserves insertion order
-/// for use within nlohmann::basic_json<ordered_map>
+/// indexed_ordered_map: ordered_map with a hash index for large objects
+/// keeps the elements in insertion order like ordered_map, and once there are
+/// index_threshold elements it maintains an open-addressing table of their
+/// positions, so that lookups and insertions do not scan the whole vector
 template <class Key, class T, class IgnoredLess = std::less<Key>,
           class Allocator = std::allocator<std::pair<const Key, T>>>
-                  struct ordered_map : std::vector<std::pair<const Key, T>, Allocator>
-{
-    using key_type = Key;
-    using mapped_type = T;
-    using Container = std::vector<std::pair<const Key, T>, Allocator>;
-    using iterator = typename Container::iterator;
-    using const_iterator = typename Container::const_iterator;
-    using size_type = typename Container::size_type;
-    using value_type = typename Container::value_type;
-#ifdef JSON_HAS_CPP_14
-    using key_compare = std::equal_to<>;
-#else
-    using key_compare = std::equal_to<Key>;
-#endif
-
-    // Explicit constructors instead of `using Container::Container`
-    // otherwise older compilers choke on it (GCC <= 5.5, xcode <= 9.4)
-    ordered_map() noexcept(noexcept(Container())) : Container{} {}
-    explicit ordered_map(const Allocator& alloc) noexcept(noexcept(Container(alloc))) : Container{alloc} {}
+                  struct indexed_ordered_map : ordered_map<Key, T, IgnoredLess, Allocator>
+{
+    using base_type = ordered_map<Key, T, IgnoredLess, Allocator>;
+    using key_type = typename base_type::key_type;
+    using mapped_type = typename base_type::mapped_type;
+    using Container = typename base_type::Container;
+    using iterator = typename base_type::iterator;
+    using const_iterator = typename base_type::const_iterator;
+    using size_type = typename base_type::size_type;
+    using value_type = typename base_type::value_type;
+    using key_compare = typename base_type::key_compare;
+
+    /// smaller objects are searched linearly
+    static constexpr size_type index_threshold = 32;
+
+    indexed_ordered_map() noexcept(noexcept(Container())) : base_type{} {}
+    explicit indexed_ordered_map(const Allocator& alloc) noexcept(noexcept(Container(alloc))) : base_type{alloc}, m_index(alloc) {}
     template <class It>
-    ordered_map(It first, It last, const Allocator& alloc = Allocator())
-        : Container{first, last, alloc} {}
-    ordered_map(std::initializer_list<value_type> init, const Allocator& alloc = Allocator() )
-        : Container{init, alloc} {}
+    indexed_ordered_map(It first, It last, const Allocator& alloc = Allocator())
+        : base_type{alloc}, m_index(alloc)
+    {
+        insert(first, last);
+    }
+    indexed_ordered_map(std::initializer_list<value_type> init, const Allocator& alloc = Allocator() )
+        : base_type{alloc}, m_index(alloc)
+    {
+        insert(init.begin(), init.end());
+    }
 
     std::pair<iterator, bool> emplace(const key_type& key, T&& t)
     {
-        for (auto it = this->begin(); it != this->end(); ++it)
+        const auto pos = find_position(key);
+        if (pos != npos)
         {
-            if (m_compare(it->first, key))
-            {
-                return {it, false};
-            }
+            return {this->begin() + static_cast<difference_type>(pos), false};
         }
         Container::emplace_back(key, std::forward<T>(t));
+        added();
         return {std::prev(this->end()), true};
     }
 
@@ -19072,14 +21961,13 @@ template <class Key, class T, class IgnoredLess = std::less<Key>,
                  detail::is_usable_as_key_type<key_compare, key_type, KeyType>::value, int> = 0>
     std::pair<iterator, bool> emplace(KeyType && key, T && t)
     {
-        for (auto it = this->begin(); it != this->end(); ++it)
+        const auto pos = find_position(key);
+        if (pos != npos)
         {
-            if (m_compare(it->first, key))
-            {
-                return {it, false};
-            }
+            return {this->begin() + static_cast<difference_type>(pos), false};
         }
         Container::emplace_back(std::forward<KeyType>(key), std::forward<T>(t));
+        added();
         return {std::prev(this->end()), true};
     }
 
@@ -19104,259 +21992,280 @@ template <class Key, class T, class IgnoredLess = std::less<Key>,
                  detail::is_usable_as_key_type<key_compare, key_type, KeyType>::value, int> = 0>
     const T & operator[](KeyType && key) const
     {
-        return at(std::forward<KeyType>(key));
+        return at(std::forward<KeyType>(key));
+    }
+
+    T& at(const key_type& key)
+    {
+        return element_at(key);
+    }
+
+    template<class KeyType, detail::enable_if_t<
+                 detail::is_usable_as_key_type<key_compare, key_type, KeyType>::value, int> = 0>
+    T & at(KeyType && key) // NOLINT(cppcoreguidelines-missing-std-forward)
+    {
+        return element_at(key);
+    }
+
+    const T& at(const key_type& key) const
+    {
+        return element_at(key);
+    }
+
+    template<class KeyType, detail::enable_if_t<
+                 detail::is_usable_as_key_type<key_compare, key_type, KeyType>::value, int> = 0>
+    const T & at(KeyType && key) const // NOLINT(cppcoreguidelines-missing-std-forward)
+    {
+        return element_at(key);
+    }
+
+    size_type erase(const key_type& key)
+    {
+        return erase_key(key);
+    }
+
+    template<class KeyType, detail::enable_if_t<
+                 detail::is_usable_as_key_type<key_compare, key_type, KeyType>::value, int> = 0>
+    size_type erase(KeyType && key) // NOLINT(cppcoreguidelines-missing-std-forward)
+    {
+        return erase_key(key);
+    }
+
+    iterator erase(iterator pos)
+    {
+        return erase(pos, std::next(pos));
+    }
+
+    iterator erase(iterator first, iterator last)
+    {
+        auto it = base_type::erase(first, last);
+        if (first != last)
+        {
+            // the positions after first have moved
+            rebuild_index();
+        }
+        return it;
+    }
+
+    void clear() noexcept
+    {
+        Container::clear();
+        m_index.clear();
     }
 
-    T& at(const key_type& key)
+    size_type count(const key_type& key) const
     {
-        for (auto it = this->begin(); it != this->end(); ++it)
-        {
-            if (m_compare(it->first, key))
-            {
-                return it->second;
-            }
-        }
-
-        JSON_THROW(std::out_of_range("key not found"));
+        return find_position(key) != npos ? 1 : 0;
     }
 
     template<class KeyType, detail::enable_if_t<
                  detail::is_usable_as_key_type<key_compare, key_type, KeyType>::value, int> = 0>
-    T & at(KeyType && key) // NOLINT(cppcoreguidelines-missing-std-forward)
+    size_type count(KeyType && key) const // NOLINT(cppcoreguidelines-missing-std-forward)
     {
-        for (auto it = this->begin(); it != this->end(); ++it)
-        {
-            if (m_compare(it->first, key))
-            {
-                return it->second;
-            }
-        }
-
-        JSON_THROW(std::out_of_range("key not found"));
+        return find_position(key) != npos ? 1 : 0;
     }
 
-    const T& at(const key_type& key) const
+    iterator find(const key_type& key)
     {
-        for (auto it = this->begin(); it != this->end(); ++it)
-        {
-            if (m_compare(it->first, key))
-            {
-                return it->second;
-            }
-        }
-
-        JSON_THROW(std::out_of_range("key not found"));
+        return to_iterator(this->begin(), find_position(key));
     }
 
     template<class KeyType, detail::enable_if_t<
                  detail::is_usable_as_key_type<key_compare, key_type, KeyType>::value, int> = 0>
-    const T & at(KeyType && key) const // NOLINT(cppcoreguidelines-missing-std-forward)
+    iterator find(KeyType && key) // NOLINT(cppcoreguidelines-missing-std-forward)
     {
-        for (auto it = this->begin(); it != this->end(); ++it)
-        {
-            if (m_compare(it->first, key))
-            {
-                return it->second;
-            }
-        }
-
-        JSON_THROW(std::out_of_range("key not found"));
+        return to_iterator(this->begin(), find_position(key));
     }
 
-    size_type erase(const key_type& key)
+    const_iterator find(const key_type& key) const
     {
-        for (auto it = this->begin(); it != this->end(); ++it)
-        {
-            if (m_compare(it->first, key))
-            {
-                // Since we cannot move const Keys, re-construct them in place
-                for (auto next = it; ++next != this->end(); ++it)
-                {
-                    it->~value_type(); // Destroy but keep allocation
-                    new (&*it) value_type{std::move(*next)};
-                }
-                Container::pop_back();
-                return 1;
-            }
-        }
-        return 0;
+        return to_iterator(this->begin(), find_position(key));
     }
 
     template<class KeyType, detail::enable_if_t<
                  detail::is_usable_as_key_type<key_compare, key_type, KeyType>::value, int> = 0>
-    size_type erase(KeyType && key) // NOLINT(cppcoreguidelines-missing-std-forward)
+    const_iterator find(KeyType && key) const // NOLINT(cppcoreguidelines-missing-std-forward)
     {
-        for (auto it = this->begin(); it != this->end(); ++it)
-        {
-            if (m_compare(it->first, key))
-            {
-                // Since we cannot move const Keys, re-construct them in place
-                for (auto next = it; ++next != this->end(); ++it)
-                {
-                    it->~value_type(); // Destroy but keep allocation
-                    new (&*it) value_type{std::move(*next)};
-                }
-                Container::pop_back();
-                return 1;
-            }
-        }
-        return 0;
+        return to_iterator(this->begin(), find_position(key));
     }
 
-    iterator erase(iterator pos)
+    std::pair<iterator, bool> insert( value_type&& value )
     {
-        return erase(pos, std::next(pos));
+        return emplace(value.first, std::move(value.second));
     }
 
-    iterator erase(iterator first, iterator last)
+    std::pair<iterator, bool> insert( const value_type& value )
     {
-        if (first == last)
+        const auto pos = find_position(value.first);
+        if (pos != npos)
         {
-            return first;
+            return {this->begin() + static_cast<difference_type>(pos), false};
         }
+        Container::push_back(value);
+        added();
+        return {--this->end(), true};
+    }
 
-        const auto elements_affected = std::distance(first, last);
-        const auto offset = std::distance(Container::begin(), first);
-
-        // This is the start situation. We need to delete elements_affected
-        // elements (3 in this example: e, f, g), and need to return an
-        // iterator past the last deleted element (h in this example).
-        // Note that offset is the distance from the start of the vector
-        // to first. We will need this later.
+    template<typename InputIt, typename = typename base_type::template require_input_iter<InputIt>>
+    void insert(InputIt first, InputIt last)
+    {
+        for (auto it = first; it != last; ++it)
+        {
+            insert(*it);
+        }
+    }
 
-        // [ a, b, c, d, e, f, g, h, i, j ]
-        //               ^        ^
-        //             first    last
+  private:
+    using difference_type = typename Container::difference_type;
 
-        // Since we cannot move const Keys, we re-construct them in place.
-        // We start at first and re-construct (viz. copy) the elements from
-        // the back of the vector. Example for first iteration:
+    /// a slot of the index: hash of the key and position + 1 (0: empty)
+    struct slot
+    {
+        std::size_t hash;
+        size_type pos;
+    };
+    using slot_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<slot>;
 
-        //               ,--------.
-        //               v        |   destroy e and re-construct with h
-        // [ a, b, c, d, e, f, g, h, i, j ]
-        //               ^        ^
-        //               it       it + elements_affected
+    static constexpr size_type npos = static_cast<size_type>(-1);
 
-        for (auto it = first; std::next(it, elements_affected) != Container::end(); ++it)
+    /// FNV-1a, so that all the key types give the same hash for the same text
+    static std::size_t hash_bytes(const char* s, std::size_t n) noexcept
+    {
+        std::uint64_t h = 14695981039346656037ull;
+        for (std::size_t i = 0; i < n; ++i)
         {
-            it->~value_type(); // destroy but keep allocation
-            new (&*it) value_type{std::move(*std::next(it, elements_affected))}; // "move" next element to it
+            h = (h ^ static_cast<unsigned char>(s[i])) * 1099511628211ull;
         }
+        return static_cast<std::size_t>(h ^ (h >> 32));
+    }
 
-        // [ a, b, c, d, h, i, j, h, i, j ]
-        //               ^        ^
-        //             first    last
-
-        // remove the unneeded elements at the end of the vector
-        Container::resize(this->size() - static_cast<size_type>(elements_affected));
-
-        // [ a, b, c, d, h, i, j ]
-        //               ^        ^
-        //             first    last
+    static std::size_t hash_key(const char* s) noexcept
+    {
+        return hash_bytes(s, std::strlen(s));
+    }
 
-        // first is now pointing past the last deleted element, but we cannot
-        // use this iterator, because it may have been invalidated by the
-        // resize call. Instead, we can return begin() + offset.
-        return Container::begin() + offset;
+    template<typename StringLike>
+    static std::size_t hash_key(const StringLike& s) noexcept
+    {
+        return hash_bytes(s.data(), s.size());
     }
 
-    size_type count(const key_type& key) const
+    template<typename KeyType>
+    size_type find_position(const KeyType& key) const
     {
-        for (auto it = this->begin(); it != this->end(); ++it)
+        if (m_index.empty())
         {
-            if (m_compare(it->first, key))
+            for (size_type i = 0; i < this->size(); ++i)
             {
-                return 1;
+                if (m_compare(Container::operator[](i).first, key))
+                {
+                    return i;
+                }
             }
+            return npos;
         }
-        return 0;
-    }
 
-    template<class KeyType, detail::enable_if_t<
-                 detail::is_usable_as_key_type<key_compare, key_type, KeyType>::value, int> = 0>
-    size_type count(KeyType && key) const // NOLINT(cppcoreguidelines-missing-std-forward)
-    {
-        for (auto it = this->begin(); it != this->end(); ++it)
+        const auto h = hash_key(key);
+        const auto mask = m_index.size() - 1;
+        for (auto i = h & mask;; i = (i + 1) & mask)
         {
-            if (m_compare(it->first, key))
+            const auto& s = m_index[i];
+            if (s.pos == 0)
             {
-                return 1;
+                return npos;
+            }
+            if (s.hash == h && m_compare(Container::operator[](s.pos - 1).first, key))
+            {
+                return s.pos - 1;
             }
         }
-        return 0;
     }
 
-    iterator find(const key_type& key)
+    template<typename KeyType>
+    T& element_at(const KeyType& key)
     {
-        for (auto it = this->begin(); it != this->end(); ++it)
+        const auto pos = find_position(key);
+        if (pos == npos)
         {
-            if (m_compare(it->first, key))
-            {
-                return it;
-            }
+            JSON_THROW(std::out_of_range("key not found"));
         }
-        return Container::end();
+        return Container::operator[](pos).second;
     }
 
-    template<class KeyType, detail::enable_if_t<
-                 detail::is_usable_as_key_type<key_compare, key_type, KeyType>::value, int> = 0>
-    iterator find(KeyType && key) // NOLINT(cppcoreguidelines-missing-std-forward)
+    template<typename KeyType>
+    const T& element_at(const KeyType& key) const
     {
-        for (auto it = this->begin(); it != this->end(); ++it)
+        const auto pos = find_position(key);
+        if (pos == npos)
         {
-            if (m_compare(it->first, key))
-            {
-                return it;
-            }
+            JSON_THROW(std::out_of_range("key not found"));
         }
-        return Container::end();
+        return Container::operator[](pos).second;
     }
 
-    const_iterator find(const key_type& key) const
+    template<typename KeyType>
+    size_type erase_key(const KeyType& key)
     {
-        for (auto it = this->begin(); it != this->end(); ++it)
+        const auto pos = find_position(key);
+        if (pos == npos)
         {
-            if (m_compare(it->first, key))
-            {
-                return it;
-            }
+            return 0;
         }
-        return Container::end();
+        erase(this->begin() + static_cast<difference_type>(pos));
+        return 1;
     }
 
-    std::pair<iterator, bool> insert( value_type&& value )
+    template<typename It>
+    It to_iterator(It begin, size_type pos) const
     {
-        return emplace(value.first, std::move(value.second));
+        return pos == npos ? std::next(begin, static_cast<difference_type>(this->size())) : std::next(begin, static_cast<difference_type>(pos));
     }
 
-    std::pair<iterator, bool> insert( const value_type& value )
+    /// the last element has been appended
+    void added()
     {
-        for (auto it = this->begin(); it != this->end(); ++it)
+        if (!m_index.empty() && this->size() * 2 <= m_index.size())
         {
-            if (m_compare(it->first, value.first))
-            {
-                return {it, false};
-            }
+            insert_index(this->size() - 1);
+            return;
         }
-        Container::push_back(value);
-        return {--this->end(), true};
+        rebuild_index();
     }
 
-    template<typename InputIt>
-    using require_input_iter = typename std::enable_if<std::is_convertible<typename std::iterator_traits<InputIt>::iterator_category,
-            std::input_iterator_tag>::value>::type;
+    void insert_index(size_type pos)
+    {
+        const auto h = hash_key(Container::operator[](pos).first);
+        const auto mask = m_index.size() - 1;
+        auto i = h & mask;
+        while (m_index[i].pos != 0)
+        {
+            i = (i + 1) & mask;
+        }
+        m_index[i] = slot{h, pos + 1};
+    }
 
-    template<typename InputIt, typename = require_input_iter<InputIt>>
-    void insert(InputIt first, InputIt last)
+    /// (re)build the index at a load factor of at most 1/2
+    void rebuild_index()
     {
-        for (auto it = first; it != last; ++it)
+        m_index.clear();
+        if (this->size() < index_threshold)
         {
-            insert(*it);
+            return;
+        }
+
+        size_type n = 64;
+        while (n < this->size() * 4)
+        {
+            n *= 2;
+        }
+        m_index.assign(n, slot{0, 0});
+        for (size_type pos = 0; pos < this->size(); ++pos)
+        {
+            insert_index(pos);
         }
     }
 
-private:
+    std::vector<slot, slot_allocator> m_index;
     JSON_NO_UNIQUE_ADDRESS key_compare m_compare = key_compare();
 };
 
@@ -19412,7 +22321,7 @@ class basic_json // NOLINT(cppcoreguidelines-special-member-functions,hicpp-spec
     friend ::nlohmann::detail::serializer<basic_json>;
     template<typename BasicJsonType>
     friend class ::nlohmann::detail::iter_impl;
-    template<typename BasicJsonType, typename CharType>
+    template<typename BasicJsonType, typename CharType, typename OutputAdapterType>
     friend class ::nlohmann::detail::binary_writer;
     template<typename BasicJsonType, typename InputType, typename SAX>
     friend class ::nlohmann::detail::binary_reader;
@@ -23670,7 +26579,11 @@ class basic_json // NOLINT(cppcoreguidelines-special-member-functions,hicpp-spec
         detail::json_sax_dom_parser<basic_json> sdp(result, allow_exceptions);
         auto ia = detail::input_adapter(std::forward<InputType>(i));
         const bool res = binary_reader<decltype(ia)>(std::move(ia), input_format_t::cbor).sax_parse(input_format_t::cbor, &sdp, strict, tag_handler);
-        return res ? result : basic_json(value_t::discarded);
+        if (!res)
+        {
+            return basic_json(value_t::discarded);
+        }
+        return result;
     }
 
     /// @brief create a JSON value from an input in CBOR format
@@ -23686,7 +26599,11 @@ class basic_json // NOLINT(cppcoreguidelines-special-member-functions,hicpp-spec
         detail::json_sax_dom_parser<basic_json> sdp(result, allow_exceptions);
         auto ia = detail::input_adapter(std::move(first), std::move(last));
         const bool res = binary_reader<decltype(ia)>(std::move(ia), input_format_t::cbor).sax_parse(input_format_t::cbor, &sdp, strict, tag_handler);
-        return res ? result : basic_json(value_t::discarded);
+        if (!res)
+        {
+            return basic_json(value_t::discarded);
+        }
+        return result;
     }
 
     template<typename T>
@@ -23712,7 +26629,11 @@ class basic_json // NOLINT(cppcoreguidelines-special-member-functions,hicpp-spec
         auto ia = i.get();
         // NOLINTNEXTLINE(hicpp-move-const-arg,performance-move-const-arg)
         const bool res = binary_reader<decltype(ia)>(std::move(ia), input_format_t::cbor).sax_parse(input_format_t::cbor, &sdp, strict, tag_handler);
-        return res ? result : basic_json(value_t::discarded);
+        if (!res)
+        {
+            return basic_json(value_t::discarded);
+        }
+        return result;
     }
 
     /// @brief create a JSON value from an input in MessagePack format
@@ -23727,7 +26648,11 @@ class basic_json // NOLINT(cppcoreguidelines-special-member-functions,hicpp-spec
         detail::json_sax_dom_parser<basic_json> sdp(result, allow_exceptions);
         auto ia = detail::input_adapter(std::forward<InputType>(i));
         const bool res = binary_reader<decltype(ia)>(std::move(ia), input_format_t::msgpack).sax_parse(input_format_t::msgpack, &sdp, strict);
-        return res ? result : basic_json(value_t::discarded);
+        if (!res)
+        {
+            return basic_json(value_t::discarded);
+        }
+        return result;
     }
 
     /// @brief create a JSON value from an input in MessagePack format
@@ -23742,7 +26667,11 @@ class basic_json // NOLINT(cppcoreguidelines-special-member-functions,hicpp-spec
         detail::json_sax_dom_parser<basic_json> sdp(result, allow_exceptions);
         auto ia = detail::input_adapter(std::move(first), std::move(last));
         const bool res = binary_reader<decltype(ia)>(std::move(ia), input_format_t::msgpack).sax_parse(input_format_t::msgpack, &sdp, strict);
-        return res ? result : basic_json(value_t::discarded);
+        if (!res)
+        {
+            return basic_json(value_t::discarded);
+        }
+        return result;
     }
 
     template<typename T>
@@ -23766,7 +26695,11 @@ class basic_json // NOLINT(cppcoreguidelines-special-member-functions,hicpp-spec
         auto ia = i.get();
         // NOLINTNEXTLINE(hicpp-move-const-arg,performance-move-const-arg)
         const bool res = binary_reader<decltype(ia)>(std::move(ia), input_format_t::msgpack).sax_parse(input_format_t::msgpack, &sdp, strict);
-        return res ? result : basic_json(value_t::discarded);
+        if (!res)
+        {
+            return basic_json(value_t::discarded);
+        }
+        return result;
     }
 
     /// @brief create a JSON value from an input in UBJSON format
@@ -23781,7 +26714,11 @@ class basic_json // NOLINT(cppcoreguidelines-special-member-functions,hicpp-spec
         detail::json_sax_dom_parser<basic_json> sdp(result, allow_exceptions);
         auto ia = detail::input_adapter(std::forward<InputType>(i));
         const bool res = binary_reader<decltype(ia)>(std::move(ia), input_format_t::ubjson).sax_parse(input_format_t::ubjson, &sdp, strict);
-        return res ? result : basic_json(value_t::discarded);
+        if (!res)
+        {
+            return basic_json(value_t::discarded);
+        }
+        return result;
     }
 
     /// @brief create a JSON value from an input in UBJSON format
@@ -23796,7 +26733,11 @@ class basic_json // NOLINT(cppcoreguidelines-special-member-functions,hicpp-spec
         detail::json_sax_dom_parser<basic_json> sdp(result, allow_exceptions);
         auto ia = detail::input_adapter(std::move(first), std::move(last));
         const bool res = binary_reader<decltype(ia)>(std::move(ia), input_format_t::ubjson).sax_parse(input_format_t::ubjson, &sdp, strict);
-        return res ? result : basic_json(value_t::discarded);
+        if (!res)
+        {
+            return basic_json(value_t::discarded);
+        }
+        return result;
     }
 
     template<typename T>
@@ -23820,7 +26761,11 @@ class basic_json // NOLINT(cppcoreguidelines-special-member-functions,hicpp-spec
         auto ia = i.get();
         // NOLINTNEXTLINE(hicpp-move-const-arg,performance-move-const-arg)
         const bool res = binary_reader<decltype(ia)>(std::move(ia), input_format_t::ubjson).sax_parse(input_format_t::ubjson, &sdp, strict);
-        return res ? result : basic_json(value_t::discarded);
+        if (!res)
+        {
+            return basic_json(value_t::discarded);
+        }
+        return result;
     }
 
     /// @brief create a JSON value from an input in BJData format
@@ -23835,7 +26780,11 @@ class basic_json // NOLINT(cppcoreguidelines-special-member-functions,hicpp-spec
         detail::json_sax_dom_parser<basic_json> sdp(result, allow_exceptions);
         auto ia = detail::input_adapter(std::forward<InputType>(i));
         const bool res = binary_reader<decltype(ia)>(std::move(ia), input_format_t::bjdata).sax_parse(input_format_t::bjdata, &sdp, strict);
-        return res ? result : basic_json(value_t::discarded);
+        if (!res)
+        {
+            return basic_json(value_t::discarded);
+        }
+        return result;
     }
 
     /// @brief create a JSON value from an input in BJData format
@@ -23850,7 +26799,11 @@ class basic_json // NOLINT(cppcoreguidelines-special-member-functions,hicpp-spec
         detail::json_sax_dom_parser<basic_json> sdp(result, allow_exceptions);
         auto ia = detail::input_adapter(std::move(first), std::move(last));
         const bool res = binary_reader<decltype(ia)>(std::move(ia), input_format_t::bjdata).sax_parse(input_format_t::bjdata, &sdp, strict);
-        return res ? result : basic_json(value_t::discarded);
+        if (!res)
+        {
+            return basic_json(value_t::discarded);
+        }
+        return result;
     }
 
     /// @brief create a JSON value from an input in BSON format
@@ -23865,7 +26818,11 @@ class basic_json // NOLINT(cppcoreguidelines-special-member-functions,hicpp-spec
         detail::json_sax_dom_parser<basic_json> sdp(result, allow_exceptions);
         auto ia = detail::input_adapter(std::forward<InputType>(i));
         const bool res = binary_reader<decltype(ia)>(std::move(ia), input_format_t::bson).sax_parse(input_format_t::bson, &sdp, strict);
-        return res ? result : basic_json(value_t::discarded);
+        if (!res)
+        {
+            return basic_json(value_t::discarded);
+        }
+        return result;
     }
 
     /// @brief create a JSON value from an input in BSON format
@@ -23880,7 +26837,11 @@ class basic_json // NOLINT(cppcoreguidelines-special-member-functions,hicpp-spec
         detail::json_sax_dom_parser<basic_json> sdp(result, allow_exceptions);
         auto ia = detail::input_adapter(std::move(first), std::move(last));
         const bool res = binary_reader<decltype(ia)>(std::move(ia), input_format_t::bson).sax_parse(input_format_t::bson, &sdp, strict);
-        return res ? result : basic_json(value_t::discarded);
+        if (!res)
+        {
+            return basic_json(value_t::discarded);
+        }
+        return result;
     }
 
     template<typename T>
@@ -23904,7 +26865,11 @@ class basic_json // NOLINT(cppcoreguidelines-special-member-functions,hicpp-spec
         auto ia = i.get();
         // NOLINTNEXTLINE(hicpp-move-const-arg,performance-move-const-arg)
         const bool res = binary_reader<decltype(ia)>(std::move(ia), input_format_t::bson).sax_parse(input_format_t::bson, &sdp, strict);
-        return res ? result : basic_json(value_t::discarded);
+        if (!res)
+        {
+            return basic_json(value_t::discarded);
+        }
+        return result;
     }
     /// @}
 
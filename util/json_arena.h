@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2024, edgecraft. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "json.hpp"
+
+namespace {
+
+// monotonic memory arena.
+// memory is carved out of a few large blocks, and deallocation does nothing.
+// all blocks are released at once when the arena is destroyed.
+class json_arena
+{
+public:
+    explicit json_arena(std::size_t block_size = 1 << 20) : next_block_size(std::max<std::size_t>(block_size, 4096)) {}
+    ~json_arena()
+    {
+        for (auto *b : blocks) ::operator delete(b);
+    }
+
+    json_arena(const json_arena &) = delete;
+    json_arena &operator=(const json_arena &) = delete;
+
+    void *allocate(std::size_t size)
+    {
+        constexpr std::size_t align = alignof(std::max_align_t);
+        size = (size + align - 1) & ~(align - 1);
+
+        if (size > static_cast<std::size_t>(end - cur)) {
+            // a large request gets its own block, and the current block keeps on being used.
+            if (size > next_block_size / 4) {
+                auto *b = static_cast<char *>(::operator new(size));
+                blocks.push_back(b);
+                total += size;
+                return b;
+            }
+            cur = static_cast<char *>(::operator new(next_block_size));
+            end = cur + next_block_size;
+            blocks.push_back(cur);
+            total += next_block_size;
+            next_block_size = std::min<std::size_t>(next_block_size * 2, 64 << 20);
+        }
+
+        void *p = cur;
+        cur += size;
+        return p;
+    }
+
+    // total size of the blocks.
+    std::size_t capacity() const { return total; }
+
+    // allocator of this thread. (nullptr: operator new / delete)
+    static json_arena *current() { return current_arena; }
+
+private:
+    friend class json_arena_scope;
+
+    std::vector<char *> blocks;
+    char *cur = nullptr;
+    char *end = nullptr;
+    std::size_t next_block_size;
+    std::size_t total = 0;
+
+    static inline thread_local json_arena *current_arena = nullptr;
+};
+
+// routes arena_allocator of this thread to the arena while in scope.
+class json_arena_scope
+{
+public:
+    explicit json_arena_scope(json_arena &arena) : prev(json_arena::current_arena) { json_arena::current_arena = &arena; }
+    ~json_arena_scope() { json_arena::current_arena = prev; }
+
+    json_arena_scope(const json_arena_scope &) = delete;
+    json_arena_scope &operator=(const json_arena_scope &) = delete;
+
+private:
+    json_arena *prev;
+};
+
+// allocator for basic_json. (AllocatorType)
+// basic_json creates a new allocator for every node, so the arena is taken from json_arena_scope,
+// and every block remembers where it came from to be deallocated by any other allocator.
+// outside of json_arena_scope it works as std::allocator.
+template<typename T> class arena_allocator
+{
+public:
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal = std::true_type;
+
+    arena_allocator() noexcept = default;
+    template<typename U> arena_allocator(const arena_allocator<U> &) noexcept {}
+
+    T *allocate(std::size_t n)
+    {
+        if (n > (std::numeric_limits<std::size_t>::max() - header_size()) / sizeof(T)) throw std::bad_array_new_length();
+
+        auto *arena = json_arena::current();
+        auto size = header_size() + n * sizeof(T);
+        auto *p = static_cast<char *>(arena ? arena->allocate(size) : ::operator new(size));
+        *reinterpret_cast<json_arena **>(p) = arena;
+
+        return reinterpret_cast<T *>(p + header_size());
+    }
+
+    void deallocate(T *ptr, std::size_t) noexcept
+    {
+        auto *p = reinterpret_cast<char *>(ptr) - header_size();
+        if (*reinterpret_cast<json_arena **>(p) == nullptr) ::operator delete(p);
+    }
+
+    friend bool operator==(const arena_allocator &, const arena_allocator &) noexcept { return true; }
+    friend bool operator!=(const arena_allocator &, const arena_allocator &) noexcept { return false; }
+
+private:
+    // T is incomplete when basic_json instantiates the allocator.
+    static constexpr std::size_t header_size()
+    {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned type is not supported.");
+        return (sizeof(json_arena *) + alignof(T) - 1) / alignof(T) * alignof(T);
+    }
+};
+
+using arena_string = std::basic_string<char, std::char_traits<char>, arena_allocator<char>>;
+
+// basic_json whose strings, arrays and objects are allocated by arena_allocator.
+using njson_arena = nlohmann::basic_json<std::map, std::vector, arena_string, bool, std::int64_t, std::uint64_t, double,
+    arena_allocator, nlohmann::adl_serializer, std::vector<std::uint8_t, arena_allocator<std::uint8_t>>>;
+
+// document in its own arena.
+// the document itself lives in the arena as well, and is never destroyed node by node:
+// the arena is just released, so freeing a whole document costs a few delete calls.
+// for this, every node has to come from the arena. the document is read-only, and edit() is run in json_arena_scope.
+// (values copied out of the document outside of json_arena_scope are on the heap, and independent of it.)
+class arena_document
+{
+public:
+    explicit arena_document(std::size_t block_size = 1 << 20) : arena(std::make_unique<json_arena>(block_size))
+    {
+        json = new (arena->allocate(sizeof(njson_arena))) njson_arena();
+    }
+
+    arena_document(arena_document &&rhs) noexcept : arena(std::move(rhs.arena)), json(std::exchange(rhs.json, nullptr)) {}
+    arena_document &operator=(arena_document &&rhs) noexcept
+    {
+        std::swap(arena, rhs.arena);
+        std::swap(json, rhs.json);
+        return *this;
+    }
+
+    const njson_arena &get() const { return *json; }
+    const njson_arena &operator*() const { return *json; }
+    const njson_arena *operator->() const { return json; }
+
+    // modify the document. (doc.edit([](njson_arena &j) { j["key"] = 1; });)
+    // new nodes are allocated in the arena, and the old ones are left there until the document is freed.
+    template<typename F> void edit(F &&f)
+    {
+        json_arena_scope scope(*arena);
+        f(*json);
+    }
+
+    const json_arena &memory() const { return *arena; }
+
+private:
+    std::unique_ptr<json_arena> arena;
+    njson_arena *json = nullptr; // in the arena.
+};
+}
@@ -0,0 +1,869 @@
+/*
+ * Copyright (c) 2024, edgecraft. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "json.hpp"
+
+// member list of a struct for json_bind_sax. (used by NLOHMANN_DEFINE_TYPE_*_HYBRID in JSON_utils.h)
+#define JSON_BIND_MEMBER(v1) , std::make_tuple(make_json_bind_member(#v1, &json_bind_type::v1))
+#define JSON_BIND_MEMBERS_INTRUSIVE(Type, ...)  \
+    friend constexpr auto json_bind_members(const Type *) { using json_bind_type = Type; return std::tuple_cat(std::tuple<>() NLOHMANN_JSON_EXPAND(NLOHMANN_JSON_PASTE(JSON_BIND_MEMBER, __VA_ARGS__))); }
+#define JSON_BIND_MEMBERS_NON_INTRUSIVE(Type, ...)  \
+    constexpr auto json_bind_members(const Type *) { using json_bind_type = Type; return std::tuple_cat(std::tuple<>() NLOHMANN_JSON_EXPAND(NLOHMANN_JSON_PASTE(JSON_BIND_MEMBER, __VA_ARGS__))); }
+
+namespace {
+
+template<typename Class, typename Member>
+struct json_bind_member
+{
+    std::string_view name;
+    Member Class::*ptr;
+};
+
+template<typename Class, typename Member>
+constexpr json_bind_member<Class, Member> make_json_bind_member(std::string_view name, Member Class::*ptr)
+{
+    return {name, ptr};
+}
+
+template<typename T, typename = void>
+struct has_json_bind_members : std::false_type {};
+template<typename T>
+struct has_json_bind_members<T, std::void_t<decltype(json_bind_members(static_cast<const T *>(nullptr)))>> : std::true_type {};
+
+// FNV-1a. (the same at compile time and at run time)
+constexpr std::uint64_t json_bind_hash(std::string_view s)
+{
+    std::uint64_t h = 14695981039346656037ull;
+    for (auto c : s) h = (h ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+    return h;
+}
+
+constexpr std::size_t json_bind_table_bits(std::size_t n)
+{
+    std::size_t bits = 3;
+    while ((std::size_t(1) << bits) < n * 4) bits++;
+    return bits;
+}
+
+constexpr std::size_t json_bind_slot(std::uint64_t h, std::uint64_t multiplier, std::size_t bits)
+{
+    return static_cast<std::size_t>((h * multiplier) >> (64 - bits));
+}
+
+template<std::size_t Bits>
+struct json_bind_hash_table
+{
+    std::uint64_t multiplier = 0;
+    std::array<std::uint32_t, std::size_t(1) << Bits> slots = {}; // member index + 1. (0: empty)
+};
+
+// the multiplier is searched for a perfect hash (one probe per key).
+// if there is none in a reasonable time (very large structs), linear probing resolves the collisions.
+template<std::size_t Bits, std::size_t N>
+constexpr json_bind_hash_table<Bits> json_bind_make_table(const std::array<std::string_view, N> &names)
+{
+    constexpr std::size_t size = std::size_t(1) << Bits;
+
+    std::array<std::uint64_t, N> hashes = {};
+    for (std::size_t i = 0; i < N; i++) hashes[i] = json_bind_hash(names[i]);
+
+    std::uint64_t multiplier = 0x9E3779B97F4A7C15ull;
+    for (int n = 0; n < 256; n++, multiplier += 2) {
+        std::array<bool, size> used = {};
+        bool perfect = true;
+        for (std::size_t i = 0; i < N && perfect; i++) {
+            auto s = json_bind_slot(hashes[i], multiplier, Bits);
+            perfect = !used[s];
+            used[s] = true;
+        }
+        if (perfect) break;
+    }
+
+    json_bind_hash_table<Bits> t;
+    t.multiplier = multiplier;
+    for (std::size_t i = 0; i < N; i++) {
+        auto s = json_bind_slot(hashes[i], multiplier, Bits);
+        while (t.slots[s] != 0) s = (s + 1) & (size - 1);
+        t.slots[s] = static_cast<std::uint32_t>(i + 1);
+    }
+    return t;
+}
+
+template<typename Tuple, std::size_t... I>
+constexpr std::array<std::string_view, sizeof...(I)> json_bind_names(const Tuple &members, std::index_sequence<I...>)
+{
+    return {{std::get<I>(members).name...}};
+}
+
+// member indices in the order of the names.
+template<std::size_t N>
+constexpr std::array<std::size_t, N> json_bind_sorted(const std::array<std::string_view, N> &names)
+{
+    std::array<std::size_t, N> order = {};
+    for (std::size_t i = 0; i < N; i++) {
+        auto j = i;
+        for (; j > 0 && names[i] < names[order[j - 1]]; j--) order[j] = order[j - 1];
+        order[j] = i;
+    }
+    return order;
+}
+
+// member list of a struct, and the hash table of the names built at compile time.
+template<typename T>
+struct json_bind_class
+{
+    static constexpr auto members = json_bind_members(static_cast<const T *>(nullptr));
+    static constexpr std::size_t size = std::tuple_size<std::remove_const_t<decltype(members)>>::value;
+    static constexpr auto names = json_bind_names(members, std::make_index_sequence<size>{});
+    static constexpr std::size_t bits = json_bind_table_bits(size);
+    static constexpr auto table = json_bind_make_table<bits>(names);
+    static constexpr auto sorted = json_bind_sorted(names);
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    template<std::size_t I>
+    using member_type = std::remove_reference_t<decltype(std::declval<T &>().*(std::get<I>(members).ptr))>;
+
+    template<std::size_t I>
+    static void *member(void *p) { return &(static_cast<T *>(p)->*(std::get<I>(members).ptr)); }
+
+    static std::string_view name(std::size_t i) { return names[i]; }
+
+    static std::size_t find(std::string_view key)
+    {
+        constexpr std::size_t mask = (std::size_t(1) << bits) - 1;
+        for (auto i = json_bind_slot(json_bind_hash(key), table.multiplier, bits);; i = (i + 1) & mask) {
+            auto s = table.slots[i];
+            if (s == 0) return npos;
+            if (names[s - 1] == key) return s - 1;
+        }
+    }
+};
+
+template<typename T> struct json_bind_is_optional : std::false_type {};
+template<typename T> struct json_bind_is_optional<std::optional<T>> : std::true_type {};
+template<typename T> struct json_bind_is_vector : std::false_type {};
+template<typename T, typename A> struct json_bind_is_vector<std::vector<T, A>> : std::bool_constant<!std::is_same<T, bool>::value> {};
+template<typename T> struct json_bind_is_std_array : std::false_type {};
+template<typename T, std::size_t N> struct json_bind_is_std_array<std::array<T, N>> : std::true_type {};
+template<typename T> struct json_bind_is_string_map : std::false_type {};
+template<typename V, typename C, typename A> struct json_bind_is_string_map<std::map<std::string, V, C, A>> : std::true_type {};
+template<typename V, typename H, typename E, typename A> struct json_bind_is_string_map<std::unordered_map<std::string, V, H, E, A>> : std::true_type {};
+template<typename T> struct json_bind_is_sorted_map : std::false_type {};
+template<typename V, typename A> struct json_bind_is_sorted_map<std::map<std::string, V, std::less<std::string>, A>> : std::true_type {};
+template<typename V, typename A> struct json_bind_is_sorted_map<std::map<std::string, V, std::less<>, A>> : std::true_type {};
+
+// SAX consumer which writes the values straight into a struct, without building a DOM.
+// supported natively: structs with json_bind_members(), bool, numbers, std::string, std::optional,
+// std::vector, std::array, std::map / std::unordered_map with string keys.
+// other types are built as a small BasicJsonType and converted by their from_json().
+// keys not in the struct are skipped, and a missing member is an error, as with NLOHMANN_DEFINE_TYPE_*.
+template<typename BasicJsonType>
+class json_bind_sax
+{
+public:
+    using number_integer_t = typename BasicJsonType::number_integer_t;
+    using number_unsigned_t = typename BasicJsonType::number_unsigned_t;
+    using number_float_t = typename BasicJsonType::number_float_t;
+    using string_t = typename BasicJsonType::string_t;
+    using binary_t = typename BasicJsonType::binary_t;
+
+    template<typename T>
+    json_bind_sax(T &data, bool force_float32 = false) : root(&data), root_vt(&vtable_of<T>), force_float32(force_float32) {}
+
+    json_bind_sax(const json_bind_sax &) = delete;
+    json_bind_sax &operator=(const json_bind_sax &) = delete;
+
+    bool null()
+    {
+        if (dom) return dom->sax.null();
+        return value(event{nlohmann::detail::value_t::null});
+    }
+
+    bool boolean(bool val)
+    {
+        if (dom) return dom->sax.boolean(val);
+        event ev{nlohmann::detail::value_t::boolean};
+        ev.boolean = val;
+        return value(ev);
+    }
+
+    bool number_integer(number_integer_t val)
+    {
+        if (dom) return dom->sax.number_integer(val);
+        event ev{nlohmann::detail::value_t::number_integer};
+        ev.integer = val;
+        return value(ev);
+    }
+
+    bool number_unsigned(number_unsigned_t val)
+    {
+        if (dom) return dom->sax.number_unsigned(val);
+        event ev{nlohmann::detail::value_t::number_unsigned};
+        ev.unsigned_integer = val;
+        return value(ev);
+    }
+
+    bool number_float(number_float_t val, const string_t &s)
+    {
+        if (dom) return dom->sax.number_float(val, s);
+        event ev{nlohmann::detail::value_t::number_float};
+        ev.floating = force_float32 ? static_cast<number_float_t>(static_cast<float>(val)) : val;
+        return value(ev);
+    }
+
+    bool string(string_t &val)
+    {
+        if (dom) return dom->sax.string(val);
+        event ev{nlohmann::detail::value_t::string};
+        ev.string = &val;
+        return value(ev);
+    }
+
+    bool binary(binary_t &val)
+    {
+        if (dom) return dom->sax.binary(val);
+        event ev{nlohmann::detail::value_t::binary};
+        ev.binary = &val;
+        return value(ev);
+    }
+
+    bool start_object(std::size_t len)
+    {
+        if (dom) {
+            dom->depth++;
+            return dom->sax.start_object(len);
+        }
+        if (skip_depth > 0) {
+            skip_depth++;
+            return true;
+        }
+
+        target t;
+        if (!next_target(t)) {
+            skip_depth = 1;
+            return true;
+        }
+        unwrap(t);
+
+        switch (t.vt->type) {
+        case kind::object:
+            frames.push_back({t, 0, seen.size()});
+            seen.resize(seen.size() + t.vt->size, false);
+            break;
+        case kind::map:
+            t.vt->begin(t.ptr, 0);
+            frames.push_back({t, 0, 0});
+            break;
+        case kind::dom:
+            start_dom(t);
+            dom->depth = 1;
+            return dom->sax.start_object(len);
+        default:
+            type_error(t.vt, nlohmann::detail::value_t::object);
+        }
+        return true;
+    }
+
+    bool key(string_t &val)
+    {
+        if (dom) return dom->sax.key(val);
+        if (skip_depth > 0) return true;
+
+        auto &f = frames.back();
+        if (f.t.vt->type == kind::object) {
+            auto i = f.t.vt->find(std::string_view(val.data(), val.size()));
+            if (i == npos) {
+                pending = {};
+            } else {
+                seen[f.seen_begin + i] = true;
+                pending = {f.t.vt->member(f.t.ptr, i), f.t.vt->member_vt(i)};
+            }
+        } else {
+            pending = {f.t.vt->map_element(f.t.ptr, val), f.t.vt->element_vt()};
+        }
+        return true;
+    }
+
+    bool end_object()
+    {
+        if (dom) {
+            auto ret = dom->sax.end_object();
+            if (--dom->depth == 0) end_dom();
+            return ret;
+        }
+        if (skip_depth > 0) {
+            skip_depth--;
+            return true;
+        }
+
+        auto &f = frames.back();
+        if (f.t.vt->type == kind::object) {
+            for (std::size_t i = 0; i < f.t.vt->size; i++) {
+                if (!seen[f.seen_begin + i]) {
+                    throw nlohmann::detail::out_of_range::create(403, nlohmann::detail::concat("key '", std::string(f.t.vt->member_name(i)), "' not found"), nullptr);
+                }
+            }
+            seen.resize(f.seen_begin);
+        }
+        frames.pop_back();
+        return true;
+    }
+
+    bool start_array(std::size_t len)
+    {
+        if (dom) {
+            dom->depth++;
+            return dom->sax.start_array(len);
+        }
+        if (skip_depth > 0) {
+            skip_depth++;
+            return true;
+        }
+
+        target t;
+        if (!next_target(t)) {
+            skip_depth = 1;
+            return true;
+        }
+        unwrap(t);
+
+        switch (t.vt->type) {
+        case kind::array:
+            t.vt->begin(t.ptr, len == static_cast<std::size_t>(-1) ? 0 : len);
+            frames.push_back({t, 0, 0});
+            break;
+        case kind::dom:
+            start_dom(t);
+            dom->depth = 1;
+            return dom->sax.start_array(len);
+        default:
+            type_error(t.vt, nlohmann::detail::value_t::array);
+        }
+        return true;
+    }
+
+    bool end_array()
+    {
+        if (dom) {
+            auto ret = dom->sax.end_array();
+            if (--dom->depth == 0) end_dom();
+            return ret;
+        }
+        if (skip_depth > 0) {
+            skip_depth--;
+            return true;
+        }
+
+        auto &f = frames.back();
+        f.t.vt->end(f.t.ptr, f.index);
+        frames.pop_back();
+        return true;
+    }
+
+    template<class Exception>
+    bool parse_error(std::size_t /*unused*/, const std::string & /*unused*/, const Exception &ex)
+    {
+        throw ex;
+    }
+
+private:
+    enum class kind { value, object, map, array, optional, dom };
+
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    // a scalar SAX event.
+    struct event
+    {
+        nlohmann::detail::value_t type;
+        bool boolean = false;
+        number_integer_t integer = 0;
+        number_unsigned_t unsigned_integer = 0;
+        number_float_t floating = 0;
+        string_t *string = nullptr;
+        binary_t *binary = nullptr;
+    };
+
+    // how to write a type. (only the functions of its kind are set)
+    struct vtable
+    {
+        kind type = kind::dom;
+        const char *expected = nullptr; // JSON type name for the error message.
+
+        // value
+        void (*set)(void *, const event &) = nullptr;
+        // object
+        std::size_t size = 0;
+        std::size_t (*find)(std::string_view) = nullptr;
+        std::string_view (*member_name)(std::size_t) = nullptr;
+        void *(*member)(void *, std::size_t) = nullptr;
+        const vtable *(*member_vt)(std::size_t) = nullptr;
+        // map, array, optional
+        void (*begin)(void *, std::size_t) = nullptr;
+        void *(*element)(void *, std::size_t) = nullptr; // nullptr: skip the element.
+        void *(*map_element)(void *, string_t &) = nullptr;
+        void (*end)(void *, std::size_t) = nullptr;
+        void (*reset)(void *) = nullptr;
+        const vtable *(*element_vt)() = nullptr;
+        // dom
+        void (*from_json)(void *, const BasicJsonType &) = nullptr;
+    };
+
+    struct target
+    {
+        void *ptr = nullptr;
+        const vtable *vt = nullptr;
+    };
+
+    struct frame
+    {
+        target t;
+        std::size_t index;      // array: next element.
+        std::size_t seen_begin; // object: members found. (in seen)
+    };
+
+    // subtree of a type read by from_json().
+    struct dom_builder
+    {
+        explicit dom_builder(bool force_float32) : sax(json, true, force_float32) {}
+
+        BasicJsonType json;
+        nlohmann::detail::json_sax_dom_parser<BasicJsonType> sax;
+        target t;
+        std::size_t depth = 0;
+    };
+
+    [[noreturn]] static void type_error(const char *expected, nlohmann::detail::value_t actual)
+    {
+        throw nlohmann::detail::type_error::create(302, nlohmann::detail::concat("type must be ", expected, ", but is ", type_name(actual)), nullptr);
+    }
+    [[noreturn]] static void type_error(const vtable *vt, nlohmann::detail::value_t actual)
+    {
+        // the same error as at() of NLOHMANN_DEFINE_TYPE_*.
+        if (vt->type == kind::object) throw nlohmann::detail::type_error::create(304, nlohmann::detail::concat("cannot use at() with ", type_name(actual)), nullptr);
+        type_error(vt->expected, actual);
+    }
+
+    static const char *type_name(nlohmann::detail::value_t t)
+    {
+        switch (t) {
+        case nlohmann::detail::value_t::null: return "null";
+        case nlohmann::detail::value_t::object: return "object";
+        case nlohmann::detail::value_t::array: return "array";
+        case nlohmann::detail::value_t::string: return "string";
+        case nlohmann::detail::value_t::boolean: return "boolean";
+        case nlohmann::detail::value_t::binary: return "binary";
+        case nlohmann::detail::value_t::discarded: return "discarded";
+        default: return "number";
+        }
+    }
+
+    template<typename T>
+    static void set_value(void *p, const event &ev)
+    {
+        auto &v = *static_cast<T *>(p);
+        if constexpr (std::is_same<T, bool>::value) {
+            if (ev.type != nlohmann::detail::value_t::boolean) type_error("boolean", ev.type);
+            v = ev.boolean;
+        } else if constexpr (std::is_arithmetic<T>::value) {
+            switch (ev.type) {
+            case nlohmann::detail::value_t::number_integer: v = static_cast<T>(ev.integer); break;
+            case nlohmann::detail::value_t::number_unsigned: v = static_cast<T>(ev.unsigned_integer); break;
+            case nlohmann::detail::value_t::number_float: v = static_cast<T>(ev.floating); break;
+            case nlohmann::detail::value_t::boolean: v = static_cast<T>(ev.boolean); break;
+            default: type_error("number", ev.type);
+            }
+        } else {
+            if (ev.type != nlohmann::detail::value_t::string) type_error("string", ev.type);
+            v.assign(ev.string->data(), ev.string->size());
+        }
+    }
+
+    template<typename T, typename Members = json_bind_class<T>, std::size_t... I>
+    static constexpr vtable make_object_vtable(std::index_sequence<I...>)
+    {
+        vtable vt;
+        vt.type = kind::object;
+        vt.expected = "object";
+        vt.size = Members::size;
+        vt.find = &Members::find;
+        vt.member_name = &Members::name;
+        vt.member = [](void *p, std::size_t i) -> void * {
+            constexpr std::array<void *(*)(void *), sizeof...(I)> address = {{&Members::template member<I>...}};
+            return address[i](p);
+        };
+        vt.member_vt = [](std::size_t i) -> const vtable * {
+            constexpr std::array<const vtable *, sizeof...(I)> vts = {{&vtable_of<typename Members::template member_type<I>>...}};
+            return vts[i];
+        };
+        return vt;
+    }
+
+    template<typename T>
+    static constexpr vtable make_vtable()
+    {
+        vtable vt;
+        if constexpr (std::is_same<T, bool>::value || std::is_arithmetic<T>::value || std::is_same<T, std::string>::value) {
+            vt.type = kind::value;
+            vt.expected = std::is_same<T, bool>::value ? "boolean" : std::is_arithmetic<T>::value ? "number" : "string";
+            vt.set = &set_value<T>;
+        } else if constexpr (has_json_bind_members<T>::value) {
+            return make_object_vtable<T>(std::make_index_sequence<json_bind_class<T>::size>{});
+        } else if constexpr (json_bind_is_optional<T>::value) {
+            vt.type = kind::optional;
+            vt.element = [](void *p, std::size_t) -> void * { return &static_cast<T *>(p)->emplace(); };
+            vt.reset = [](void *p) { static_cast<T *>(p)->reset(); };
+            vt.element_vt = []() { return &vtable_of<typename T::value_type>; };
+        } else if constexpr (json_bind_is_vector<T>::value) {
+            vt.type = kind::array;
+            vt.expected = "array";
+            vt.begin = [](void *p, std::size_t n) {
+                static_cast<T *>(p)->clear();
+                static_cast<T *>(p)->reserve(n);
+            };
+            vt.element = [](void *p, std::size_t) -> void * { return &static_cast<T *>(p)->emplace_back(); };
+            vt.end = [](void *, std::size_t) {};
+            vt.element_vt = []() { return &vtable_of<typename T::value_type>; };
+        } else if constexpr (json_bind_is_std_array<T>::value) {
+            vt.type = kind::array;
+            vt.expected = "array";
+            vt.begin = [](void *, std::size_t) {};
+            vt.element = [](void *p, std::size_t i) -> void * {
+                return i < std::tuple_size<T>::value ? &(*static_cast<T *>(p))[i] : nullptr;
+            };
+            vt.end = [](void *, std::size_t n) {
+                if (n < std::tuple_size<T>::value) {
+                    throw nlohmann::detail::out_of_range::create(401, nlohmann::detail::concat("array index ", std::to_string(n), " is out of range"), nullptr);
+                }
+            };
+            vt.element_vt = []() { return &vtable_of<typename T::value_type>; };
+        } else if constexpr (json_bind_is_string_map<T>::value) {
+            vt.type = kind::map;
+            vt.expected = "object";
+            vt.begin = [](void *p, std::size_t) { static_cast<T *>(p)->clear(); };
+            vt.map_element = [](void *p, string_t &key) -> void * {
+                auto &m = *static_cast<T *>(p);
+                auto &e = m[std::string(key.data(), key.size())];
+                e = typename T::mapped_type{};
+                return &e;
+            };
+            vt.element_vt = []() { return &vtable_of<typename T::mapped_type>; };
+        } else {
+            vt.type = kind::dom;
+            vt.from_json = [](void *p, const BasicJsonType &j) { j.get_to(*static_cast<T *>(p)); };
+        }
+        return vt;
+    }
+
+    template<typename T>
+    static constexpr vtable vtable_of = make_vtable<T>();
+
+public:
+    // T is written directly. (otherwise through from_json())
+    template<typename T>
+    static constexpr bool is_direct = (vtable_of<T>.type != kind::dom);
+
+private:
+    // where the next value goes.
+    bool next_target(target &t)
+    {
+        if (frames.empty()) {
+            t = {root, root_vt};
+            return true;
+        }
+        auto &f = frames.back();
+        if (f.t.vt->type == kind::array) {
+            t = {f.t.vt->element(f.t.ptr, f.index++), f.t.vt->element_vt()};
+        } else {
+            t = pending;
+            pending = {};
+        }
+        return t.ptr != nullptr;
+    }
+
+    static void unwrap(target &t)
+    {
+        while (t.vt->type == kind::optional) t = {t.vt->element(t.ptr, 0), t.vt->element_vt()};
+    }
+
+    bool value(const event &ev)
+    {
+        if (skip_depth > 0) return true;
+
+        target t;
+        if (!next_target(t)) return true;
+
+        while (t.vt->type == kind::optional) {
+            if (ev.type == nlohmann::detail::value_t::null) {
+                t.vt->reset(t.ptr);
+                return true;
+            }
+            t = {t.vt->element(t.ptr, 0), t.vt->element_vt()};
+        }
+
+        switch (t.vt->type) {
+        case kind::value:
+            t.vt->set(t.ptr, ev);
+            break;
+        case kind::dom:
+            t.vt->from_json(t.ptr, to_json(ev));
+            break;
+        default:
+            type_error(t.vt, ev.type);
+        }
+        return true;
+    }
+
+    BasicJsonType to_json(const event &ev)
+    {
+        switch (ev.type) {
+        case nlohmann::detail::value_t::boolean: return BasicJsonType(ev.boolean);
+        case nlohmann::detail::value_t::number_integer: return BasicJsonType(ev.integer);
+        case nlohmann::detail::value_t::number_unsigned: return BasicJsonType(ev.unsigned_integer);
+        case nlohmann::detail::value_t::number_float: return BasicJsonType(ev.floating);
+        case nlohmann::detail::value_t::string: return BasicJsonType(std::move(*ev.string));
+        case nlohmann::detail::value_t::binary: {
+            auto j = BasicJsonType::binary({});
+            j.get_binary() = std::move(*ev.binary);
+            return j;
+        }
+        default: return BasicJsonType(nullptr);
+        }
+    }
+
+    void start_dom(const target &t)
+    {
+        dom = std::make_unique<dom_builder>(force_float32);
+        dom->t = t;
+    }
+
+    void end_dom()
+    {
+        auto d = std::move(dom);
+        d->t.vt->from_json(d->t.ptr, d->json);
+    }
+
+    void *root;
+    const vtable *root_vt;
+    bool force_float32;
+
+    std::vector<frame> frames;
+    std::vector<bool> seen;
+    target pending;
+    std::size_t skip_depth = 0;
+    std::unique_ptr<dom_builder> dom;
+};
+
+// writes data as SAX events, the same as `BasicJsonType json = data;` would give. (no DOM)
+// SAX: cbor_sax_writer, json_sax_writer. (JSON_transcoder.h)
+// the members of a struct are written in the order of BasicJsonType's objects. (sorted, or as declared)
+// fixed-size values don't allocate, and strings go through one buffer.
+// types without native support are converted by their to_json(), and written from the BasicJsonType.
+template<typename BasicJsonType, typename SAX>
+class json_bind_writer
+{
+public:
+    using number_integer_t = typename BasicJsonType::number_integer_t;
+    using number_unsigned_t = typename BasicJsonType::number_unsigned_t;
+    using number_float_t = typename BasicJsonType::number_float_t;
+    using string_t = typename BasicJsonType::string_t;
+    using binary_t = typename BasicJsonType::binary_t;
+
+    explicit json_bind_writer(SAX &sax) : sax(sax) {}
+
+    template<typename T>
+    void write(const T &v)
+    {
+        if constexpr (std::is_same<T, bool>::value) {
+            sax.boolean(v);
+        } else if constexpr (std::is_integral<T>::value && std::is_signed<T>::value) {
+            sax.number_integer(static_cast<number_integer_t>(v));
+        } else if constexpr (std::is_integral<T>::value) {
+            sax.number_unsigned(static_cast<number_unsigned_t>(v));
+        } else if constexpr (std::is_floating_point<T>::value) {
+            sax.number_float(static_cast<number_float_t>(v), empty);
+        } else if constexpr (std::is_same<T, std::string>::value) {
+            write_string(v);
+        } else if constexpr (has_json_bind_members<T>::value) {
+            write_object(v, std::make_index_sequence<json_bind_class<T>::size>{});
+        } else if constexpr (json_bind_is_optional<T>::value) {
+            if (v) {
+                write(*v);
+            } else {
+                sax.null();
+            }
+        } else if constexpr (json_bind_is_vector<T>::value || json_bind_is_std_array<T>::value || std::is_same<T, std::vector<bool>>::value) {
+            sax.start_array(v.size());
+            for (const auto &e : v) write(static_cast<const typename T::value_type &>(e));
+            sax.end_array();
+        } else if constexpr (json_bind_is_string_map<T>::value) {
+            write_map(v);
+        } else {
+            write_json(BasicJsonType(v));
+        }
+    }
+
+private:
+    static constexpr bool ordered = nlohmann::detail::is_ordered_map<typename BasicJsonType::object_t>::value;
+
+    template<typename T, std::size_t... I>
+    void write_object(const T &v, std::index_sequence<I...>)
+    {
+        using members = json_bind_class<T>;
+        sax.start_object(members::size);
+        (write_member<T, ordered ? I : members::sorted[I]>(v), ...);
+        sax.end_object();
+    }
+
+    template<typename T, std::size_t I>
+    void write_member(const T &v)
+    {
+        using members = json_bind_class<T>;
+        write_key(members::names[I]);
+        write(v.*(std::get<I>(members::members).ptr));
+    }
+
+    template<typename T>
+    void write_map(const T &m)
+    {
+        sax.start_object(m.size());
+        if constexpr (!ordered && !json_bind_is_sorted_map<T>::value) {
+            // objects of BasicJsonType are sorted.
+            std::vector<const typename T::value_type *> items;
+            items.reserve(m.size());
+            for (const auto &e : m) items.push_back(&e);
+            std::sort(items.begin(), items.end(), [](auto *a, auto *b) { return a->first < b->first; });
+            for (auto *e : items) {
+                write_key(e->first);
+                write(e->second);
+            }
+        } else {
+            for (const auto &e : m) {
+                write_key(e.first);
+                write(e.second);
+            }
+        }
+        sax.end_object();
+    }
+
+    void write_json(const BasicJsonType &j)
+    {
+        switch (j.type()) {
+        case nlohmann::detail::value_t::object:
+            sax.start_object(j.size());
+            for (auto it = j.cbegin(); it != j.cend(); ++it) {
+                write_key(it.key());
+                write_json(it.value());
+            }
+            sax.end_object();
+            break;
+        case nlohmann::detail::value_t::array:
+            sax.start_array(j.size());
+            for (const auto &e : j) write_json(e);
+            sax.end_array();
+            break;
+        case nlohmann::detail::value_t::string:
+            write_string(j.template get_ref<const string_t &>());
+            break;
+        case nlohmann::detail::value_t::boolean:
+            sax.boolean(j.template get<bool>());
+            break;
+        case nlohmann::detail::value_t::number_integer:
+            sax.number_integer(j.template get<number_integer_t>());
+            break;
+        case nlohmann::detail::value_t::number_unsigned:
+            sax.number_unsigned(j.template get<number_unsigned_t>());
+            break;
+        case nlohmann::detail::value_t::number_float:
+            sax.number_float(j.template get<number_float_t>(), empty);
+            break;
+        case nlohmann::detail::value_t::binary: {
+            binary_t b = j.get_binary();
+            sax.binary(b);
+            break;
+        }
+        default:
+            sax.null();
+            break;
+        }
+    }
+
+    template<typename String>
+    void write_key(const String &key)
+    {
+        buf.assign(key.data(), key.size());
+        sax.key(buf);
+    }
+
+    template<typename String>
+    void write_string(const String &str)
+    {
+        buf.assign(str.data(), str.size());
+        sax.string(buf);
+    }
+
+    SAX &sax;
+    string_t buf;
+    const string_t empty;
+};
+
+// write data to a SAX consumer. (see json_bind_writer)
+template<typename BasicJsonType, typename SAX, typename T>
+void json_bind_write(const T &data, SAX &sax)
+{
+    json_bind_writer<BasicJsonType, SAX>(sax).write(data);
+}
+
+// read JSON text into data. (InputType: see nlohmann::json::parse())
+template<typename BasicJsonType, typename InputType, typename T>
+void json_bind_parse(InputType &&input, T &data, bool force_float32 = false)
+{
+    json_bind_sax<BasicJsonType> sax(data, force_float32);
+    BasicJsonType::sax_parse(std::forward<InputType>(input), &sax, nlohmann::detail::input_format_t::json, true);
+}
+
+// read CBOR into data. (InputType: see nlohmann::json::from_cbor())
+template<typename BasicJsonType, typename InputType, typename T>
+void json_bind_from_cbor(InputType &&input, T &data, bool force_float32 = false)
+{
+    json_bind_sax<BasicJsonType> sax(data, force_float32);
+    BasicJsonType::sax_parse(std::forward<InputType>(input), &sax, nlohmann::detail::input_format_t::cbor, true);
+}
+
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2024, edgecraft. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// read-only memory mapping of a whole file.
+// open() fails for anything that can't be mapped (pipes, devices, empty files),
+// so the caller can fall back to stream I/O.
+class mapped_file
+{
+public:
+    mapped_file() = default;
+    explicit mapped_file(const std::string &filename) { open(filename); }
+    ~mapped_file() { close(); }
+
+    mapped_file(const mapped_file &) = delete;
+    mapped_file &operator=(const mapped_file &) = delete;
+
+    mapped_file(mapped_file &&rhs) noexcept { swap(rhs); }
+    mapped_file &operator=(mapped_file &&rhs) noexcept
+    {
+        if (this != &rhs) {
+            close();
+            swap(rhs);
+        }
+        return *this;
+    }
+
+    bool open(const std::string &filename)
+    {
+        close();
+
+#if defined(_WIN32)
+        HANDLE h_file = ::CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (h_file == INVALID_HANDLE_VALUE) return false;
+
+        LARGE_INTEGER sz = {};
+        if (::GetFileType(h_file) != FILE_TYPE_DISK || !::GetFileSizeEx(h_file, &sz) || sz.QuadPart <= 0) {
+            ::CloseHandle(h_file);
+            return false;
+        }
+        HANDLE h_map = ::CreateFileMappingA(h_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        ::CloseHandle(h_file);
+        if (h_map == nullptr) return false;
+
+        void *p = ::MapViewOfFile(h_map, FILE_MAP_READ, 0, 0, 0);
+        ::CloseHandle(h_map);
+        if (p == nullptr) return false;
+
+        data_ = static_cast<const uint8_t *>(p);
+        size_ = static_cast<std::size_t>(sz.QuadPart);
+#else
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat st = {};
+        if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0) {
+            ::close(fd);
+            return false;
+        }
+        auto sz = static_cast<std::size_t>(st.st_size);
+        void *p = ::mmap(nullptr, sz, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) return false;
+#if defined(POSIX_MADV_SEQUENTIAL)
+        ::posix_madvise(p, sz, POSIX_MADV_SEQUENTIAL);
+#endif
+
+        data_ = static_cast<const uint8_t *>(p);
+        size_ = sz;
+#endif
+
+        return true;
+    }
+
+    void close()
+    {
+        if (data_ == nullptr) return;
+
+#if defined(_WIN32)
+        ::UnmapViewOfFile(data_);
+#else
+        ::munmap(const_cast<uint8_t *>(data_), size_);
+#endif
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    bool is_open() const { return data_ != nullptr; }
+    const uint8_t *data() const { return data_; }
+    std::size_t size() const { return size_; }
+    const uint8_t *begin() const { return data_; }
+    const uint8_t *end() const { return data_ + size_; }
+
+private:
+    void swap(mapped_file &rhs) noexcept
+    {
+        std::swap(data_, rhs.data_);
+        std::swap(size_, rhs.size_);
+    }
+
+    const uint8_t *data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2024, edgecraft. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// g++ -O2 -std=c++17 njson_bench.cpp -o bench_fast
+// g++ -O2 -std=c++17 -D JSON_NO_FAST_NUMBER njson_bench.cpp -o bench_strtod
+// ./bench_fast && ./bench_strtod
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "json.hpp"
+
+using njson = nlohmann::json;
+
+// SAX handler that only receives the values. (measures the parser, not the DOM)
+struct null_sax : nlohmann::json_sax<njson>
+{
+    bool null() override { return true; }
+    bool boolean(bool) override { return true; }
+    bool number_integer(number_integer_t) override { return true; }
+    bool number_unsigned(number_unsigned_t) override { return true; }
+    bool number_float(number_float_t, const string_t &) override { return true; }
+    bool string(string_t &) override { return true; }
+    bool binary(binary_t &) override { return true; }
+    bool start_object(std::size_t) override { return true; }
+    bool key(string_t &) override { return true; }
+    bool end_object() override { return true; }
+    bool start_array(std::size_t) override { return true; }
+    bool end_array() override { return true; }
+    bool parse_error(std::size_t, const std::string &, const nlohmann::detail::exception &) override { return false; }
+};
+
+std::string make_array(std::size_t count, bool floats)
+{
+    std::mt19937_64 rng(12345);
+    std::uniform_real_distribution<double> dist(-1e6, 1e6);
+    std::string s = "[";
+    char buf[64];
+
+    for (std::size_t i = 0; i < count; i++) {
+        if (i > 0) s += ',';
+        if (floats) {
+            std::snprintf(buf, sizeof(buf), "%.17g", dist(rng));
+        } else {
+            std::snprintf(buf, sizeof(buf), "%lld", static_cast<long long>(rng() >> (rng() % 64)) * ((i % 2) ? 1 : -1));
+        }
+        s += buf;
+    }
+    s += ']';
+    return s;
+}
+
+void bench(const char *name, const std::string &text)
+{
+    double best = 1e9;
+    for (int i = 0; i < 5; i++) {
+        null_sax sax;
+        auto t0 = std::chrono::steady_clock::now();
+        njson::sax_parse(text, &sax);
+        auto t1 = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(t1 - t0).count());
+    }
+    std::cout << name << ": " << best * 1000 << " ms, " << text.size() / best / 1e6 << " MB/s" << std::endl;
+}
+
+int main()
+{
+#if defined(JSON_NO_FAST_NUMBER)
+    std::cout << "number conversion: strtod" << std::endl;
+#else
+    std::cout << "number conversion: fast path" << std::endl;
+#endif
+
+    bench("float array", make_array(2000000, true));
+    bench("int array  ", make_array(2000000, false));
+
+    return 0;
+}
@@ -23,8 +23,12 @@
 // g++ -std=c++17 -D USE_STD_FILESYSTEM njson_test.cpp
 // ./a.out
 
+#include <cmath>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <optional>
+#include <sstream>
 
 #include "JSON_utils.h"
 
@@ -75,8 +79,8 @@ void to_json(njson& json, const st_BBB& val)
 }
 void from_json(const njson& json, st_BBB& val)
 {
-    json_get_val(json, "i", *(val.i));
-    json_get_val(json, "s", *(val.s));
+    json_get_val(json, "i", val.i);
+    json_get_val(json, "s", val.s);
 }
 
 int main(int ac, char *av[])
@@ -112,5 +116,270 @@ int main(int ac, char *av[])
     assert(jb == jbjb);
     assert(bbb2 == bbb22);
 
+    // json_bind: read into a struct without the DOM, with the same results and errors as get<>().
+    auto error_id = [](auto &&f) {
+        try {
+            f();
+        } catch (const njson::exception &e) {
+            return e.id;
+        }
+        return 0;
+    };
+    for (const auto *text : {R"({"i": 1, "s": "x"})", R"({"s": "x", "z": [1, {"i": 2}], "i": 3})", R"({"i": 1})", R"({"i": "1", "s": "x"})",
+             R"({"i": 1, "s": 2})", R"([1, "x"])"}) {
+        auto dom = njson::parse(text);
+        st_AAA by_dom = {};
+        st_AAA by_text = {};
+        st_AAA by_cbor = {};
+        auto id = error_id([&] { by_dom = dom.get<st_AAA>(); });
+        assert(error_id([&] { json_bind_parse<njson>(std::string(text), by_text); }) == id);
+        assert(error_id([&] { json_bind_from_cbor<njson>(njson::to_cbor(dom), by_cbor); }) == id);
+        if (id == 0) assert(by_text == by_dom && by_cbor == by_dom);
+    }
+
+    // json_bind: a struct is written without the DOM, to the same bytes.
+    auto file_bytes = [](const std::string &filename) {
+        std::ifstream ifs(filename, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(ifs), {});
+    };
+    std::vector<st_AAA> aaas(10, aaa2);
+    aaas[3].s = "\u3042 \"quoted\"\n";
+    for (const auto *ext : {".json", ".dat"}) {
+        assert(write_json_file_from(std::string("json_from") + ext, aaas));
+        assert(write_json_file(std::string("json_dom") + ext, njson(aaas)));
+        assert(file_bytes(std::string("json_from") + ext) == file_bytes(std::string("json_dom") + ext));
+        assert(read_json_file<std::vector<st_AAA>>(std::string("json_from") + ext) == aaas);
+    }
+
+    // indexed_ordered_json: large objects are looked up by hash, and keep the order as ordered_json.
+    nlohmann::indexed_ordered_json io;
+    nlohmann::ordered_json oo;
+    for (int n = 99; n >= 0; n--) {
+        io["key" + std::to_string(n)] = n;
+        oo["key" + std::to_string(n)] = n;
+    }
+    for (int n = 0; n < 100; n += 3) {
+        io.erase("key" + std::to_string(n));
+        oo.erase("key" + std::to_string(n));
+    }
+    io.erase(io.find("key50"));
+    oo.erase(oo.find("key50"));
+    io["key0"] = "again";
+    oo["key0"] = "again";
+    assert(io.dump() == oo.dump());
+    for (int n = 0; n < 100; n++) {
+        auto key = "key" + std::to_string(n);
+        assert(io.contains(key) == oo.contains(key));
+        if (oo.contains(key)) assert(io.at(key).dump() == oo.at(key).dump());
+    }
+    assert(nlohmann::indexed_ordered_json::parse(oo.dump()) == io);
+
+    // presize: containers are counted by a pre-scan and reserved. brackets and commas in strings don't count.
+    const std::string tricky = R"({"a": [1, 2, "[]{},", {"b\"]": ",,,", "c": []}], "d\\": {"e": [[], {}, "\"[", [1, [2, [3]]]]},)"
+                               R"( "f": "}", "g": [true, false, null, 1.5, -2, "\u005b"], "": {}})";
+    auto tricky_dom = njson::parse(tricky);
+    assert(parse_json_input<njson>(nlohmann::detail::input_adapter(tricky.data(), tricky.data() + tricky.size()), false, true) == tricky_dom);
+    assert(parse_json_input<nlohmann::ordered_json>(nlohmann::detail::input_adapter(tricky.data(), tricky.data() + tricky.size()), false, true)
+        == nlohmann::ordered_json::parse(tricky));
+    assert(tricky_dom["a"][3]["b\"]"] == ",,," && tricky_dom["d\\"]["e"].size() == 4);
+
+    // a CBOR array / map claiming more elements than the input has is not reserved, and fails.
+    const std::vector<uint8_t> huge_array = {0x9A, 0x10, 0x00, 0x00, 0x00, 0x01, 0x02};
+    const std::vector<uint8_t> huge_map = {0xBB, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x61, 'k', 0x01};
+    assert(error_id([&] { tricky_dom = njson::from_cbor(huge_array); }) == 110);
+    assert(error_id([&] { tricky_dom = njson::from_cbor(huge_map); }) == 110);
+
+    // float16: floats within the tolerance are written in 2 bytes.
+    njson floats = njson::array();
+    for (int n = 0; n < 1000; n++) floats.push_back(n * 0.37 - 100.0);
+    floats.push_back(0.5);
+    floats.push_back(1e10);
+    cbor_write_options half;
+    half.float16_tolerance = 0.01;
+    assert(write_json_file("json_f16.dat", floats, half));
+    assert(write_json_file("json_f64.dat", floats));
+    assert(fs::file_size("json_f16.dat") < fs::file_size("json_f64.dat"));
+    auto floats16 = read_json_file("json_f16.dat");
+    assert(floats16.size() == floats.size());
+    for (std::size_t n = 0; n < floats.size(); n++) assert(std::abs(floats16[n].get<double>() - floats[n].get<double>()) <= 0.01);
+    half.float16_tolerance = 0.0;  // lossless only.
+    assert(write_json_file("json_f16.dat", floats, half));
+    assert(read_json_file("json_f16.dat") == floats);
+
+    // float32 output: floats exact in single precision are printed with the shortest digits for float.
+    njson singles = {static_cast<double>(0.1f), static_cast<double>(1e7f), static_cast<double>(3.14159f), static_cast<double>(1e-20f), 0.1};
+    std::string singles_text;
+    dump_json(singles, nlohmann::detail::output_adapter<char>(singles_text), 0, true);
+    assert(singles_text == "[0.1,10000000.0,3.14159,1e-20,0.1]");
+    auto singles_back = parse_json_input<njson>(nlohmann::detail::input_adapter(singles_text), true);  // read back as float32. (-f)
+    for (std::size_t n = 0; n < 4; n++) assert(singles_back[n] == singles[n]);
+
+    // CBOR is sized first, then stored: a wrong size is detected, not written past the buffer.
+    assert(to_cbor(floats, cbor_write_options{}) == njson::to_cbor(floats));
+    std::vector<uint8_t> short_buffer(cbor_size(floats, cbor_write_options{}) - 1);
+    memory_writer short_writer(short_buffer.data(), short_buffer.size());
+    write_cbor_with(floats, cbor_write_options{}, &short_writer);
+    assert(!short_writer.complete());
+
+    // typed arrays: read back as normal arrays, and viewed as arrays of numbers.
+    njson arrays = {{"u8", njson::array()}, {"i16", njson::array()}, {"f32", njson::array()}, {"f64", njson::array()},
+        {"mixed", {1, 2, 3, 4, 5, 6, 7, "8"}}, {"short", {1, 2}}};
+    for (int n = 0; n < 100; n++) {
+        arrays["u8"].push_back(n);
+        arrays["i16"].push_back(n * -300);
+        arrays["f32"].push_back(n * 0.25);
+        arrays["f64"].push_back(n * 0.1);
+    }
+    cbor_write_options typed;
+    typed.typed_arrays = true;
+    assert(write_json_file("json_typed.dat", arrays, typed));
+    assert(write_json_file("json_untyped.dat", arrays));
+    assert(fs::file_size("json_typed.dat") < fs::file_size("json_untyped.dat"));
+    assert(read_json_file("json_typed.dat") == arrays);
+    cbor_file typed_file("json_typed.dat");
+    auto typed_view = typed_file.view();
+    assert(typed_view["i16"].size() == 100);
+    assert(typed_view["i16"][99].get<int>() == -29700);
+    assert(typed_view["f64"][3].get<double>() == arrays["f64"][3].get<double>());
+    assert(typed_view.to_json<njson>() == arrays);
+
+    // runs of numbers with the same CBOR head are decoded in blocks from memory:
+    // the same values and errors as from a stream, which reads them one by one.
+    njson runs = njson::array();
+    for (int n = 0; n < 300; n++) {
+        // mixed, with a run of uint16 and a run of float32.
+        auto kind = (n / 40 == 2) ? 0 : ((n / 40 == 4) ? 3 : n % 7);
+        switch (kind) {
+        case 0: runs.push_back(1000 + n); break;   // uint16
+        case 1: runs.push_back(70000 + n); break;  // uint32
+        case 2: runs.push_back(-1000 - n); break;  // negative uint16
+        case 3: runs.push_back(n * 0.5f); break;   // float32
+        case 4: runs.push_back(n * 0.1); break;    // float64
+        case 5: runs.push_back("s"); break;
+        default: runs.push_back(5); break;
+        }
+    }
+    auto runs_cbor = njson::to_cbor(runs);
+    assert(njson::from_cbor(runs_cbor) == runs);
+    for (std::size_t cut = 0; cut < runs_cbor.size(); cut++) {
+        std::vector<uint8_t> part(runs_cbor.begin(), runs_cbor.begin() + static_cast<std::ptrdiff_t>(cut));
+        std::istringstream iss(std::string(part.begin(), part.end()));
+        njson result;
+        std::size_t byte_memory = 0;
+        std::size_t byte_stream = 0;
+        auto id_memory = error_id([&] {
+            try {
+                result = njson::from_cbor(part);
+            } catch (const njson::parse_error &e) {
+                byte_memory = e.byte;
+                throw;
+            }
+        });
+        auto id_stream = error_id([&] {
+            try {
+                result = njson::from_cbor(iss);
+            } catch (const njson::parse_error &e) {
+                byte_stream = e.byte;
+                throw;
+            }
+        });
+        assert(id_memory == 110 && id_stream == 110 && byte_memory == byte_stream);
+    }
+
+    // read keys from a dat file without decoding it.
+    write_json_file("json_aaa.dat", aaa2);
+    cbor_file cf("json_aaa.dat");
+    auto view = cf.view();
+    assert(view["i"].get<int>() == aaa2.i);
+    assert(view["s"].get<std::string_view>() == aaa2.s);
+    assert(!view.contains("x"));
+    assert(view.to_json<njson>() == j);
+
+    // indexed dat: read_json_key() seeks to the item.
+    njson big = njson::object();
+    for (int n = 0; n < 100; n++) big["k" + std::to_string(n)] = {{"n", n}, {"a", njson::array({n, n + 1})}};
+    big["list"] = njson::array();
+    for (int n = 0; n < 3000; n++) big["list"].push_back(n * 2);
+    cbor_write_options indexed;
+    indexed.indexed = true;
+    assert(write_json_file("json_big.dat", big, indexed));
+    assert(read_json_file("json_big.dat") == big);
+    assert(read_json_key("json_big.dat", "/k42/n") == 42);
+    assert(read_json_key("json_big.dat", "/k99/a/1") == 100);
+    assert(read_json_key("json_big.dat", "/list/2500") == 5000);
+    assert(read_json_key<int>("json_big.dat", "/k7/n") == 7);
+    assert(!cbor_file("json_big.dat").view().contains("k100"));
+
+    // read into an arena.
+    auto doc = read_json_file_arena("json_aaa.dat");
+    assert(doc->at("i").get<int>() == aaa2.i);
+    assert(doc->at("s").get<std::string>() == aaa2.s);
+
+    // truncated indefinite-length string. (no 0xFF at the end)
+    const std::vector<uint8_t> truncated = {0x7F, 0x63, 'a', 'b', 'c'};
+    bool thrown = false;
+    try {
+        cbor_view(truncated.data(), truncated.size()).get<std::string>();
+    } catch (const njson::parse_error &e) {
+        thrown = (e.id == 110);
+    }
+    assert(thrown);
+    const std::vector<uint8_t> truncated_key = {0xA1, 0x7F, 0x61, 'k'};
+    thrown = false;
+    try {
+        cbor_view(truncated_key.data(), truncated_key.size()).contains("k");
+    } catch (const njson::parse_error &e) {
+        thrown = (e.id == 110);
+    }
+    assert(thrown);
+
+    // truncated definite-length strings and typed array. (the length is past the end)
+    const std::vector<uint8_t> truncated_text = {0x65, 'a', 'b'};
+    assert(error_id([&] { cbor_view(truncated_text.data(), truncated_text.size()).get<std::string>(); }) == 110);
+    assert(error_id([&] { cbor_view(truncated_text.data(), truncated_text.size()).get<std::string_view>(); }) == 110);
+    const std::vector<uint8_t> truncated_key_text = {0xA1, 0x65, 'k', 0x01};
+    assert(error_id([&] { cbor_view(truncated_key_text.data(), truncated_key_text.size()).contains("k"); }) == 110);
+    const std::vector<uint8_t> truncated_typed = {0xD8, 0x55, 0x59, 0x01, 0x90, 0, 0, 0x80, 0x3F, 0, 0, 0, 0x40};  // tag 85, 400 bytes.
+    assert(error_id([&] { cbor_view(truncated_typed.data(), truncated_typed.size()).size(); }) == 110);
+    assert(error_id([&] { cbor_view(truncated_typed.data(), truncated_typed.size())[50].get<float>(); }) == 110);
+    assert(error_id([&] { for (auto v : cbor_view(truncated_typed.data(), truncated_typed.size())) v.get<float>(); }) == 110);
+
+    // atomic write: a write failing halfway leaves the old file as it was.
+    njson cfg = {{"name", "cfg"}, {"values", njson::array()}};
+    for (int n = 0; n < 10000; n++) cfg["values"].push_back(n);
+    assert(write_json_file("json_cfg.json", cfg, {}, {true}));
+    njson bad = cfg;
+    bad["values"].push_back("\xFF\xFE");  // invalid UTF-8, dump throws type_error 316.
+    thrown = false;
+    try {
+        write_json_file("json_cfg.json", bad, {}, {true});
+    } catch (const njson::type_error &) {
+        thrown = true;
+    }
+    assert(thrown);
+    assert(read_json_file("json_cfg.json") == cfg);
+
+    // async writes: done in order, the data is copied.
+    std::vector<std::future<bool>> writes;
+    for (int n = 0; n < 10; n++) {
+        cfg["name"] = "cfg" + std::to_string(n);
+        writes.push_back(write_json_file_async("json_cfg.json", cfg, {}, {true}));
+        writes.push_back(write_json_file_async("json_cfg" + std::to_string(n) + ".dat", cfg));
+    }
+    cfg["name"] = "changed";
+    for (auto &w : writes) assert(w.get());
+    assert(read_json_file("json_cfg.json")["name"] == "cfg9");
+    assert(read_json_file("json_cfg3.dat")["name"] == "cfg3");
+
+    // read files concurrently.
+    auto reads = read_json_files({"json_cfg.json", "json_cfg3.dat", "json_j.json", "json_none.json"});
+    assert(reads.size() == 4);
+    assert(reads[0].get()["name"] == "cfg9");
+    assert(reads[1].get()["name"] == "cfg3");
+    assert(reads[2].get() == j);
+    assert(reads[3].get().is_null());
+    auto aaa_reads = read_json_files<st_AAA>({"json_aaa.json", "json_aaa.dat"});
+    assert(aaa_reads[0].get() == aaa2 && aaa_reads[1].get() == aaa2);
+
     return EXIT_SUCCESS;
 }
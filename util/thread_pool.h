@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2024, edgecraft. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+// work-stealing thread pool.
+// every worker has its own task queue. a worker takes tasks from the back of its own queue,
+// and steals from the front of the others' queues when its own one is empty.
+class thread_pool
+{
+public:
+    explicit thread_pool(std::size_t num_threads = 0)
+    {
+        if (num_threads == 0) num_threads = std::max(1u, std::thread::hardware_concurrency());
+
+        for (std::size_t i = 0; i < num_threads; i++) queues.emplace_back(std::make_unique<task_queue>());
+        for (std::size_t i = 0; i < num_threads; i++) threads.emplace_back([this, i]() { run(i); });
+    }
+
+    // finish all submitted tasks, then join the workers.
+    ~thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lk(mtx);
+            stop = true;
+        }
+        cv.notify_all();
+        for (auto &t : threads) t.join();
+    }
+
+    thread_pool(const thread_pool &) = delete;
+    thread_pool &operator=(const thread_pool &) = delete;
+
+    std::size_t size() const { return threads.size(); }
+
+    template<typename F, typename... Args>
+    auto submit(F &&f, Args &&... args) -> std::future<std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>>
+    {
+        using result_t = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>;
+
+        auto task = std::make_shared<std::packaged_task<result_t()>>(
+            [f = std::forward<F>(f), tup = std::make_tuple(std::forward<Args>(args)...)]() mutable -> result_t {
+                return std::apply(std::move(f), std::move(tup));
+            });
+        auto fut = task->get_future();
+
+        // tasks submitted from a worker go to its own queue, others are dealt round-robin.
+        auto i = (current_pool == this) ? current_index : (next_queue++ % queues.size());
+        {
+            std::lock_guard<std::mutex> lk(mtx);
+            pending++;
+        }
+        {
+            std::lock_guard<std::mutex> lk(queues[i]->mtx);
+            queues[i]->tasks.emplace_back([task]() { (*task)(); });
+        }
+        cv.notify_one();
+
+        return fut;
+    }
+
+private:
+    struct task_queue
+    {
+        std::mutex mtx;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    bool pop_task(std::size_t i, std::function<void()> &task)
+    {
+        {
+            auto &q = *queues[i];
+            std::lock_guard<std::mutex> lk(q.mtx);
+            if (!q.tasks.empty()) {
+                task = std::move(q.tasks.back());
+                q.tasks.pop_back();
+                return true;
+            }
+        }
+        for (std::size_t n = 1; n < queues.size(); n++) {
+            auto &q = *queues[(i + n) % queues.size()];
+            std::lock_guard<std::mutex> lk(q.mtx);
+            if (!q.tasks.empty()) {
+                task = std::move(q.tasks.front());
+                q.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void run(std::size_t i)
+    {
+        current_pool = this;
+        current_index = i;
+
+        for (;;) {
+            std::function<void()> task;
+            if (pop_task(i, task)) {
+                {
+                    std::lock_guard<std::mutex> lk(mtx);
+                    pending--;
+                }
+                task();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lk(mtx);
+            cv.wait(lk, [this]() { return stop || pending > 0; });
+            if (stop && pending == 0) return;
+        }
+    }
+
+    std::vector<std::unique_ptr<task_queue>> queues;
+    std::vector<std::thread> threads;
+    std::atomic<std::size_t> next_queue = 0;
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::size_t pending = 0;
+    bool stop = false;
+
+    static inline thread_local const thread_pool *current_pool = nullptr;
+    static inline thread_local std::size_t current_index = 0;
+};
+
+// single worker running tasks in the order of submission.
+// for jobs which must not overtake each other. (e.g. writes to the same file)
+class serial_queue
+{
+public:
+    serial_queue() : thread([this]() { run(); }) {}
+
+    // finish all submitted tasks, then join the worker.
+    ~serial_queue()
+    {
+        {
+            std::lock_guard<std::mutex> lk(mtx);
+            stop = true;
+        }
+        cv.notify_all();
+        thread.join();
+    }
+
+    serial_queue(const serial_queue &) = delete;
+    serial_queue &operator=(const serial_queue &) = delete;
+
+    template<typename F, typename... Args>
+    auto submit(F &&f, Args &&... args) -> std::future<std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>>
+    {
+        using result_t = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>;
+
+        auto task = std::make_shared<std::packaged_task<result_t()>>(
+            [f = std::forward<F>(f), tup = std::make_tuple(std::forward<Args>(args)...)]() mutable -> result_t {
+                return std::apply(std::move(f), std::move(tup));
+            });
+        auto fut = task->get_future();
+        {
+            std::lock_guard<std::mutex> lk(mtx);
+            tasks.emplace_back([task]() { (*task)(); });
+        }
+        cv.notify_one();
+
+        return fut;
+    }
+
+private:
+    void run()
+    {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lk(mtx);
+                cv.wait(lk, [this]() { return stop || !tasks.empty(); });
+                if (tasks.empty()) return;
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::deque<std::function<void()>> tasks;
+    bool stop = false;
+    std::thread thread;
+};
+
+}